@@ -0,0 +1,43 @@
+#ifndef ALLOCATION_BENCHMARK_H
+#define ALLOCATION_BENCHMARK_H
+
+#include <string>
+#include <memory>
+#include "Config.h"
+
+
+// Итог одного сценария проверки
+struct AllocationBenchmarkResult {
+    std::string scenario;
+    int checks;
+    double newPerCheck;
+    double curlAllocationsPerCheck;
+
+    AllocationBenchmarkResult() : checks(0), newPerCheck(0.0), curlAllocationsPerCheck(0.0) {}
+};
+
+
+// Выделения памяти на установившейся проверке (--bench-allocs). После прогрева
+// считаются operator new на проверку: MarkerMatcher на чанках страницы и
+// WebScraper::CheckStreamStatus (DownloadPageHtml, WriteCallback, разбор) -
+// полная загрузка, HEAD-probe и Range-probe против twitch_base_url из конфига
+// (только локальная подставка). Выделения самой libcurl (malloc) - для справки:
+// требование "ноль" к ним не относится
+class AllocationBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    int warmupChecks;
+    int checks;
+
+    AllocationBenchmarkResult RunMatcher() const;
+    AllocationBenchmarkResult RunScraper(const std::string& scenario, bool useHeadRequest, int probeRangeBytes) const;
+
+public:
+    AllocationBenchmark(std::shared_ptr<Config> configInstance, int warmupCount, int checkCount);
+
+    // steadyStateClean = false - хоть одна проверка после прогрева вызвала operator new.
+    // twitch_base_url до вызова проверяет BenchmarkSupport::RequireLocalUrl
+    std::string RunComparison(bool& steadyStateClean) const;
+};
+
+#endif // ALLOCATION_BENCHMARK_H
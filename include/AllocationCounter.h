@@ -0,0 +1,24 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+
+// Счетчик выделений памяти для --bench-allocs. Глобальные operator new/delete
+// заменены во всей программе: пока счет выключен, цена - одна relaxed-загрузка
+// флага на выделение. libcurl выделяет через malloc, его вызовы видны только
+// после HookCurl (THREAD-SAFE)
+namespace AllocationCounter {
+    // До первого curl_global_init (CurlShare): позже libcurl оставит свой malloc
+    bool HookCurl();
+    void UnhookCurl();
+
+    // Start обнуляет счетчики и включает счет
+    void Start();
+    void Stop();
+
+    uint64_t GetNewCalls();
+    uint64_t GetCurlAllocations();
+}
+
+#endif // ALLOCATION_COUNTER_H
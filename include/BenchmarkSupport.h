@@ -0,0 +1,23 @@
+#ifndef BENCHMARK_SUPPORT_H
+#define BENCHMARK_SUPPORT_H
+
+#include <string>
+#include "Config.h"
+
+
+// Общее для замеров с живыми мониторами
+namespace BenchmarkSupport {
+
+    // Мониторы замера без побочных действий: браузер, уведомления, статистика,
+    // predictive-опрос, слежение за streamers.txt и лимитер выключены, лог - свой
+    void PrepareMonitorConfig(Config& config, const std::string& logFile);
+
+    // Замеры шлют тысячи запросов в секунду - только на локальную подставку.
+    // 0 - twitch_base_url на 127.0.0.1/localhost, иначе сообщение в stderr и 1
+    int RequireLocalUrl(const Config& config);
+
+    // Потоков в процессе сейчас (/proc/self/status), -1 - не поддерживается
+    long ThreadCount();
+}
+
+#endif // BENCHMARK_SUPPORT_H
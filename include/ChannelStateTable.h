@@ -0,0 +1,105 @@
+#ifndef CHANNEL_STATE_TABLE_H
+#define CHANNEL_STATE_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+// Итог одного прохода по таблице
+struct ChannelStateSummary {
+    size_t channels;
+    size_t online;
+    size_t fastMode;  // Недавно были в эфире: проверяются с check_interval_fast
+    size_t stopped;
+
+    ChannelStateSummary() : channels(0), online(0), fastMode(0), stopped(0) {}
+};
+
+
+// Горячее состояние каналов (статус, время последнего эфира, интервалы, остановка)
+// в параллельных массивах по плотному номеру канала. Проход "сколько в эфире /
+// в быстром режиме" читает подряд несколько массивов, а не по объекту монитора
+// на канал вперемешку с холодными полями.
+// Массивы лежат блоками по CHUNK_SIZE: блоки не переезжают, поэтому номер
+// действует до Release, а чтение идет без блокировок (THREAD-SAFE)
+class ChannelStateTable {
+public:
+    static const size_t CHUNK_SIZE = 4096;
+    static const size_t MAX_CHUNKS = 1024;  // До 4M каналов
+
+    enum Flag : uint8_t {
+        IN_USE = 1 << 0,
+        ONLINE = 1 << 1,
+        STOPPED = 1 << 2
+    };
+
+private:
+    // Каждый массив - с начала своей cache line
+    struct Chunk {
+        alignas(64) std::atomic<uint8_t> flags[CHUNK_SIZE];
+        alignas(64) std::atomic<long long> lastOnline[CHUNK_SIZE];
+        alignas(64) std::atomic<int32_t> checkInterval[CHUNK_SIZE];
+        alignas(64) std::atomic<int32_t> checkIntervalFast[CHUNK_SIZE];
+        alignas(64) std::atomic<int32_t> fastModeDuration[CHUNK_SIZE];
+    };
+
+    std::atomic<Chunk*> chunks[MAX_CHUNKS];
+    std::atomic<size_t> slotCount;  // Номера [0, slotCount) хоть раз выданы
+
+    std::mutex allocMutex;
+    std::vector<uint32_t> freeSlots;  // Освобожденные номера: таблица остается плотной
+
+    Chunk& ChunkOf(uint32_t slot) const {
+        return *chunks[slot / CHUNK_SIZE].load(std::memory_order_acquire);
+    }
+
+public:
+    ChannelStateTable();
+    ~ChannelStateTable();
+
+    ChannelStateTable(const ChannelStateTable&) = delete;
+    ChannelStateTable& operator=(const ChannelStateTable&) = delete;
+
+    // Номер для нового канала (сначала - освобожденные). std::length_error при переполнении
+    uint32_t Allocate(int checkInterval, int checkIntervalFast, int fastModeDuration);
+    void Release(uint32_t slot);
+
+    bool HasFlag(uint32_t slot, Flag flag) const {
+        return (ChunkOf(slot).flags[slot % CHUNK_SIZE].load(std::memory_order_acquire) & flag) != 0;
+    }
+    void SetFlag(uint32_t slot, Flag flag, bool value) {
+        std::atomic<uint8_t>& flags = ChunkOf(slot).flags[slot % CHUNK_SIZE];
+        if (value) {
+            flags.fetch_or(flag, std::memory_order_acq_rel);
+        } else {
+            flags.fetch_and(static_cast<uint8_t>(~flag), std::memory_order_acq_rel);
+        }
+    }
+
+    long long GetLastOnline(uint32_t slot) const {
+        return ChunkOf(slot).lastOnline[slot % CHUNK_SIZE].load(std::memory_order_relaxed);
+    }
+    void SetLastOnline(uint32_t slot, long long unixTime) {
+        ChunkOf(slot).lastOnline[slot % CHUNK_SIZE].store(unixTime, std::memory_order_relaxed);
+    }
+
+    int GetCheckInterval(uint32_t slot) const {
+        return ChunkOf(slot).checkInterval[slot % CHUNK_SIZE].load(std::memory_order_relaxed);
+    }
+    int GetCheckIntervalFast(uint32_t slot) const {
+        return ChunkOf(slot).checkIntervalFast[slot % CHUNK_SIZE].load(std::memory_order_relaxed);
+    }
+    int GetFastModeDuration(uint32_t slot) const {
+        return ChunkOf(slot).fastModeDuration[slot % CHUNK_SIZE].load(std::memory_order_relaxed);
+    }
+
+    // Линейный проход по всем выданным номерам
+    ChannelStateSummary Summarize(long long unixTime) const;
+
+    size_t GetSlotCount() const { return slotCount.load(std::memory_order_acquire); }
+};
+
+#endif // CHANNEL_STATE_TABLE_H
@@ -0,0 +1,102 @@
+#ifndef CHECK_SCHEDULER_H
+#define CHECK_SCHEDULER_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include "Logger.h"
+#include "LatencyWindow.h"
+#include "DeadlineQueue.h"
+
+
+// Задача проверки (выполняется в worker). Возвращает задержку до следующего
+// запуска в мс; отрицательное значение снимает задачу с расписания.
+using ScheduledTask = std::function<int()>;
+
+
+// Снимок метрик планировщика. Lag - насколько позже дедлайна стартовала проверка.
+struct SchedulerStats {
+    size_t workers;
+    std::string backend;
+    size_t scheduledTasks;
+    size_t runningTasks;
+    unsigned long long executedTasks;
+    LatencySummary lag;
+
+    SchedulerStats() : workers(0), scheduledTasks(0), runningTasks(0), executedTasks(0) {}
+};
+
+
+// Дедлайны проверок в DeadlineQueue (колесо таймеров или куча) +
+// фиксированный пул worker-потоков. Одна задача никогда не выполняется параллельно сама с собой:
+// следующий дедлайн ставится только после ее завершения.
+class CheckScheduler {
+private:
+    struct TaskState {
+        ScheduledTask task;
+        bool running;
+        bool cancelled;
+    };
+
+    static const size_t LAG_WINDOW = 4096;
+
+    std::shared_ptr<Logger> logger;
+    size_t workerCount;
+    int jitterMs;
+
+    mutable std::mutex schedulerMutex;
+    std::condition_variable wakeup;
+    std::unique_ptr<DeadlineQueue> deadlines;
+    std::deque<ExpiredDeadline> ready;          // Дедлайн наступил, ждут свободного worker
+    std::vector<ExpiredDeadline> expiredBuffer;
+    std::chrono::steady_clock::time_point startTime;
+    std::unordered_map<uint64_t, TaskState> tasks;
+    uint64_t nextTaskId;
+    size_t runningCount;
+    unsigned long long executedCount;
+    LatencyWindow lagWindow;
+    std::mt19937 jitterGenerator;
+
+    std::vector<std::thread> workers;
+    std::atomic<bool> running;
+
+    void WorkerThreadFunction();
+    void PushDeadline(uint64_t taskId, int delayMs);  // Под schedulerMutex
+    int NextJitterMs();                                // Под schedulerMutex
+    int64_t NowMs() const;                             // Мс от startTime
+
+public:
+    // backend: "wheel" (по умолчанию) или "heap"
+    CheckScheduler(std::shared_ptr<Logger> loggerInstance, size_t workerThreads, int checkJitterMs,
+                   const std::string& backend = "wheel");
+    ~CheckScheduler();
+
+    CheckScheduler(const CheckScheduler&) = delete;
+    CheckScheduler& operator=(const CheckScheduler&) = delete;
+
+    bool Start();
+    void Stop();  // Ждет завершения уже начатых проверок
+    bool IsRunning() const { return running.load(); }
+
+    // Поставить задачу через delayMs (thread-safe). Возвращает id для Cancel.
+    uint64_t Add(int delayMs, ScheduledTask task);
+
+    // Снять задачу с расписания (выполняющаяся сейчас доработает, но не повторится)
+    bool Cancel(uint64_t taskId);
+
+    SchedulerStats GetStats() const;
+    std::string GetStatsSummary() const;
+    void ResetLag();  // Начать окно lag заново
+};
+
+#endif // CHECK_SCHEDULER_H
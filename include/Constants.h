@@ -10,15 +10,40 @@ namespace Constants {
     const int DEFAULT_CONNECT_TIMEOUT = 10;
     const int DNS_CACHE_TIMEOUT_SECONDS = 300;
     const long HTTP_OK = 200;
+    const int HTTP2_MAX_CONNECTIONS = 2;     // На хост, в режиме multiplexing
+    const int HTTP2_MAX_STREAMS = 100;       // Параллельных streams на соединение
+    const int RATE_LIMIT_RPS = 50;           // Запросов в секунду на все мониторы (--multi)
+    const int RATE_LIMIT_BURST = 50;         // Сколько токенов копится про запас
+    const int MAX_INFLIGHT_PER_HOST = 32;    // Одновременных запросов к одному хосту
+    const int RATE_LIMIT_MAX_WAIT_MS = 30000; // Дольше в очереди - проверка пропускается
+    const size_t HEDGE_LATENCY_WINDOW = 64;   // Последних загрузок канала для p95/p99
+    const size_t HEDGE_MIN_SAMPLES = 10;      // Меньше замеров - без hedge, таймаут из конфига
+    const int HEDGE_MIN_DELAY_MS = 100;       // Раньше hedge не шлем, даже если p95 меньше
+    const int ADAPTIVE_TIMEOUT_FACTOR = 4;    // adaptive_timeout: таймаут = p99 * factor,
+    const int ADAPTIVE_TIMEOUT_MIN_MS = 2000; // но не меньше этого и не больше timeout
+    
+    // Failure handling
+    const int RETRY_FAST_MAX = 2;                   // Быстрых повторов подряд после transient-ошибки
+    const int RETRY_FAST_MIN_MS = 1000;
+    const int RETRY_FAST_MAX_MS = 4000;
+    const int BACKOFF_BASE_MS = 5000;               // Первый backoff хоста после 429/anti-bot
+    const int BACKOFF_MAX_MS = 600000;
+    const int BREAKER_THRESHOLD = 3;                // Permanent-ошибок подряд до открытия breaker
+    const int BREAKER_COOLDOWN_SECONDS = 300;
+    const int BREAKER_MAX_COOLDOWN_SECONDS = 3600;  // Предел удвоения после неудачной пробы
     
     // Check intervals
     const int DEFAULT_CHECK_INTERVAL = 30;
     const int FAST_CHECK_INTERVAL = 10;
     const int FAST_MODE_DURATION = 300;
+    const int POLL_MAX_INTERVAL = 600;              // Предел интервала predictive-опроса (с)
+    const double POLL_PRIOR_STARTS_PER_WEEK = 2.0;  // Априорных стартов в неделю у канала без истории
     
     // HTML parsing
     const size_t MAX_HTML_SIZE = 100000;
     const size_t MIN_HTML_SIZE = 1000;
+    const size_t STREAM_SECTION_WINDOW = 500;  // Окно поиска "type":"live" после "stream":{
+    const size_t HTML_TAIL_WINDOW = 4096;      // Сколько байт страницы храним для диагностики
     
     // Browser (human-like delays)
     const int BROWSER_DELAY_MIN_MS = 1200;   // Увеличено для большей естественности
@@ -36,7 +61,10 @@ namespace Constants {
     
     // Anti-detection
     const int EXTRA_REQUEST_CHANCE_PERCENT = 20;  // 20% шанс доп. запроса
+    const int EXTRA_REQUEST_DELAY_MIN_MS = 300;   // Пауза перед доп. запросом
+    const int EXTRA_REQUEST_DELAY_MAX_MS = 800;
     const int REQUEST_INTERVAL_JITTER_MS = 500;   // Разброс времени между запросами
+    const int HEADER_VARIANTS = 32;               // Наборов заголовков на процесс (MonitorContext)
     
     // Twitch markers (для парсинга БЕЗ API)
     namespace TwitchMarkers {
@@ -66,17 +94,22 @@ namespace Constants {
     
     // Regex patterns
     const char* const VALID_STREAMER_NAME_PATTERN = "^[a-zA-Z0-9_]{1,25}$";
+    const size_t MAX_STREAMER_NAME_LENGTH = 25;
     
     // URLs
     const char* const TWITCH_BASE_URL = "https://www.twitch.tv/";
-    const char* const TWITCH_MAIN_PAGE = "https://www.twitch.tv/";
     const char* const TWITCH_DIRECTORY = "https://www.twitch.tv/directory";
     
     // Statistics
     const size_t MAX_SESSIONS_HISTORY = 1000;
     
     // Multi-monitor
-    const int THREAD_START_DELAY_MS = 500;
+    const int STARTUP_WARMUP_MS = 10000;      // Окно, по которому разносятся первые проверки
+    const int DEFAULT_WORKER_THREADS = 4;     // Пул проверок в режиме multi_engine=threads
+    const int DEFAULT_EXECUTOR_THREADS = 0;   // Work stealing пул (0 = по числу ядер)
+    const int SHUTDOWN_TIMEOUT_MS = 2000;     // Дедлайн записи статистики при остановке
+    const int STREAMERS_WATCH_DEBOUNCE_MS = 200;  // Тишина после записи streamers.txt до перечитывания
+    const int STREAMERS_WATCH_POLL_MS = 1000;     // Опрос mtime там, где нет inotify
 }
 
 #endif // CONSTANTS_H
\ No newline at end of file
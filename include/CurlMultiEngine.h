@@ -0,0 +1,150 @@
+#ifndef CURL_MULTI_ENGINE_H
+#define CURL_MULTI_ENGINE_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <curl/curl.h>
+#include "Logger.h"
+#include "LatencyWindow.h"
+
+
+// Callback завершения передачи (вызывается в потоке event loop)
+using TransferCallback = std::function<void(CURLcode result)>;
+
+// Отложенная задача event loop
+using LoopTask = std::function<void()>;
+
+
+// Снимок метрик передач event loop (задержки - по последним LATENCY_WINDOW)
+struct EngineStats {
+    unsigned long long transfers;
+    unsigned long long connectionsOpened;
+    unsigned long long http2Transfers;
+    unsigned long long http2ConnectionsOpened;
+    size_t peakActiveTransfers;
+    long long latencyP50Ms;
+    long long latencyP90Ms;
+    long long latencyP99Ms;
+    long long latencyMaxMs;
+    LatencySummary timerLag;  // Насколько позже срока стартовала задача ScheduleAfter
+
+    EngineStats() : transfers(0), connectionsOpened(0), http2Transfers(0),
+                    http2ConnectionsOpened(0), peakActiveTransfers(0),
+                    latencyP50Ms(0), latencyP90Ms(0), latencyP99Ms(0), latencyMaxMs(0) {}
+
+    // Среднее число HTTP/2 streams на одно открытое HTTP/2 соединение
+    double StreamsPerConnection() const {
+        return http2ConnectionsOpened > 0 ?
+               static_cast<double>(http2Transfers) / http2ConnectionsOpened : 0.0;
+    }
+};
+
+
+// Event loop на curl_multi_socket_action: все проверки идут из одного потока.
+// На Linux сокеты ждем через epoll, на остальных платформах через curl_multi_poll.
+class CurlMultiEngine {
+private:
+    struct Timer {
+        std::chrono::steady_clock::time_point when;
+        unsigned long long sequence;  // FIFO для одинаковых дедлайнов
+        LoopTask task;
+
+        bool operator>(const Timer& other) const {
+            if (when != other.when) return when > other.when;
+            return sequence > other.sequence;
+        }
+    };
+
+    struct PendingTransfer {
+        CURL* easy;
+        TransferCallback onDone;
+    };
+
+    std::shared_ptr<Logger> logger;
+    CURLM* multiHandle;
+    std::thread loopThread;
+    std::atomic<bool> running;
+
+    // Очереди от других потоков (защищены pendingMutex)
+    std::mutex pendingMutex;
+    std::vector<PendingTransfer> pendingTransfers;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+    unsigned long long timerSequence;
+
+    // Активные передачи (только поток event loop)
+    std::unordered_map<CURL*, TransferCallback> activeTransfers;
+    bool curlTimerArmed;
+    std::chrono::steady_clock::time_point curlTimerDeadline;
+
+    std::atomic<size_t> activeCount;
+    std::atomic<unsigned long long> completedCount;
+
+    // Метрики соединений и задержек (защищены statsMutex)
+    static const size_t LATENCY_WINDOW = 4096;
+    mutable std::mutex statsMutex;
+    EngineStats stats;
+    LatencyWindow latencies;
+    LatencyWindow timerLags;
+
+#ifdef __linux__
+    int epollFd;
+    int wakeupFd;  // eventfd для пробуждения epoll_wait
+#endif
+
+    // Callbacks curl_multi
+    static int SocketCallback(CURL* easy, curl_socket_t socket, int what,
+                              void* userp, void* socketp);
+    static int TimerCallback(CURLM* multi, long timeoutMs, void* userp);
+
+    void LoopThreadFunction();
+    void Wakeup();
+    void DrainPendingTransfers();
+    int RunDueTimers();  // Возвращает мс до следующего таймера (-1 = нет)
+    int ComputeWaitMs(int timerWaitMs) const;
+    void ProcessCompletions();
+    void RecordTransferMetrics(CURL* easy);
+    void AbortActiveTransfers();
+
+
+public:
+    explicit CurlMultiEngine(std::shared_ptr<Logger> loggerInstance);
+    ~CurlMultiEngine();
+
+    CurlMultiEngine(const CurlMultiEngine&) = delete;
+    CurlMultiEngine& operator=(const CurlMultiEngine&) = delete;
+
+    // HTTP/2 мультиплексирование: не больше maxConnections соединений на хост,
+    // до maxStreams параллельных streams на соединение. Вызывать до Start().
+    void ConfigureMultiplexing(long maxConnections, long maxStreams);
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return running.load(); }
+
+    // Добавить настроенный easy handle (thread-safe, не блокирует)
+    void Submit(CURL* easy, TransferCallback onDone);
+
+    // Выполнить задачу в потоке event loop через delayMs (thread-safe)
+    void ScheduleAfter(int delayMs, LoopTask task);
+
+    // Снять передачу (активную или еще ждущую) без вызова ее callback (проигравший hedge).
+    // Только из потока event loop: callbacks передач и задачи ScheduleAfter
+    void Cancel(CURL* easy);
+
+    size_t GetActiveTransfers() const { return activeCount.load(); }
+    unsigned long long GetCompletedTransfers() const { return completedCount.load(); }
+
+    EngineStats GetStats() const;
+    std::string GetStatsSummary() const;
+    void ResetTimerLag();  // Начать окно timerLag заново
+};
+
+#endif // CURL_MULTI_ENGINE_H
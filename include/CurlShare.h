@@ -0,0 +1,69 @@
+#ifndef CURL_SHARE_H
+#define CURL_SHARE_H
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <curl/curl.h>
+
+
+// Снимок счетчиков общего кэша соединений
+struct ShareStats {
+    unsigned long long transfers;
+    unsigned long long connectionsOpened;   // Новые TCP-соединения
+    unsigned long long connectionsReused;   // Передачи на уже открытом соединении
+    unsigned long long tlsHandshakes;       // Полные + возобновленные рукопожатия
+    unsigned long long tlsResumed;          // Из них по сохраненной TLS-сессии
+
+    ShareStats() : transfers(0), connectionsOpened(0), connectionsReused(0),
+                   tlsHandshakes(0), tlsResumed(0) {}
+};
+
+
+// Общий на процесс CURLSH: DNS-кэш, TLS-сессии и пул соединений.
+// Все WebScraper подключаются к нему, поэтому к www.twitch.tv
+// N мониторов держат один набор соединений вместо N.
+// Владельцы держат shared_ptr: share живет дольше последнего easy handle.
+class CurlShare {
+private:
+    CURLSH* share;
+    std::mutex locks[CURL_LOCK_DATA_LAST];
+
+    std::atomic<unsigned long long> transfers;
+    std::atomic<unsigned long long> connectionsOpened;
+    std::atomic<unsigned long long> connectionsReused;
+    std::atomic<unsigned long long> tlsHandshakes;
+    std::atomic<unsigned long long> tlsResumed;
+
+    static void LockCallback(CURL* handle, curl_lock_data data,
+                             curl_lock_access access, void* userp);
+    static void UnlockCallback(CURL* handle, curl_lock_data data, void* userp);
+    static int DebugCallback(CURL* handle, curl_infotype type, char* text,
+                             size_t size, void* userp);
+
+    CurlShare();
+
+public:
+    ~CurlShare();
+
+    CurlShare(const CurlShare&) = delete;
+    CurlShare& operator=(const CurlShare&) = delete;
+
+    // Общий экземпляр (создается при первом запросе, пока жив хоть один владелец)
+    static std::shared_ptr<CurlShare> Acquire();
+
+    bool IsValid() const { return share != nullptr; }
+
+    // Подключить easy handle к общему кэшу. tlsResumedFlag выставляется
+    // в true, если libcurl возобновил TLS-сессию в текущей передаче.
+    bool Attach(CURL* easy, bool* tlsResumedFlag);
+
+    // Учесть завершенную передачу (NUM_CONNECTS == 0 - соединение из пула)
+    void RecordTransfer(CURL* easy, bool tlsResumed);
+
+    ShareStats GetStats() const;
+    std::string GetSummaryString() const;
+};
+
+#endif // CURL_SHARE_H
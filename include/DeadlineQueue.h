@@ -0,0 +1,71 @@
+#ifndef DEADLINE_QUEUE_H
+#define DEADLINE_QUEUE_H
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+
+// Задача, чей дедлайн наступил
+struct ExpiredDeadline {
+    uint64_t taskId;
+    int64_t deadlineMs;
+};
+
+
+// Очередь дедлайнов CheckScheduler. Время - мс от старта планировщика.
+// Не потокобезопасна: защищает владелец.
+class DeadlineQueue {
+public:
+    virtual ~DeadlineQueue() = default;
+
+    // Поставить задачу или перенести уже стоящую
+    virtual void Schedule(uint64_t taskId, int64_t deadlineMs) = 0;
+    virtual bool Cancel(uint64_t taskId) = 0;
+
+    // Добавить в out все задачи с дедлайном <= nowMs и снять их с очереди
+    virtual void PopExpired(int64_t nowMs, std::vector<ExpiredDeadline>& out) = 0;
+
+    // Когда в следующий раз стоит заглянуть в очередь (-1 = пусто)
+    virtual int64_t NextWakeupMs() = 0;
+
+    virtual size_t Size() const = 0;
+    virtual const char* Name() const = 0;
+};
+
+
+// Бинарная куча: O(log n) вставка, перенос - ленивое удаление старой записи
+class HeapDeadlineQueue : public DeadlineQueue {
+private:
+    struct Entry {
+        int64_t deadlineMs;
+        uint64_t taskId;
+        uint64_t generation;
+
+        bool operator>(const Entry& other) const {
+            if (deadlineMs != other.deadlineMs) return deadlineMs > other.deadlineMs;
+            return taskId > other.taskId;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    std::unordered_map<uint64_t, uint64_t> generations;  // Актуальная запись задачи
+    uint64_t nextGeneration;
+
+    bool IsStale(const Entry& entry) const;
+    void DropStaleTop();
+
+public:
+    HeapDeadlineQueue();
+
+    void Schedule(uint64_t taskId, int64_t deadlineMs) override;
+    bool Cancel(uint64_t taskId) override;
+    void PopExpired(int64_t nowMs, std::vector<ExpiredDeadline>& out) override;
+    int64_t NextWakeupMs() override;
+    size_t Size() const override { return generations.size(); }
+    const char* Name() const override { return "heap"; }
+};
+
+#endif // DEADLINE_QUEUE_H
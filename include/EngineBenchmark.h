@@ -0,0 +1,43 @@
+#ifndef ENGINE_BENCHMARK_H
+#define ENGINE_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "Config.h"
+
+
+// Итог одного движка после замера
+struct EngineBenchmarkResult {
+    std::string engine;
+    long threads;
+    long rssKb;
+    unsigned long long checks;
+    double checksPerSecond;
+
+    EngineBenchmarkResult() : threads(-1), rssKb(-1), checks(0), checksPerSecond(0.0) {}
+};
+
+
+// Движки проверок на одном списке каналов (--bench-engines): event loop
+// CurlMultiEngine, пул CheckScheduler (multi_engine=threads) и прежний поток на
+// стримера (StartMonitoring). Запросы идут на twitch_base_url из конфига -
+// только локальная подставка; браузер, уведомления и статистика выключены.
+// В конце каждого прогона - потоки процесса, RSS и проверок в секунду
+class EngineBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t channels;
+    int seconds;
+
+    EngineBenchmarkResult RunMulti(const std::string& engine) const;
+    EngineBenchmarkResult RunThreadPerStreamer() const;
+
+public:
+    EngineBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int durationSeconds);
+
+    // twitch_base_url до вызова проверяет BenchmarkSupport::RequireLocalUrl
+    std::string RunComparison() const;
+};
+
+#endif // ENGINE_BENCHMARK_H
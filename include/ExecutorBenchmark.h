@@ -0,0 +1,47 @@
+#ifndef EXECUTOR_BENCHMARK_H
+#define EXECUTOR_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одного размера пула
+struct ExecutorBenchmarkResult {
+    size_t workers;
+    double tasksPerSec;
+    double fastP50WaitUs;   // Ожидание в очереди быстрых задач
+    double fastP99WaitUs;
+    double slowP99WaitUs;
+    unsigned long long steals;
+    bool allExecuted;       // executed == submitted
+    double idleCpuPercent;  // CPU процесса на простое после нагрузки
+
+    ExecutorBenchmarkResult()
+        : workers(0), tasksPerSec(0.0), fastP50WaitUs(0.0), fastP99WaitUs(0.0), slowP99WaitUs(0.0),
+          steals(0), allExecuted(false), idleCpuPercent(0.0) {}
+};
+
+
+// Нагрузка TaskExecutor смешанными страницами (--bench-executor): быстрые задачи -
+// разбор короткой offline-страницы MarkerMatcher, медленные (каждая SLOW_EVERY-я) -
+// разбор большой страницы. Задачи приходят извне с ограниченной очередью, часть
+// быстрых ставит из worker следующую (запись статистики) - в свою очередь,
+// откуда ее крадут.
+// Ожидание в очереди (мкс) показывает, не стоят ли быстрые задачи за медленными.
+// После нагрузки пул простаивает: CPU процесса на простое должен быть около нуля
+class ExecutorBenchmark {
+private:
+    size_t workerCount;
+    size_t tasks;
+
+    ExecutorBenchmarkResult Run(size_t workers) const;
+
+public:
+    // workers = 0: по числу ядер
+    ExecutorBenchmark(size_t workers, size_t taskCount);
+
+    // executorHealthy = false - задачи потерялись или пул крутится без работы
+    std::string RunComparison(bool& executorHealthy) const;
+};
+
+#endif // EXECUTOR_BENCHMARK_H
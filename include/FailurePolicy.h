@@ -0,0 +1,133 @@
+#ifndef FAILURE_POLICY_H
+#define FAILURE_POLICY_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <chrono>
+#include <unordered_map>
+#include <cstdint>
+#include <curl/curl.h>
+#include "Logger.h"
+
+
+// Чем закончилась проверка, не давшая вердикта
+enum class FailureClass {
+    NONE,       // Вердикт есть
+    TRANSIENT,  // Таймаут, обрыв, 5xx, пустая страница - быстрый повтор
+    THROTTLED,  // 429/403, anti-bot страница - backoff всего хоста
+    PERMANENT   // TLS-конфигурация, 404 канала - circuit breaker
+};
+
+enum class BreakerState { CLOSED, OPEN, HALF_OPEN };
+
+
+struct FailureStats {
+    unsigned long long transient;
+    unsigned long long throttled;
+    unsigned long long permanent;
+    unsigned long long fastRetries;   // Повторы через RETRY_FAST_*, а не через интервал
+    unsigned long long skipped;       // Проверки, не отправленные из-за backoff или breaker
+    unsigned long long breakerOpens;
+
+    FailureStats() : transient(0), throttled(0), permanent(0), fastRetries(0),
+                     skipped(0), breakerOpens(0) {}
+
+    FailureStats& operator+=(const FailureStats& other);
+};
+
+
+// Экспоненциальный backoff хоста после throttling, общий для всех мониторов.
+// Пока хост в backoff, проверки к нему не отправляются; после окна идет один
+// пробный запрос, остальные ждут его ответа (THREAD-SAFE)
+class HostBackoff {
+private:
+    struct HostState {
+        int level;
+        std::chrono::steady_clock::time_point until;
+        bool probing;  // Пробный запрос выдан, ждем RecordSuccess/RecordThrottle
+        std::chrono::steady_clock::time_point probeExpires;
+    };
+
+    mutable std::mutex backoffMutex;
+    std::unordered_map<std::string, HostState> hosts;
+    int baseMs;
+    int maxMs;
+    std::mt19937 randomGenerator;
+
+    int JitterMs(int spanMs);  // Под backoffMutex
+
+public:
+    HostBackoff(int baseDelayMs, int maxDelayMs);
+
+    // Хост ответил throttling: сколько мс ждать. Ответы, пришедшие в уже открытое
+    // окно backoff (запросы были в полете), уровень не повышают
+    int RecordThrottle(const std::string& host);
+
+    // Хост ответил нормально - backoff сбрасывается
+    void RecordSuccess(const std::string& host);
+
+    // 0 - запрос можно отправить (возможно, как пробный), иначе сколько мс подождать.
+    // Ожидание с разбросом: отложенные проверки не приходят все разом к концу окна
+    int Admit(const std::string& host);
+
+    size_t GetBackedOffHosts() const;
+};
+
+
+// Реакция на неудачи одного канала: быстрый повтор со случайной паузой для transient,
+// общий backoff хоста для throttling, circuit breaker для permanent (THREAD-SAFE)
+class FailurePolicy {
+private:
+    std::shared_ptr<Logger> logger;
+    std::shared_ptr<HostBackoff> hostBackoff;
+    int maxFastRetries;
+    int breakerThreshold;
+    int breakerCooldownSec;
+
+    mutable std::mutex policyMutex;
+    int fastRetriesInRow;
+    int permanentInRow;
+    BreakerState breaker;
+    int currentCooldownSec;
+    std::chrono::steady_clock::time_point breakerUntil;
+    bool hasRetryAt;
+    std::chrono::steady_clock::time_point retryAt;  // Следующая проверка вне обычного интервала
+    FailureStats stats;
+    std::minstd_rand randomGenerator;  // Пауза быстрого повтора; 8 байт вместо 5 КБ mt19937 на монитор
+
+    void OpenBreaker(std::chrono::steady_clock::time_point now);  // Под policyMutex
+    void SetRetryIn(std::chrono::steady_clock::time_point now, int delayMs);
+
+public:
+    FailurePolicy(std::shared_ptr<Logger> loggerInstance, std::shared_ptr<HostBackoff> sharedBackoff,
+                  int maxFastRetryCount, int breakerFailureThreshold, int breakerCooldownSeconds,
+                  uint32_t seed);
+
+    FailurePolicy(const FailurePolicy&) = delete;
+    FailurePolicy& operator=(const FailurePolicy&) = delete;
+
+    void SetHostBackoff(std::shared_ptr<HostBackoff> sharedBackoff);
+
+    // Можно ли отправлять проверку сейчас. false - хост в backoff или breaker открыт,
+    // время следующей попытки - в GetRetryDelayMs
+    bool BeforeCheck(const std::string& host);
+
+    void OnSuccess(const std::string& host);
+    void OnFailure(FailureClass failure, const std::string& host);
+
+    // Пауза до следующей проверки вместо обычного интервала (мс), -1 = обычный интервал
+    int GetRetryDelayMs() const;
+
+    BreakerState GetBreakerState() const;
+    FailureStats GetStats() const;
+
+    // Классификация по коду cURL и HTTP-статусу
+    static FailureClass ClassifyTransfer(CURLcode result);
+    static FailureClass ClassifyHttp(long httpCode);
+    static const char* ClassName(FailureClass failure);
+    static const char* BreakerStateName(BreakerState state);
+};
+
+#endif // FAILURE_POLICY_H
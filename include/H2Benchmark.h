@@ -0,0 +1,40 @@
+#ifndef H2_BENCHMARK_H
+#define H2_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "Config.h"
+#include "CurlMultiEngine.h"
+
+
+// Итог одного прогона event loop
+struct H2BenchmarkResult {
+    std::string mode;
+    EngineStats stats;
+};
+
+
+// HTTP/2 multiplexing в event loop (--bench-h2): тот же список каналов с
+// http2_multiplex=true и false. По EngineStats - передачи, открытые соединения
+// (всего и HTTP/2), streams на HTTP/2 соединение и задержка передачи
+// p50/p90/p99/max. Запросы - на twitch_base_url из конфига, только локальная
+// подставка; чтобы multiplexing было что мерить, она должна говорить HTTP/2
+// (например nghttpx --frontend='127.0.0.1,8794;no-tls' перед HTTP/1.1 подставкой),
+// иначе HTTP/2 столбцы нулевые
+class H2Benchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t channels;
+    int seconds;
+
+    H2BenchmarkResult Run(bool multiplex) const;
+
+public:
+    H2Benchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int durationSeconds);
+
+    // twitch_base_url до вызова проверяет BenchmarkSupport::RequireLocalUrl
+    std::string RunComparison() const;
+};
+
+#endif // H2_BENCHMARK_H
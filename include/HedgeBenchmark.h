@@ -0,0 +1,47 @@
+#ifndef HEDGE_BENCHMARK_H
+#define HEDGE_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "Config.h"
+#include "LatencyWindow.h"
+
+class StandInServer;
+
+
+// Итог одного сочетания hedge_requests / adaptive_timeout
+struct HedgeBenchmarkResult {
+    std::string mode;
+    LatencySummary latency;          // Проверки целиком, включая неудачные
+    size_t checks;
+    size_t failedChecks;             // Без вердикта (в т.ч. таймаут)
+    unsigned long long hedgesSent;
+    unsigned long long hedgesWon;
+
+    HedgeBenchmarkResult() : checks(0), failedChecks(0), hedgesSent(0), hedgesWon(0) {}
+};
+
+
+// Хвост задержки проверки (--bench-hedge): channels каналов параллельно, по
+// checks проверок на канал, против StandInServer, который держит STALL_FRACTION
+// ответов STALL_MS - дольше, чем ADAPTIVE_TIMEOUT_MIN_MS, но меньше timeout.
+// Четыре прогона: без всего, hedge_requests, adaptive_timeout и оба сразу;
+// p50/p99 времени проверки, неудачные проверки и hedge-запросы. Probe выключен:
+// hedge бывает только у полной загрузки. twitch_base_url из конфига не используется
+class HedgeBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t channels;
+    int checks;
+
+    HedgeBenchmarkResult Run(StandInServer& server, bool hedge, bool adaptiveTimeout) const;
+
+public:
+    HedgeBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int checkCount);
+
+    // standInStarted = false - подставка не запустилась, замера нет
+    std::string RunComparison(bool& standInStarted) const;
+};
+
+#endif // HEDGE_BENCHMARK_H
@@ -5,12 +5,14 @@
 #include <chrono>
 #include <thread>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 
 // Класс для имитации человеческого поведения
 class HumanBehavior {
 private:
-    std::mt19937 randomGenerator;
+    std::minstd_rand randomGenerator;  // Генератор у каждого монитора: 8 байт вместо 5 КБ mt19937
     
     // Генераторы случайных задержек
     int GenerateThinkingDelay() const;      // 500-2000ms
@@ -30,6 +32,7 @@ private:
 
 public:
     HumanBehavior();
+    explicit HumanBehavior(uint32_t seed);  // Seed от MonitorContext: без random_device на монитор
     
     // Имитация "думания" перед действием
     void SimulateThinking() const;
@@ -46,12 +49,20 @@ public:
     // Случайная задержка в диапазоне
     void RandomDelay(int minMs, int maxMs) const;
     
+    // Те же паузы без сна: длительность планирует вызывающий
+    int NextThinkingDelayMs() const;
+    int NextPageLoadWaitMs() const;
+    int NextRandomDelayMs(int minMs, int maxMs) const;
+    
     // Получить случайный User-Agent для текущей сессии
     std::string GetSessionUserAgent() const;
     
     // Получить случайные заголовки HTTP
     std::vector<std::pair<std::string, std::string>> GetHumanLikeHeaders() const;
     
+    // Случайный индекс в [0, count) (выбор заранее собранного варианта)
+    size_t PickIndex(size_t count) const;
+    
     // Решить, стоит ли делать дополнительный запрос (для маскировки)
     bool ShouldMakeExtraRequest() const;  // 20% шанс
     
@@ -0,0 +1,36 @@
+#ifndef LATENCY_WINDOW_H
+#define LATENCY_WINDOW_H
+
+#include <vector>
+#include <cstddef>
+
+
+// Перцентили по последним N замерам
+struct LatencySummary {
+    size_t samples;
+    long long p50Ms;
+    long long p90Ms;
+    long long p95Ms;
+    long long p99Ms;
+    long long maxMs;
+
+    LatencySummary() : samples(0), p50Ms(0), p90Ms(0), p95Ms(0), p99Ms(0), maxMs(0) {}
+};
+
+
+// Кольцевой буфер замеров (мс). Не потокобезопасен: защищает владелец.
+class LatencyWindow {
+private:
+    std::vector<long long> samples;
+    size_t capacity;
+    size_t next;
+
+public:
+    explicit LatencyWindow(size_t windowSize);
+
+    void Add(long long valueMs);
+    void Clear();
+    LatencySummary Summarize() const;
+};
+
+#endif // LATENCY_WINDOW_H
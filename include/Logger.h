@@ -28,8 +28,10 @@ private:
     LogLevel minLogLevel;
     
     std::string GetCurrentTimestamp() const;
-    std::string LogLevelToString(LogLevel level) const;
+    void FormatTimestamp(char* buffer, size_t size) const;  // Без выделения памяти
+    const char* LogLevelToString(LogLevel level) const;
     bool ShouldLog(LogLevel level) const;
+    void WriteEntry(const char* message, LogLevel level, const char* module);
 
 
 public:
@@ -41,9 +43,17 @@ public:
              LogLevel level = LogLevel::INFO, 
              const std::string& module = "General");
     
+    // Для литералов: строка не создается, если уровень отфильтрован
+    void Log(const char* message,
+             LogLevel level = LogLevel::INFO,
+             const char* module = "General");
+    
     void SetVerbose(bool verbose);
     void SetMinLogLevel(LogLevel level);
     
+    // Будет ли записано сообщение этого уровня (перед дорогой сборкой строки)
+    bool IsEnabled(LogLevel level) const { return ShouldLog(level); }
+    
     // Convenience methods
     void Debug(const std::string& message, const std::string& module = "General");
     void Info(const std::string& message, const std::string& module = "General");
@@ -53,6 +63,10 @@ public:
     void Success(const std::string& message, const std::string& module = "General");
     void Event(const std::string& message, const std::string& module = "General");
     void System(const std::string& message, const std::string& module = "General");
+    
+    void Debug(const char* message, const char* module = "General");
+    void Info(const char* message, const char* module = "General");
+    void Warning(const char* message, const char* module = "General");
 };
 
 #endif // LOGGER_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef MARKER_BENCHMARK_H
+#define MARKER_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одного способа на одной странице
+struct MarkerBenchmarkResult {
+    std::string page;
+    std::string method;
+    double megabytesPerSecond;
+    bool live;
+
+    MarkerBenchmarkResult() : megabytesPerSecond(0.0), live(false) {}
+};
+
+
+// Поиск маркеров на синтетической странице канала (--bench-markers): прежний
+// WriteCallback (append чанка + три find() по всему буферу на каждый чанк,
+// потом ParseStreamStatus по странице) против потокового MarkerMatcher.
+// Страница - JSON-подобный текст с частыми кавычками и скобками; live-маркер
+// стоит на 80% страницы, offline-страница маркеров не содержит. Чанки - по 16 KB,
+// как отдает libcurl. Скорость - мегабайт страницы в секунду, лучший из проходов
+class MarkerBenchmark {
+private:
+    size_t pageBytes;
+    int rounds;
+
+public:
+    MarkerBenchmark(size_t pageSize, int roundCount);
+
+    // Синтетическая страница канала длиной не меньше bytes
+    static std::string MakePage(bool live, size_t bytes);
+
+    // verdictsAgree = false - способы разошлись или ошиблись со страницей
+    std::string RunComparison(bool& verdictsAgree) const;
+};
+
+#endif // MARKER_BENCHMARK_H
@@ -0,0 +1,105 @@
+#ifndef MARKER_MATCHER_H
+#define MARKER_MATCHER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "MarkerScanner.h"
+
+
+// Маркеры, которые ищем на странице канала
+enum class MarkerId {
+    IS_LIVE_BROADCAST = 0,
+    TYPE_LIVE,
+    BROADCAST_TYPE,
+    STREAM_SECTION,
+    ANTI_BOT_CLOUDFLARE,
+    ANTI_BOT_RECAPTCHA,
+    OFFLINE_END,      // Необязательный: offline_end_marker из конфига
+    COUNT
+};
+
+
+// По какому маркеру определили, что стрим идет
+enum class LiveReason {
+    NONE,
+    IS_LIVE_BROADCAST,
+    TYPE_LIVE,
+    BROADCAST_TYPE
+};
+
+
+// Автомат Aho-Corasick (строится один раз, только для чтения - thread-safe)
+class MarkerAutomaton {
+private:
+    std::vector<uint16_t> transitions;   // state * 256 + byte -> state
+    std::vector<uint32_t> outputs;       // битовая маска маркеров, заканчивающихся в состоянии
+    std::vector<size_t> patternLengths;
+    PrefilterTable prefilter;
+
+public:
+    explicit MarkerAutomaton(const std::vector<std::string>& patterns);
+
+    // Автомат по Constants::TwitchMarkers и AntiBotKeywords
+    static std::shared_ptr<const MarkerAutomaton> GetDefault();
+    
+    // То же + маркер конца встроенного состояния страницы (кэшируется по строке)
+    static std::shared_ptr<const MarkerAutomaton> GetWithOfflineEnd(const std::string& offlineEndMarker);
+
+    uint16_t Next(uint16_t state, unsigned char byte) const {
+        return transitions[(static_cast<size_t>(state) << 8) | byte];
+    }
+    uint32_t Output(uint16_t state) const { return outputs[state]; }
+    size_t GetPatternLength(size_t id) const { return patternLengths[id]; }
+    size_t GetPatternCount() const { return patternLengths.size(); }
+    size_t GetStateCount() const { return outputs.size(); }
+    const PrefilterTable& GetPrefilter() const { return prefilter; }
+};
+
+
+// Потоковый поиск маркеров: состояние переносится через границы чанков,
+// каждый байт страницы просматривается ровно один раз. В корне автомата
+// участки без кандидатов пропускаются векторным префильтром MarkerScanner.
+class MarkerMatcher {
+private:
+    std::shared_ptr<const MarkerAutomaton> automaton;
+    uint16_t state;
+    size_t bytesSeen;
+
+    std::vector<size_t> firstMatchEnd;  // Конец первого вхождения (npos = не найден)
+    bool typeLiveInStreamSection;       // "type":"live" внутри окна "stream":{
+    bool liveFound;
+    bool offlineEndFound;               // Дошли до OFFLINE_END без live-маркера
+    size_t verdictOffset;               // Сколько байт понадобилось для вердикта
+
+    // Хвост страницы для диагностики (вместо всего HTML)
+    std::string tail;
+    size_t tailWindow;
+
+    void OnMatches(uint32_t mask, size_t matchEnd);
+    void MarkLive(size_t matchEnd);
+    void AppendTail(const char* data, size_t length);
+
+public:
+    explicit MarkerMatcher(std::shared_ptr<const MarkerAutomaton> automatonInstance,
+                           size_t tailWindowSize);
+
+    void Reset();
+    void Feed(const char* data, size_t length);
+
+    // Отдать память хвоста между проверками (memory_budget); вердикт и маркеры остаются
+    void ReleaseBuffers();
+
+    bool IsLive() const { return liveFound; }
+    bool IsVerdictDecided() const { return liveFound || offlineEndFound; }
+    size_t GetVerdictOffset() const { return IsVerdictDecided() ? verdictOffset : bytesSeen; }
+    LiveReason GetLiveReason() const;
+    bool IsFound(MarkerId id) const;
+    bool IsAntiBotDetected() const;
+
+    size_t GetBytesSeen() const { return bytesSeen; }
+    const std::string& GetTail() const { return tail; }
+};
+
+#endif // MARKER_MATCHER_H
@@ -0,0 +1,43 @@
+#ifndef MARKER_SCAN_BENCHMARK_H
+#define MARKER_SCAN_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одного ядра префильтра
+struct MarkerScanKernelResult {
+    std::string kernel;
+    size_t candidates;       // Позиций-кандидатов на обеих страницах
+    size_t splitsChecked;    // Разрезов страниц, сверенных с эталоном
+    bool candidatesMatch;    // Те же позиции, что у скалярного ядра
+    bool verdictsMatch;      // Те же вердикты MarkerMatcher при любом разрезе
+    double prefilterGbps;
+    double matcherGbps;
+
+    MarkerScanKernelResult()
+        : candidates(0), splitsChecked(0), candidatesMatch(true), verdictsMatch(true),
+          prefilterGbps(0.0), matcherGbps(0.0) {}
+};
+
+
+// Сверка и скорость ядер MarkerScanner (--bench-marker-scan). Каждое ядро,
+// которое поддерживает CPU, проходит live- и offline-страницу MarkerBenchmark:
+// позиции-кандидаты должны совпасть со скалярным ядром, а вердикт MarkerMatcher
+// (live, смещение вердикта, найденные маркеры) - с эталоном на целой странице
+// при разрезе короткой страницы на два чанка в каждой позиции и большой -
+// на чанки разных длин; с маркером конца состояния и без. Скорость - GB/s
+// одного префильтра и всего MarkerMatcher на чанках по 16 KB
+class MarkerScanBenchmark {
+private:
+    size_t pageBytes;
+    int rounds;
+
+public:
+    MarkerScanBenchmark(size_t pageSize, int roundCount);
+
+    // kernelsAgree = false - хотя бы одно ядро разошлось со скалярным
+    std::string RunComparison(bool& kernelsAgree) const;
+};
+
+#endif // MARKER_SCAN_BENCHMARK_H
@@ -0,0 +1,56 @@
+#ifndef MARKER_SCANNER_H
+#define MARKER_SCANNER_H
+
+#include <string>
+#include <cstddef>
+
+
+// Первый/последний байт каждого маркера для быстрого отсева позиций
+struct PrefilterTable {
+    static const size_t MAX_PATTERNS = 32;
+
+    size_t count;
+    unsigned char firstBytes[MAX_PATTERNS];
+    unsigned char lastBytes[MAX_PATTERNS];
+    size_t lastOffsets[MAX_PATTERNS];  // длина маркера - 1
+    size_t maxPatternLength;
+
+    PrefilterTable() : count(0), firstBytes{}, lastBytes{}, lastOffsets{}, maxPatternLength(0) {}
+};
+
+
+// Реализация поиска кандидатов (выбирается при запуске по CPUID)
+enum class ScanKernel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+
+// Векторный префильтр: ищет позиции, где совпадают первый и последний байт
+// хотя бы одного маркера. Полную проверку делает автомат MarkerMatcher.
+namespace MarkerScanner {
+    // Первая позиция-кандидат в [from, limit) или limit, если кандидатов нет.
+    // Требование: limit + maxPatternLength - 1 <= длина data.
+    size_t FindCandidate(const PrefilterTable& table, const unsigned char* data,
+                         size_t from, size_t limit);
+
+    // Конкретные ядра (для сверки результатов между собой)
+    size_t FindCandidateScalar(const PrefilterTable& table, const unsigned char* data,
+                               size_t from, size_t limit);
+    size_t FindCandidateSse2(const PrefilterTable& table, const unsigned char* data,
+                             size_t from, size_t limit);
+    size_t FindCandidateAvx2(const PrefilterTable& table, const unsigned char* data,
+                             size_t from, size_t limit);
+
+    // Выбор ядра
+    ScanKernel DetectBestKernel();
+    bool IsKernelSupported(ScanKernel kernel);
+    bool SetActiveKernel(ScanKernel kernel);  // false, если CPU не поддерживает
+    ScanKernel GetActiveKernel();
+
+    const char* KernelName(ScanKernel kernel);
+    bool ParseKernelName(const std::string& name, ScanKernel& kernel);
+}
+
+#endif // MARKER_SCANNER_H
@@ -0,0 +1,36 @@
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include "MonitorContext.h"
+
+
+// Память процесса: resident set (ОС) и занятая куча (аллокатор), -1 - не поддерживается
+struct MemoryUsage {
+    long rssKb;
+    long long heapBytes;
+
+    MemoryUsage() : rssKb(-1), heapBytes(-1) {}
+
+    static MemoryUsage Current();
+};
+
+
+// Учет памяти каналов (--memory-report): куча каждой подсистемы монитора на выборке
+// экземпляров и RSS/куча N полных каналов в реестре, как в --multi. Настройки
+// (memory_budget и остальные) - из конфига контекста. Сеть не нужна: запросов нет
+class MemoryReport {
+private:
+    std::shared_ptr<MonitorContext> context;
+    size_t channels;
+    size_t sampleSize;
+
+public:
+    MemoryReport(std::shared_ptr<MonitorContext> contextInstance, size_t channelCount);
+
+    std::string Run();
+};
+
+#endif // MEMORY_REPORT_H
@@ -0,0 +1,71 @@
+#ifndef MONITOR_CONTEXT_H
+#define MONITOR_CONTEXT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <curl/curl.h>
+#include "Config.h"
+#include "Logger.h"
+#include "FailurePolicy.h"
+#include "PollPredictor.h"
+#include "ChannelStateTable.h"
+#include "StreamerNames.h"
+
+
+// Общие на процесс ресурсы мониторов: один разобранный конфиг, один лог,
+// каталоги logs/ и stats/, источник seed для генераторов, варианты заголовков
+// запроса, backoff хостов и бюджет predictive-опроса. Монитор держит shared_ptr
+// и ничего из этого не создает сам. После создания только читается (THREAD-SAFE)
+class MonitorContext {
+private:
+    std::shared_ptr<Config> config;
+    std::shared_ptr<Logger> logger;
+    bool standalone;  // Один монитор на процесс: трасса конструкторов и баннеры в лог
+    bool memoryBudget;  // memory_budget: ресурсы канала - только на время проверки
+
+    uint64_t seedBase;                  // Один std::random_device на процесс
+    std::atomic<uint64_t> seedCounter;
+
+    // Собраны один раз; WebScraper выбирает случайный на каждый запрос
+    std::vector<struct curl_slist*> headerVariants;
+
+    std::shared_ptr<HostBackoff> hostBackoff;
+    std::shared_ptr<PollBudget> pollBudget;
+    std::shared_ptr<ChannelStateTable> stateTable;  // Горячее состояние всех каналов
+    std::shared_ptr<StreamerNameTable> streamerNames;  // Имена и URL страниц по StreamerId
+
+    void BuildHeaderVariants();
+
+public:
+    MonitorContext(std::shared_ptr<Config> configInstance, std::shared_ptr<Logger> loggerInstance,
+                   bool standaloneMonitor = false);
+    ~MonitorContext();
+
+    MonitorContext(const MonitorContext&) = delete;
+    MonitorContext& operator=(const MonitorContext&) = delete;
+
+    // Контекст одиночного монитора: читает configPath, лог в logs/stream_monitor.log
+    static std::shared_ptr<MonitorContext> CreateStandalone(const std::string& configPath);
+
+    // logs/ и stats/ - один раз на процесс, без запуска shell
+    static void EnsureDirectories();
+
+    const Config& GetConfig() const { return *config; }
+    std::shared_ptr<Logger> GetLogger() const { return logger; }
+    bool IsStandalone() const { return standalone; }
+    bool IsMemoryBudget() const { return memoryBudget; }
+
+    // Разные seed для генераторов мониторов (splitmix64 от общего seed)
+    uint32_t NextSeed();
+
+    const std::vector<struct curl_slist*>& GetHeaderVariants() const { return headerVariants; }
+    std::shared_ptr<HostBackoff> GetHostBackoff() const { return hostBackoff; }
+    std::shared_ptr<PollBudget> GetPollBudget() const { return pollBudget; }
+    std::shared_ptr<ChannelStateTable> GetStateTable() const { return stateTable; }
+    const std::shared_ptr<StreamerNameTable>& GetStreamerNames() const { return streamerNames; }
+};
+
+#endif // MONITOR_CONTEXT_H
@@ -0,0 +1,84 @@
+#ifndef MONITOR_REGISTRY_H
+#define MONITOR_REGISTRY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+
+class StreamMonitor;
+
+
+// Монитор одного стримера в реестре. Имя и монитор не меняются после создания,
+// состояние запуска - atomic: запись меняет его прямо в опубликованной версии
+struct MonitorInfo {
+    const std::string streamerName;
+    const std::shared_ptr<StreamMonitor> monitor;  // shared: держат callbacks event loop и задачи пула
+    std::atomic<uint64_t> scheduleId;  // Задача в CheckScheduler (режим threads), 0 = нет
+    std::atomic<bool> isRunning;
+
+    MonitorInfo(const std::string& name, std::shared_ptr<StreamMonitor> monitorInstance)
+        : streamerName(name), monitor(std::move(monitorInstance)), scheduleId(0), isRunning(false) {}
+
+    MonitorInfo(const MonitorInfo&) = delete;
+    MonitorInfo& operator=(const MonitorInfo&) = delete;
+};
+
+
+// Неизменяемая версия реестра. Ключи index - string_view на streamerName
+// элементов monitors: они живут, пока жива версия
+struct MonitorSnapshot {
+    std::vector<std::shared_ptr<MonitorInfo>> monitors;
+    std::unordered_map<std::string_view, size_t> index;
+    uint64_t version;
+
+    MonitorSnapshot() : version(0) {}
+
+    std::shared_ptr<MonitorInfo> Find(std::string_view streamerName) const;
+};
+
+
+// Реестр мониторов в стиле RCU: читатель берет текущую версию одной атомарной
+// загрузкой указателя и дальше работает с ней без блокировок, сколько угодно долго.
+// Писатель копирует версию, меняет копию и публикует ее; старую освобождает
+// последний читатель. Писатели сериализуются между собой (THREAD-SAFE)
+class MonitorRegistry {
+private:
+    // Только через std::atomic_load / std::atomic_store
+    std::shared_ptr<const MonitorSnapshot> current;
+    std::mutex writeMutex;
+
+    // Под writeMutex: копия текущей версии для изменения / публикация
+    std::shared_ptr<MonitorSnapshot> CopyCurrent() const;
+    void Publish(std::shared_ptr<MonitorSnapshot> next);
+
+    static bool Insert(MonitorSnapshot& snapshot, std::shared_ptr<MonitorInfo> info);
+    static std::shared_ptr<MonitorInfo> Erase(MonitorSnapshot& snapshot, std::string_view streamerName);
+
+public:
+    MonitorRegistry();
+
+    MonitorRegistry(const MonitorRegistry&) = delete;
+    MonitorRegistry& operator=(const MonitorRegistry&) = delete;
+
+    // Чтение: не ждет писателей
+    std::shared_ptr<const MonitorSnapshot> GetSnapshot() const;
+    std::shared_ptr<MonitorInfo> Find(std::string_view streamerName) const;
+    size_t Size() const;
+
+    // Запись. false / nullptr - имя уже есть / не найдено
+    bool Add(std::shared_ptr<MonitorInfo> info);
+    std::shared_ptr<MonitorInfo> Remove(std::string_view streamerName);
+
+    // Пакет изменений одной новой версией. В removed/added - что реально изменилось
+    void Apply(const std::vector<std::string>& removeNames,
+               const std::vector<std::shared_ptr<MonitorInfo>>& addInfos,
+               std::vector<std::shared_ptr<MonitorInfo>>& removed,
+               std::vector<std::shared_ptr<MonitorInfo>>& added);
+};
+
+#endif // MONITOR_REGISTRY_H
@@ -7,60 +7,106 @@
 #include <mutex>
 #include <memory>
 #include <atomic>
+#include <cstdint>
 #include "StreamMonitor.h"
+#include "CurlMultiEngine.h"
+#include "CurlShare.h"
+#include "CheckScheduler.h"
+#include "TaskExecutor.h"
+#include "PollPredictor.h"
+#include "RateLimiter.h"
+#include "FailurePolicy.h"
+#include "StreamerListWatcher.h"
+#include "MonitorRegistry.h"
+#include "MonitorContext.h"
 #include "Config.h"
 #include "Logger.h"
 
 
-// Структура для хранения информации о мониторе
-struct MonitorInfo {
-    std::string streamerName;
-    std::unique_ptr<StreamMonitor> monitor;
-    std::unique_ptr<std::thread> thread;
-    bool isRunning;  // ← ИЗМЕНЕНО: обычный bool вместо std::atomic<bool>
-    
-    // Конструктор по умолчанию
-    MonitorInfo() : isRunning(false) {}
-    
-    // Запрет копирования
-    MonitorInfo(const MonitorInfo&) = delete;
-    MonitorInfo& operator=(const MonitorInfo&) = delete;
-    
-    // Разрешаем перемещение
-    MonitorInfo(MonitorInfo&& other) noexcept
-        : streamerName(std::move(other.streamerName)),
-          monitor(std::move(other.monitor)),
-          thread(std::move(other.thread)),
-          isRunning(other.isRunning) {
-        other.isRunning = false;
-    }
-    
-    MonitorInfo& operator=(MonitorInfo&& other) noexcept {
-        if (this != &other) {
-            streamerName = std::move(other.streamerName);
-            monitor = std::move(other.monitor);
-            thread = std::move(other.thread);
-            isRunning = other.isRunning;
-            other.isRunning = false;
-        }
-        return *this;
-    }
+// Последний StopAll по этапам, мс от вызова
+struct ShutdownTimings {
+    size_t monitors;
+    double checksStoppedMs;      // Лимитер и event loop (или пул) остановлены, передачи прерваны
+    double statisticsFlushedMs;  // Запись статистики закончена или вышел shutdown_timeout_ms
+    double stoppedMs;            // StopAll вернулся
+    size_t statisticsNotSaved;   // Не успели к shutdown_timeout_ms
+
+    ShutdownTimings()
+        : monitors(0), checksStoppedMs(0.0), statisticsFlushedMs(0.0), stoppedMs(0.0), statisticsNotSaved(0) {}
 };
 
 
 // Класс для параллельного мониторинга нескольких стримеров
 class MultiStreamMonitor {
 private:
-    std::vector<MonitorInfo> monitors;
-    mutable std::mutex monitorsMutex;
+    // Читатели (статус, метрики, GetStreamers) берут снапшот реестра и не ждут писателей.
+    // lifecycleMutex сериализует писателей с StartAll/StopAll, чтобы запуск не разошелся с реестром
+    MonitorRegistry registry;
+    std::mutex lifecycleMutex;
     std::shared_ptr<Config> config;
     std::shared_ptr<Logger> logger;
+    std::shared_ptr<MonitorContext> context;  // Эти config и logger - для всех мониторов
     std::atomic<bool> isRunning;
     
-    void MonitorThreadFunction(StreamMonitor* monitor);
+    // Event loop режим: все проверки через один поток curl_multi
+    bool useEventLoop;
+    std::unique_ptr<CurlMultiEngine> engine;
+    
+    // Режим threads: дедлайны проверок в колесе таймеров (или куче), фиксированный пул worker_threads
+    std::unique_ptr<CheckScheduler> scheduler;
+    
+    // Work stealing пул: завершение проверок event loop, разбор, события смены статуса
+    std::shared_ptr<TaskExecutor> executor;
+    
+    // Общий кэш DNS/TLS/соединений всех мониторов (nullptr, если share_connections=false)
+    std::shared_ptr<CurlShare> curlShare;
+    
+    // Token bucket + предел запросов на хост: проверки ждут токен в очереди, а не идут всплеском
+    std::shared_ptr<RateLimiter> rateLimiter;
+    
+    // Backoff хостов после throttling - общий, чтобы 429 одному монитору притормозил всех
+    std::shared_ptr<HostBackoff> hostBackoff;
+    
+    // Бюджет predictive-опроса на все каналы (poll_budget_per_minute)
+    std::shared_ptr<PollBudget> pollBudget;
+    
+    // streamers.txt под наблюдением (watch_streamers_file): изменения применяются diff'ом
+    std::string streamersFilePath;
+    std::unique_ptr<StreamerListWatcher> listWatcher;
+    std::mutex reloadMutex;  // Один diff за раз; lifecycleMutex держится только на применение
+    
+    ShutdownTimings lastShutdown;  // Под lifecycleMutex
+    
+    // Новый монитор с общими контекстом, лимитером, backoff и пулом. Без блокировок - читает stats/
+    std::shared_ptr<MonitorInfo> CreateMonitor(const std::string& streamerName);
+    std::shared_ptr<MonitorInfo> CreateMonitor(StreamerId streamerId);  // Имя уже интернировано
+    
+    // Под lifecycleMutex: остановить проверки монитора
+    void StopMonitor(MonitorInfo& info);
+    
+    // Одна проверка в пуле: задержка до следующей (мс) или -1, если монитор остановлен
+    int RunPooledCheck(std::shared_ptr<StreamMonitor> monitor);
+    
+    // Поставить первую проверку монитора (event loop или пул), под lifecycleMutex
+    void StartMonitor(MonitorInfo& info, int delayMs);
+    
+    // Планирование проверок в event loop
+    static int NextCheckDelayMs(StreamMonitor& monitor);
+    void ScheduleCheck(std::shared_ptr<StreamMonitor> monitor, int delayMs);
+    void RunAsyncCheck(std::shared_ptr<StreamMonitor> monitor);
+    // easy = nullptr: первая фаза, handle создается по разрешению лимитера
+    void SubmitTransfer(std::shared_ptr<StreamMonitor> monitor, CURL* easy);
+    void FinishTransfer(std::shared_ptr<StreamMonitor> monitor, CURLcode result, bool fromHedge);
+    void DeferCheck(std::shared_ptr<StreamMonitor> monitor);  // Лимитер отказал - следующая по расписанию
+    
+    // Параллельная запись статистики через executor, не дольше timeoutMs. Сколько файлов не записано
+    size_t FlushStatistics(const std::vector<std::shared_ptr<StreamMonitor>>& toFlush, int timeoutMs);
 
 public:
     MultiStreamMonitor(const std::string& configPath = "config.ini");
+    
+    // Уже загруженный конфиг (замеры подменяют в нем настройки через Set)
+    explicit MultiStreamMonitor(std::shared_ptr<Config> configInstance);
     ~MultiStreamMonitor();
     
     MultiStreamMonitor(const MultiStreamMonitor&) = delete;
@@ -69,13 +115,29 @@ public:
     bool AddStreamer(const std::string& streamerName);
     bool RemoveStreamer(const std::string& streamerName);
     std::vector<std::string> GetStreamers() const;
+    unsigned long long GetCheckCount() const;  // Начатые проверки всех мониторов
+    size_t GetCheckedMonitorCount() const;     // Мониторы, начавшие хотя бы одну проверку
+    
+    // Передачи, соединения и HTTP/2 streams event loop; в режиме threads - пусто
+    EngineStats GetEngineStats() const;
+    
+    // Опоздание проверок к сроку (event loop или пул) с последнего ResetSchedulingLag
+    LatencySummary GetSchedulingLag() const;
+    void ResetSchedulingLag();
     
     void StartAll();
     void StopAll();
+    ShutdownTimings GetLastShutdownTimings();
     void PrintStatus() const;
     
     bool LoadStreamersFromFile(const std::string& filePath);
+    
+    // Привести набор мониторов к списку: запустить только новые имена, остановить только
+    // исчезнувшие. Остальные мониторы и их расписание не трогаются
+    bool ApplyStreamerList(const std::vector<std::string>& streamerNames);
+    bool ReloadStreamersFromFile();
     bool IsRunning() const { return isRunning.load(); }
+    bool IsEventLoopMode() const { return useEventLoop; }
 };
 
 #endif // MULTI_STREAM_MONITOR_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef POLL_PREDICTOR_H
+#define POLL_PREDICTOR_H
+
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+
+// Общий бюджет опросов offline-каналов (запросов в секунду на все каналы).
+// Интервал канала = Scale() / вес, вес = sqrt(частоты стартов в этот час недели).
+// При таком законе средняя задержка обнаружения минимальна для заданного числа запросов,
+// а сумма 1/интервал по неделе и каналам равна бюджету (THREAD-SAFE).
+class PollBudget {
+private:
+    mutable std::mutex budgetMutex;
+    double requestsPerSecond;  // 0 = как у фиксированного интервала
+    int defaultIntervalSec;
+    double weightSum;          // Сумма средних недельных весов каналов
+    size_t channels;
+
+public:
+    // requestsPerMinute <= 0: бюджет = каналы / defaultIntervalSec
+    PollBudget(double requestsPerMinute, int defaultIntervalSec);
+
+    void Join(double weight);
+    void Leave(double weight);
+    void Update(double oldWeight, double newWeight);
+
+    // Коэффициент интервала (с * sqrt(стартов/час))
+    double Scale() const;
+    double GetRequestsPerMinute() const;
+};
+
+
+// Недельный профиль начала стримов одного канала: гистограмма по часу недели (UTC),
+// обновляется по одной сессии. Выбирает интервал опроса, пока канал offline (THREAD-SAFE).
+class PollPredictor {
+private:
+    static const int HOURS_PER_WEEK = 168;
+
+    mutable std::mutex predictorMutex;
+    // float: 1.3 КБ на канал вместо 2.7 КБ, точности счетчиков и весов хватает
+    float starts[HOURS_PER_WEEK];
+    long long observedSince;   // Начало истории наблюдений (Unix time)
+    int minIntervalSec;
+    int maxIntervalSec;
+
+    std::shared_ptr<PollBudget> budget;
+    float hourWeights[HOURS_PER_WEEK];  // sqrt(частоты стартов) по часам недели
+    double meanWeight;         // Вклад канала в budget
+    long long meanWeightHour;  // Час, для которого посчитаны веса
+
+    // Коэффициент канала: общий Scale() с поправкой на границы интервала
+    double channelScale;
+    double channelScaleFor;    // Scale(), для которого он посчитан
+
+    static int HourOfWeek(long long unixTime);
+    double WeeksObserved(long long unixTime) const;
+    double RateAt(int hour, double weeks) const;  // Ожидаемых стартов за этот час недели
+    void RefreshMeanWeight(long long unixTime);   // Под predictorMutex
+    double ClampInterval(double intervalSec) const;
+    void SolveChannelScale(double sharedScale);   // Под predictorMutex
+
+public:
+    PollPredictor(std::shared_ptr<PollBudget> sharedBudget, int minIntervalSeconds,
+                  int maxIntervalSeconds, long long observedSinceTime);
+    ~PollPredictor();
+
+    PollPredictor(const PollPredictor&) = delete;
+    PollPredictor& operator=(const PollPredictor&) = delete;
+
+    // Подключить канал к общему бюджету (старый бюджет освобождается)
+    void SetBudget(std::shared_ptr<PollBudget> sharedBudget);
+
+    // Канал вышел в эфир в unixTime
+    void RecordStart(long long unixTime);
+
+    // Интервал до следующей проверки offline-канала
+    int NextIntervalSec(long long unixTime);
+
+    double GetStartRate(long long unixTime) const;
+};
+
+#endif // POLL_PREDICTOR_H
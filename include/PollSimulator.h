@@ -0,0 +1,56 @@
+#ifndef POLL_SIMULATOR_H
+#define POLL_SIMULATOR_H
+
+#include <string>
+#include <vector>
+#include "Config.h"
+#include "Statistics.h"
+
+
+// Итог одного прогона: запросы и задержка обнаружения старта (с)
+struct PollSimulationResult {
+    std::string policy;
+    double budgetFactor;           // Доля от запросов fixed-политики с check_interval
+    unsigned long long requests;
+    double requestsPerMinute;
+    int detections;
+    int missed;                    // Сессии, закончившиеся между двумя проверками
+    double meanDelaySec;
+    long long p90DelaySec;
+
+    PollSimulationResult()
+        : budgetFactor(1.0), requests(0), requestsPerMinute(0.0), detections(0), missed(0),
+          meanDelaySec(0.0), p90DelaySec(0) {}
+};
+
+
+// Офлайн-прогон записанных сессий через политику опроса (--simulate-polling).
+// Проверки моделируются так же, как в StreamMonitor::GetCurrentCheckInterval;
+// predictive учится по ходу прогона, метрики - по второй половине истории.
+class PollSimulator {
+private:
+    struct Channel {
+        std::string name;
+        std::vector<StreamSession> sessions;  // По возрастанию startTime
+    };
+
+    std::vector<Channel> channels;
+    int checkInterval;
+    int checkIntervalFast;
+    int fastModeDuration;
+    int maxInterval;
+
+public:
+    explicit PollSimulator(const Config& config);
+
+    void AddChannel(const std::string& name, std::vector<StreamSession> sessions);
+    size_t GetChannelCount() const { return channels.size(); }
+
+    // predictive = false: fixed-интервал check_interval / budgetFactor
+    PollSimulationResult Run(bool predictive, double budgetFactor) const;
+
+    // Таблица fixed vs predictive при нескольких бюджетах
+    std::string RunComparison() const;
+};
+
+#endif // POLL_SIMULATOR_H
@@ -0,0 +1,52 @@
+#ifndef PROBE_BENCHMARK_H
+#define PROBE_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Config.h"
+
+class StandInServer;
+
+
+// Итог одного способа проверки
+struct ProbeBenchmarkResult {
+    std::string mode;
+    size_t checks;
+    unsigned long long pageRequests;  // По подставке, без главной страницы HumanBehavior
+    unsigned long long fullFetches;   // Из них GET всей страницы
+    double receivedKb;                // Тела по TransferStats скраперов
+    size_t wrongVerdicts;             // Против состояния подставки
+    size_t failedChecks;
+    std::vector<bool> verdicts;       // По порядку проверок - для сравнения с полной загрузкой
+
+    ProbeBenchmarkResult()
+        : checks(0), pageRequests(0), fullFetches(0), receivedKb(0.0), wrongVerdicts(0), failedChecks(0) {}
+};
+
+
+// Двухфазная проверка (--bench-probe): те же channels каналов проверяются rounds
+// раз полной загрузкой, HEAD-probe и Range-probe против StandInServer в самом
+// процессе. Каналы по расписанию переходят live/offline, так что probe должен
+// заметить смену по ETag. Считаются запросы к страницам, полные GET и байты
+// тел, вердикты сравниваются с полной загрузкой проверка в проверку.
+// twitch_base_url из конфига не используется - только подставка
+class ProbeBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t channels;
+    int rounds;
+
+    ProbeBenchmarkResult Run(StandInServer& server, const std::string& mode, bool useHeadRequest,
+                             int probeRangeBytes) const;
+
+public:
+    ProbeBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int roundCount);
+
+    // verdictsMatch = false - probe разошелся с полной загрузкой или с подставкой,
+    // проверка не удалась или подставка не запустилась
+    std::string RunComparison(bool& verdictsMatch) const;
+};
+
+#endif // PROBE_BENCHMARK_H
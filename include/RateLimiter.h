@@ -0,0 +1,126 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <string>
+#include <memory>
+#include <list>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "Logger.h"
+#include "LatencyWindow.h"
+
+
+// Разрешение на запрос: granted = false, если запрос отклонен (ждал дольше
+// max_wait, отменен или лимитер остановлен). После granted = true вызвать Release(host)
+using RateLimitCallback = std::function<void(bool granted)>;
+
+
+// Снимок метрик лимитера. Wait - сколько запрос простоял в очереди
+struct RateLimiterStats {
+    unsigned long long granted;
+    unsigned long long deferred;   // Из granted - ждали в очереди, а не прошли сразу
+    unsigned long long rejected;   // Не дождались токена за max_wait или лимитер остановлен
+    unsigned long long cancelled;
+    size_t queued;
+    size_t peakQueued;
+    size_t inFlight;
+    int peakInFlightPerHost;   // Больше всего одновременных запросов к одному хосту
+    LatencySummary wait;
+
+    RateLimiterStats() : granted(0), deferred(0), rejected(0), cancelled(0),
+                         queued(0), peakQueued(0), inFlight(0), peakInFlightPerHost(0) {}
+};
+
+
+// Общий на все мониторы token bucket (запросов в секунду, с запасом burst) +
+// предел одновременных запросов на хост. Кто не прошел сразу - ждет в FIFO очереди;
+// запрос к хосту, упершемуся в предел, не держит очередь к другим хостам (THREAD-SAFE)
+class RateLimiter {
+private:
+    struct Waiter {
+        uint64_t ticket;
+        std::string host;
+        RateLimitCallback onReady;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    static const size_t WAIT_WINDOW = 4096;
+
+    std::shared_ptr<Logger> logger;
+    double ratePerSecond;   // 0 = без ограничения частоты
+    double burst;
+    int maxPerHost;         // 0 = без ограничения параллельности
+    int maxWaitMs;          // 0 = ждать сколько угодно
+
+    mutable std::mutex limiterMutex;
+    std::condition_variable wakeup;
+    double tokens;
+    std::chrono::steady_clock::time_point lastRefill;
+    std::list<Waiter> queue;
+    std::unordered_map<uint64_t, std::list<Waiter>::iterator> waiterByTicket;
+    std::unordered_map<std::string, int> inFlightByHost;
+    uint64_t nextTicket;
+    RateLimiterStats stats;
+    LatencyWindow waitWindow;
+
+    std::thread dispatcherThread;
+    std::atomic<bool> running;
+
+    // Все под limiterMutex; разрешенные/отклоненные переносятся в ready,
+    // callbacks вызываются уже без блокировки
+    void Refill(std::chrono::steady_clock::time_point now);
+    bool CanGrant(const std::string& host) const;
+    void Grant(const std::string& host);
+    void DispatchQueue(std::chrono::steady_clock::time_point now,
+                       std::vector<std::pair<RateLimitCallback, bool>>& ready);
+    std::chrono::steady_clock::time_point NextEventTime() const;
+
+    static void RunCallbacks(std::vector<std::pair<RateLimitCallback, bool>>& ready);
+    void DispatcherThreadFunction();
+
+public:
+    // requestsPerSecond <= 0 и maxInFlightPerHost <= 0 - лимитер пропускает все сразу
+    RateLimiter(std::shared_ptr<Logger> loggerInstance, double requestsPerSecond, int burstSize,
+                int maxInFlightPerHost, int maxQueueWaitMs);
+    ~RateLimiter();
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    bool Start();
+    void Stop();  // Отклоняет всех ждущих
+
+    // Встать в очередь за разрешением. onReady вызывается ровно один раз:
+    // сразу (в этом потоке) или из потока лимитера - поэтому должен быть коротким.
+    // Возвращает ticket для Cancel
+    uint64_t Submit(const std::string& host, RateLimitCallback onReady);
+
+    // Блокирующий вариант для проверок в потоках. ticket доступен Cancel() из других потоков
+    bool Acquire(const std::string& host, std::atomic<uint64_t>& ticket);
+
+    // Разрешение только если оно есть прямо сейчас, без очереди (hedge-запросы).
+    // true - после запроса вызвать Release(host)
+    bool TryAcquire(const std::string& host);
+
+    // Снять запрос из очереди (onReady(false)); уже разрешенный не трогает
+    bool Cancel(uint64_t ticket);
+
+    // Запрос к host закончился
+    void Release(const std::string& host);
+
+    RateLimiterStats GetStats() const;
+    std::string GetStatsSummary() const;
+
+    // "https://www.twitch.tv/name" -> "www.twitch.tv"
+    static std::string HostOf(const std::string& url);
+};
+
+#endif // RATE_LIMITER_H
@@ -0,0 +1,44 @@
+#ifndef RATE_LIMITER_BENCHMARK_H
+#define RATE_LIMITER_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одного прогона: что увидела подставка
+struct RateLimiterBenchmarkResult {
+    std::string mode;
+    double requestsPerSec;
+    int peakInFlightPerHost;         // По подставке
+    int limiterPeakInFlightPerHost;  // По RateLimiterStats
+    unsigned long long throttled;    // Ответили бы 429
+
+    RateLimiterBenchmarkResult()
+        : requestsPerSec(0.0), peakInFlightPerHost(0), limiterPeakInFlightPerHost(0), throttled(0) {}
+};
+
+
+// RateLimiter под нагрузкой (--bench-rate-limiter): клиенты по кругу шлют запросы
+// к HOSTS хостам подставки, которая в самом процессе держит запрос latency мс и
+// считает 429 при превышении тех же rate_limit_rps/burst и max_inflight_per_host.
+// Два прогона: короткие ответы (упор в частоту) и долгие (упор в предел на хост),
+// каждый с лимитером и без него - без лимитера подставка должна начать отказывать
+class RateLimiterBenchmark {
+private:
+    int rps;
+    int burst;
+    int maxInFlight;
+    int seconds;
+
+    RateLimiterBenchmarkResult Run(const std::string& mode, bool limited, size_t clients, int latencyMs) const;
+
+public:
+    // Значения <= 0 - по умолчанию из Constants: без предела проверять нечего
+    RateLimiterBenchmark(int requestsPerSecond, int burstSize, int maxInFlightPerHost, int durationSeconds);
+
+    // limitsHeld = false - лимитер пропустил больше частоты или предела на хост,
+    // подставка отказала или частота заметно ниже rate_limit_rps
+    std::string RunComparison(bool& limitsHeld) const;
+};
+
+#endif // RATE_LIMITER_BENCHMARK_H
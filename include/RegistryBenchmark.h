@@ -0,0 +1,46 @@
+#ifndef REGISTRY_BENCHMARK_H
+#define REGISTRY_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одного прогона: пропускная способность и задержка чтения (мкс)
+struct RegistryBenchmarkResult {
+    std::string registry;
+    double readsPerSec;
+    double p50ReadUs;
+    double p99ReadUs;
+    double p999ReadUs;
+    double maxReadUs;
+    unsigned long long stalledReads;  // Замеров дольше 100 мкс
+    double writesPerSec;
+
+    RegistryBenchmarkResult()
+        : readsPerSec(0.0), p50ReadUs(0.0), p99ReadUs(0.0), p999ReadUs(0.0), maxReadUs(0.0), stalledReads(0),
+          writesPerSec(0.0) {}
+};
+
+
+// Конкурентный прогон реестра мониторов (--bench-registry): читатели ищут
+// каналы по имени и изредка обходят весь список (как PrintStatus), один писатель
+// без пауз применяет изменения списка пакетами, как перечитывание streamers.txt,
+// с остановкой/запуском каждого измененного канала.
+// MonitorRegistry против прежней схемы "vector + индекс под mutex".
+// Мониторы пустые - меряется только реестр
+class RegistryBenchmark {
+private:
+    int readers;
+    int durationSeconds;
+    size_t size;
+
+public:
+    RegistryBenchmark(int readerThreads, int seconds, size_t registrySize);
+
+    // snapshot = false: vector + unordered_map под std::mutex
+    RegistryBenchmarkResult Run(bool snapshot) const;
+
+    std::string RunComparison() const;
+};
+
+#endif // REGISTRY_BENCHMARK_H
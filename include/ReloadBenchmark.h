@@ -0,0 +1,47 @@
+#ifndef RELOAD_BENCHMARK_H
+#define RELOAD_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "Config.h"
+#include "LatencyWindow.h"
+
+
+// Итог одного применения diff
+struct ReloadBenchmarkResult {
+    std::string mode;
+    double applyMs;           // Весь вызов ApplyStreamerList
+    bool listMatches;         // После diff в реестре ровно новый список
+    bool running;
+    LatencySummary lagBefore; // Опоздание проверок до diff
+    LatencySummary lagDuring; // Во время diff и LAG_WINDOW_MS после
+
+    ReloadBenchmarkResult() : applyMs(0.0), listMatches(false), running(false) {}
+};
+
+
+// Перечитывание большого streamers.txt (--bench-reload): ApplyStreamerList
+// переводит channels мониторов на список, где changed имен другие (половина
+// убрана, половина новых). Сначала на незапущенных мониторах, потом на
+// работающих: для них сравнивается опоздание проверок к сроку до и во время
+// diff - нетронутые мониторы не должны его заметить. check_interval - верхняя
+// граница, первые проверки разнесены на весь интервал, чтобы подставка
+// выдержала поток. Запросы - на twitch_base_url из конфига, только локальная подставка
+class ReloadBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t channels;
+    size_t changed;
+
+    ReloadBenchmarkResult Run(bool running) const;
+
+public:
+    ReloadBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, size_t changedCount);
+
+    // twitch_base_url до вызова проверяет BenchmarkSupport::RequireLocalUrl.
+    // listsMatch = false - после diff в реестре не тот список
+    std::string RunComparison(bool& listsMatch) const;
+};
+
+#endif // RELOAD_BENCHMARK_H
@@ -0,0 +1,44 @@
+#ifndef SCHEDULER_BENCHMARK_H
+#define SCHEDULER_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+// Итог одного backend очереди дедлайнов
+struct SchedulerBenchmarkResult {
+    std::string backend;
+    double elapsedMs;
+    uint64_t fired;
+    uint64_t moved;       // Schedule уже стоящей задачи (перенос)
+    uint64_t wakeups;     // Проходов PopExpired
+    double nsPerOperation;
+    int64_t maxLateMs;    // Сколько сработавший дедлайн прождал после наступления
+    uint64_t checksum;    // Порядок срабатываний: должен совпасть у всех backend
+
+    SchedulerBenchmarkResult()
+        : elapsedMs(0.0), fired(0), moved(0), wakeups(0), nsPerOperation(0.0), maxLateMs(0), checksum(0) {}
+};
+
+
+// Перепланирование каналов в очереди дедлайнов CheckScheduler (--bench-scheduler):
+// TimingWheel против HeapDeadlineQueue (std::priority_queue) на одной и той же
+// последовательности. Время модельное, без сна: цикл планировщика берет
+// NextWakeupMs, снимает наступившие дедлайны и ставит каждый канал заново через
+// интервал проверки с разбросом; на каждое срабатывание еще один случайный канал
+// переносится (переход в быстрый режим, backoff). Меряется процессорное время
+// очереди, а не сон планировщика
+class SchedulerBenchmark {
+private:
+    size_t channels;
+    int simulatedSeconds;
+
+public:
+    SchedulerBenchmark(size_t channelCount, int seconds);
+
+    // backendsAgree = false - порядок срабатываний у backend разошелся
+    std::string RunComparison(bool& backendsAgree) const;
+};
+
+#endif // SCHEDULER_BENCHMARK_H
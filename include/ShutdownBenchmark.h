@@ -0,0 +1,46 @@
+#ifndef SHUTDOWN_BENCHMARK_H
+#define SHUTDOWN_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "Config.h"
+#include "MultiStreamMonitor.h"
+
+
+// Итог одной остановки
+struct ShutdownBenchmarkResult {
+    size_t channels;
+    std::string engine;
+    bool standInStarted;
+    size_t checksInFlight;      // Мониторы, начавшие проверку до остановки (ответа нет ни у кого)
+    double stopAllMs;           // Снаружи: вызов StopAll до возврата
+    ShutdownTimings timings;    // Изнутри StopAll по этапам
+
+    ShutdownBenchmarkResult() : channels(0), standInStarted(false), checksInFlight(0), stopAllMs(0.0) {}
+};
+
+
+// Время остановки (--bench-shutdown): N мониторов против StandInServer, который
+// держит каждый ответ дольше timeout, - все проверки висят в передаче. Остановка
+// запрашивается, как в --multi после WaitForShutdown (StopAll в основном потоке);
+// меряется время до прерывания проверок, до конца записи статистики (она включена,
+// файлы замера удаляются) и до возврата StopAll. Event loop и пул, списки
+// 100/1000/10000 не длиннее channels. twitch_base_url из конфига не используется
+class ShutdownBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t maxChannels;
+
+    // Своя подставка на прогон: зависшие ответы прошлого прогона не копятся
+    ShutdownBenchmarkResult Run(size_t channels, const std::string& engine) const;
+
+public:
+    ShutdownBenchmark(std::shared_ptr<Config> configInstance, size_t channelLimit);
+
+    // stoppedInTime = false - запись статистики не уложилась в shutdown_timeout_ms
+    // или подставка не запустилась
+    std::string RunComparison(bool& stoppedInTime) const;
+};
+
+#endif // SHUTDOWN_BENCHMARK_H
@@ -0,0 +1,55 @@
+#ifndef SHUTDOWN_COORDINATOR_H
+#define SHUTDOWN_COORDINATOR_H
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+
+// Единая точка остановки процесса. Signal handler только пишет байт
+// в self-pipe; остановку выполняет отдельный поток вне контекста сигнала:
+// вызывает обработчики и будит всех, кто ждет в WaitForShutdown.
+// Повторный сигнал во время остановки завершает процесс сразу.
+class ShutdownCoordinator {
+private:
+    std::mutex shutdownMutex;
+    std::condition_variable shutdownCondition;
+    std::atomic<bool> shutdownRequested;
+    std::vector<std::function<void()>> handlers;
+
+#ifndef _WIN32
+    int signalPipe[2];
+    std::thread signalThread;
+
+    static void OnSignal(int signal);
+    void SignalThreadFunction();
+#else
+    static void OnSignal(int signal);
+#endif
+
+    ShutdownCoordinator();
+
+public:
+    ~ShutdownCoordinator();
+
+    ShutdownCoordinator(const ShutdownCoordinator&) = delete;
+    ShutdownCoordinator& operator=(const ShutdownCoordinator&) = delete;
+
+    static ShutdownCoordinator& Instance();
+
+    // SIGINT/SIGTERM -> RequestShutdown
+    bool InstallSignalHandlers();
+
+    // Вызывается один раз, в потоке, запросившем остановку (не в signal handler)
+    void AddShutdownHandler(std::function<void()> handler);
+
+    void RequestShutdown();
+    bool IsShutdownRequested() const { return shutdownRequested.load(); }
+
+    void WaitForShutdown();
+};
+
+#endif // SHUTDOWN_COORDINATOR_H
@@ -0,0 +1,100 @@
+#ifndef STAND_IN_SERVER_H
+#define STAND_IN_SERVER_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+#ifdef _WIN32
+    typedef uintptr_t StandInSocket;  // SOCKET
+#else
+    typedef int StandInSocket;
+#endif
+
+
+// Что видела подставка с последнего ResetStats
+struct StandInStats {
+    unsigned long long requests;
+    unsigned long long mainPageRequests;  // "/" - лишние запросы HumanBehavior
+    unsigned long long headRequests;      // HEAD и Range - только к страницам каналов
+    unsigned long long rangeRequests;
+    unsigned long long stalled;           // Ответ задержан на stallMs
+    unsigned long long bodyBytes;         // Тел ушло в сокет (без заголовков)
+    unsigned long long connections;       // Принято соединений
+
+    StandInStats()
+        : requests(0), mainPageRequests(0), headRequests(0), rangeRequests(0), stalled(0), bodyBytes(0),
+          connections(0) {}
+};
+
+
+// Локальная подставка twitch.tv для замеров - в самом процессе, без внешних
+// скриптов: HTTP/1.1 с keep-alive на 127.0.0.1 и свободном порту, поток на
+// соединение. GET и HEAD страницы канала /<name> (MarkerBenchmark::MakePage,
+// live/offline по SetLive), ETag по состоянию, Range "bytes=0-N" - 206.
+// Доля запросов (SetStall) ждет stallMs до ответа - зависший сервер
+class StandInServer {
+private:
+    std::string livePage;
+    std::string offlinePage;
+    StandInSocket listenSocket;
+    int port;
+
+    std::atomic<bool> stopping;
+    std::thread acceptThread;
+    std::mutex connectionsMutex;
+    std::vector<std::thread> connectionThreads;
+    std::vector<StandInSocket> openSockets;
+
+    mutable std::mutex stateMutex;
+    std::unordered_map<std::string, bool> live;  // Нет в таблице - offline
+    double stallFraction;
+    int stallMs;
+    unsigned long long requestIndex;             // Для равномерной доли зависших
+    std::condition_variable stallWakeup;         // Stop будит зависшие ответы
+
+    std::atomic<unsigned long long> requests;
+    std::atomic<unsigned long long> mainPageRequests;
+    std::atomic<unsigned long long> headRequests;
+    std::atomic<unsigned long long> rangeRequests;
+    std::atomic<unsigned long long> stalled;
+    std::atomic<unsigned long long> bodyBytes;
+    std::atomic<unsigned long long> connections;
+
+    void AcceptLoop();
+    void Serve(StandInSocket client);
+    bool Respond(StandInSocket client, const std::string& request, bool& keepAlive);
+    bool ShouldStall();
+    void CloseSocket(StandInSocket socket);
+
+public:
+    explicit StandInServer(size_t pageBytes);
+    ~StandInServer();
+
+    StandInServer(const StandInServer&) = delete;
+    StandInServer& operator=(const StandInServer&) = delete;
+
+    // false - порт не открылся, замер запускать не на чем
+    bool Start();
+    void Stop();
+
+    // Для twitch_base_url: "http://127.0.0.1:<port>/"
+    std::string GetBaseUrl() const;
+
+    void SetLive(const std::string& channel, bool isLive);
+
+    // fraction запросов (0..1, равномерно по порядку прихода) ждут stallMs до ответа
+    void SetStall(double fraction, int delayMs);
+
+    StandInStats GetStats() const;
+    void ResetStats();
+};
+
+#endif // STAND_IN_SERVER_H
@@ -0,0 +1,46 @@
+#ifndef STARTUP_BENCHMARK_H
+#define STARTUP_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "Config.h"
+
+
+// Итог одного размера списка
+struct StartupBenchmarkResult {
+    size_t channels;
+    double startAllMs;         // Сам вызов StartAll
+    double warmupLastMs;       // Первая проверка последнего стримера, окно прогрева
+    double staggerLastMs;      // То же при прежних 500 мс на стримера
+    bool staggerMeasured;      // false - посчитано по построению, без прогона
+    bool allChecked;           // Все стримеры дождались первой проверки
+
+    StartupBenchmarkResult()
+        : channels(0), startAllMs(0.0), warmupLastMs(0.0), staggerLastMs(0.0),
+          staggerMeasured(false), allChecked(false) {}
+};
+
+
+// Время до первой проверки последнего стримера после StartAll (--bench-startup)
+// в зависимости от длины списка: окно прогрева startup_warmup_ms против прежнего
+// разноса по 500 мс на стримера. Прежний разнос воспроизводится тем же StartAll
+// с окном N * 500 мс (смещения совпадают: i * 500 мс); длиннее минуты он не
+// прогоняется, а считается по построению. Запросы - на twitch_base_url из конфига,
+// только локальная подставка
+class StartupBenchmark {
+private:
+    std::shared_ptr<Config> config;
+    size_t maxChannels;
+
+    // Время до первой проверки последнего стримера; allChecked - дождались ли
+    double MeasureLastFirstCheck(size_t channels, int warmupMs, double& startAllMs, bool& allChecked) const;
+
+public:
+    StartupBenchmark(std::shared_ptr<Config> configInstance, size_t channelLimit);
+
+    // twitch_base_url до вызова проверяет BenchmarkSupport::RequireLocalUrl
+    std::string RunComparison() const;
+};
+
+#endif // STARTUP_BENCHMARK_H
@@ -0,0 +1,35 @@
+#ifndef STATE_TABLE_BENCHMARK_H
+#define STATE_TABLE_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одной раскладки: лучший из проходов и проверочные суммы
+struct StateTableBenchmarkResult {
+    std::string layout;
+    double bestNsPerEntry;
+    double meanNsPerEntry;
+    size_t online;
+    size_t fastMode;
+
+    StateTableBenchmarkResult() : bestNsPerEntry(0.0), meanNsPerEntry(0.0), online(0), fastMode(0) {}
+};
+
+
+// Проход по горячему состоянию каналов (--bench-state-table): подсчет "в эфире" и
+// "в быстром режиме", как строка Online / fast в PrintStatus. Три раскладки:
+// объекты монитора по указателям из списка (как было), те же объекты подряд
+// в одном массиве (AoS) и ChannelStateTable (SoA)
+class StateTableBenchmark {
+private:
+    size_t entries;
+    int rounds;
+
+public:
+    StateTableBenchmark(size_t entryCount, int roundCount);
+
+    std::string RunComparison() const;
+};
+
+#endif // STATE_TABLE_BENCHMARK_H
@@ -34,9 +34,22 @@ private:
     long long fastestCheck;
     long long slowestCheck;
     
-    // Сессии стримов
-    std::vector<StreamSession> sessions;
+    // Трафик: сколько байт пришло и сколько понадобилось для вердикта
+    long long totalBytesReceived;
+    long long totalBytesNeeded;
+    int earlyAborts;
+    int probeChecks;          // Проверки с probe-фазой (use_head_request)
+    int fullFetchesSkipped;   // Из них без полной загрузки страницы
+    
+    // Сессии стримов. Холодные данные: после ReleaseSessions читаются из файла по запросу
+    mutable std::vector<StreamSession> sessions;
+    mutable bool sessionsLoaded;
+    bool sessionsSaved;  // Файл содержит все сессии из памяти
     long long currentSessionStart;
+    long long firstSeen;  // Начало наблюдений за каналом (Unix time)
+    
+    // Есть изменения, не записанные в файл (деструктор пишет только их)
+    bool dirty;
     
     // Ограничение размера истории
     static const size_t MAX_SESSIONS = 1000;
@@ -44,6 +57,11 @@ private:
     // Сохранение/загрузка статистики
     bool SaveToFile();
     bool LoadFromFile();
+    void LoadSessions() const;  // Под statsMutex
+    
+    // Поле объекта сессии; duration - последнее, по нему сессия добавляется в out
+    static void ParseSessionLine(const std::string& line, StreamSession& session,
+                                 std::vector<StreamSession>& out);
     
     // Очистка старых сессий при превышении лимита
     void TrimOldSessions();
@@ -60,6 +78,8 @@ public:
     
     // Обновление счетчиков (thread-safe)
     void RecordCheck(long long checkTimeMs);
+    void RecordTransfer(long long bytesReceived, long long bytesNeeded, bool abortedEarly);
+    void RecordProbe(bool fullFetchSkipped);
     void RecordStreamOnline();
     void RecordStreamOffline();
     
@@ -70,6 +90,11 @@ public:
     long long GetAverageCheckTime() const;
     long long GetFastestCheck() const;
     long long GetSlowestCheck() const;
+    long long GetTotalBytesReceived() const;
+    long long GetTotalBytesNeeded() const;
+    int GetEarlyAborts() const;
+    int GetProbeChecks() const;
+    int GetFullFetchesSkipped() const;
     
     // Статистика по стримам (thread-safe)
     int GetTotalStreams() const;
@@ -77,6 +102,8 @@ public:
     long long GetAverageStreamDuration() const;
     long long GetLongestStream() const;
     long long GetShortestStream() const;
+    std::vector<StreamSession> GetSessions() const;
+    long long GetFirstSeen() const;
     
     // Вывод статистики
     void PrintSummary() const;
@@ -85,8 +112,11 @@ public:
     // Сброс статистики
     void Reset();
     
-    // Принудительное сохранение
+    // Принудительное сохранение (thread-safe)
     void Save();
+    
+    // Выгрузить историю сессий (уже записанную в файл) до следующего обращения к ней
+    void ReleaseSessions();
 };
 
 #endif // STATISTICS_H
\ No newline at end of file
@@ -4,38 +4,70 @@
 #include <string>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include "Config.h"
 #include "Logger.h"
 #include "Notification.h"
 #include "Statistics.h"
 #include "WebScraper.h"
 #include "BrowserController.h"
+#include "TaskExecutor.h"
+#include "PollPredictor.h"
+#include "FailurePolicy.h"
+#include "MonitorContext.h"
+#include "ChannelStateTable.h"
+#include "StreamerNames.h"
 
 
-class StreamMonitor {
+class StreamMonitor : public std::enable_shared_from_this<StreamMonitor> {
 private:
-    std::string streamerName;
-    std::atomic<bool> wasOnlineBefore;
-    std::atomic<bool> shouldStop;  // Для graceful shutdown
-    long long lastOnlineTimestamp;
+    // Имя и URL - в StreamerNameTable контекста, здесь только номер
+    StreamerId streamerId;
+    const StreamerRecord& streamerRecord;
+    const std::string& streamerName;
+    
+    // Горячее состояние (в эфире, остановлен, последний эфир, интервалы) - в общей
+    // таблице MonitorContext по номеру stateSlot, а не в полях монитора
+    std::shared_ptr<ChannelStateTable> stateTable;
+    uint32_t stateSlot;
+    
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;  // Будит паузы StartMonitoring сразу при Stop()
+    std::atomic<int> checkCount;  // Читают замеры из других потоков
+    std::chrono::steady_clock::time_point asyncCheckStart;
     
     // Зависимости (Dependency Injection)
     std::shared_ptr<Logger> logger;
-    std::unique_ptr<Config> config;
+    std::shared_ptr<MonitorContext> context;  // Конфиг и лог - общие на процесс
     std::unique_ptr<Notification> notification;
     std::unique_ptr<Statistics> statistics;
     std::unique_ptr<WebScraper> webScraper;
     std::unique_ptr<BrowserController> browserController;
     
-    // Настройки из конфига
-    int checkInterval;
-    int checkIntervalFast;
-    int fastModeDuration;
+    // Настройки из конфига (интервалы - в stateTable)
     bool enableNotifications;
     bool enableStatistics;
     
-    // Вычисление текущего интервала проверки
-    int GetCurrentCheckInterval();
+    // poll_strategy=predictive: интервал offline-канала по недельному профилю стартов
+    bool predictivePolling;
+    std::unique_ptr<PollPredictor> pollPredictor;
+    
+    // Проверка без вердикта: быстрый повтор, backoff хоста или circuit breaker
+    std::unique_ptr<FailurePolicy> failurePolicy;
+    
+    // Пул для событий смены статуса (уведомление, браузер, запись сессии).
+    // События одного монитора выполняются строго по очереди.
+    std::shared_ptr<TaskExecutor> eventExecutor;
+    std::mutex eventMutex;
+    std::deque<std::function<void()>> pendingEvents;
+    bool eventDrainQueued;
+    
+    // Пауза, прерываемая Stop(). true = монитор остановлен
+    bool WaitForStop(int timeoutMs);
     
     // Получение Unix timestamp
     long long GetUnixTimestamp() const;
@@ -43,11 +75,28 @@ private:
     // Обработка изменения статуса
     void HandleStreamOnline();
     void HandleStreamOffline();
+    
+    // Выполнить событие в eventExecutor (или сразу, если пула нет)
+    void DispatchEvent(std::function<void()> event);
+    void DrainEvents();
+    
+    // Реакция на результат одной проверки (общая для потока и event loop)
+    void ProcessCheckResult(bool isCurrentlyOnline, long long checkDuration);
+    
+    // Проверка без вердикта: false, если ошибка ушла в failurePolicy
+    bool AcceptVerdict();
 
 
 public:
+    // Одиночный монитор: свой контекст (конфиг из configPath, logs/stream_monitor.log)
     StreamMonitor(const std::string& streamer, 
                   const std::string& configPath = "config.ini");
+    
+    // Монитор в --multi: общий контекст, конструктор без файлов и процессов (кроме stats/)
+    StreamMonitor(const std::string& streamer, std::shared_ptr<MonitorContext> contextInstance);
+    
+    // То же для имени, уже интернированного в таблицу контекста (пакет InternAll)
+    StreamMonitor(StreamerId streamer, std::shared_ptr<MonitorContext> contextInstance);
     ~StreamMonitor();
     
     // Запрет копирования
@@ -57,15 +106,69 @@ public:
     // Основной метод мониторинга
     void StartMonitoring();
     
-    // Graceful shutdown
+    // Одна блокирующая проверка (цикл StartMonitoring и пул CheckScheduler)
+    void RunCheckOnce();
+    
+    // Асинхронная проверка для CurlMultiEngine (вызывается из event loop).
+    // BeginAsyncCheck: false - проверку не начинаем (backoff/breaker). Handle первой
+    // фазы дает StartAsyncTransfer, когда лимитер пустил запрос.
+    // CompleteAsyncCheck возвращает handle следующей фазы или nullptr
+    bool BeginAsyncCheck();
+    CURL* StartAsyncTransfer() { return webScraper->StartTransfer(); }
+    CURL* CompleteAsyncCheck(CURLcode result, bool fromHedge = false);
+    
+    // Hedge текущей передачи (hedge_requests): задержка в мс или -1, и второй handle
+    // той же страницы на новом соединении. Побеждает первый ответ, другой отменяется
+    int GetHedgeDelayMs() const { return webScraper->GetHedgeDelayMs(); }
+    CURL* BeginHedge() { return webScraper->PrepareHedge(); }
+    unsigned long long GetHedgesSent() const { return webScraper->GetHedgesSent(); }
+    unsigned long long GetHedgesWon() const { return webScraper->GetHedgesWon(); }
+    
+    // Вынести события смены статуса в пул (только для монитора под shared_ptr)
+    void SetEventExecutor(std::shared_ptr<TaskExecutor> executor) { eventExecutor = executor; }
+    
+    // Общий лимитер запросов --multi (одиночный монитор шлет по одному запросу - без лимитера)
+    void SetRateLimiter(std::shared_ptr<RateLimiter> limiter) { webScraper->SetRateLimiter(limiter); }
+    
+    // Хост следующей передачи BeginAsyncCheck/CompleteAsyncCheck (для лимитера)
+    std::string GetRequestHost() const { return webScraper->GetRequestHost(); }
+    
+    // Лимитер не пропустил асинхронную проверку: бросить ее без вердикта
+    void AbortAsyncCheck();
+    
+    // Общий бюджет запросов всех мониторов (по умолчанию - из MonitorContext)
+    void SetPollBudget(std::shared_ptr<PollBudget> budget) { pollPredictor->SetBudget(budget); }
+    
+    // Общий backoff хостов всех мониторов (по умолчанию - из MonitorContext)
+    void SetHostBackoff(std::shared_ptr<HostBackoff> backoff) { failurePolicy->SetHostBackoff(backoff); }
+    
+    // Сколько проверок начато
+    int GetCheckCount() const { return checkCount.load(std::memory_order_relaxed); }
+    
+    // Вычисление текущего интервала проверки
+    int GetCurrentCheckInterval();
+    
+    // Пауза до повтора после ошибки (мс) вместо интервала, -1 = обычный интервал
+    int GetRetryDelayMs() const { return failurePolicy->GetRetryDelayMs(); }
+    const FailurePolicy& GetFailurePolicy() const { return *failurePolicy; }
+    
+    // Пауза HumanBehavior перед следующей проверкой (мс, поверх интервала)
+    int GetPacingDelayMs() const { return webScraper->GetPacingDelayMs(); }
+    
+    // Graceful shutdown: будит паузы и прерывает текущую передачу
     void Stop();
-    bool IsStopped() const { return shouldStop.load(); }
+    bool IsStopped() const { return stateTable->HasFlag(stateSlot, ChannelStateTable::STOPPED); }
+    bool IsOnline() const { return stateTable->HasFlag(stateSlot, ChannelStateTable::ONLINE); }
+    
+    // Номер канала в таблице горячего состояния MonitorContext
+    uint32_t GetStateSlot() const { return stateSlot; }
     
     // Получение текущей конфигурации
-    const Config& GetConfig() const { return *config; }
+    const Config& GetConfig() const { return context->GetConfig(); }
     
     // Получение статистики
     const Statistics* GetStatistics() const { return statistics.get(); }
+    void SaveStatistics();
     
     // Управление уведомлениями
     void EnableNotifications(bool enable);
@@ -77,7 +180,8 @@ public:
     void ShowStatistics() const;
     
     // Получение имени стримера
-    std::string GetStreamerName() const { return streamerName; }
+    const std::string& GetStreamerName() const { return streamerName; }
+    StreamerId GetStreamerId() const { return streamerId; }
 };
 
 #endif // STREAM_MONITOR_H
\ No newline at end of file
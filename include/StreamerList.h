@@ -0,0 +1,54 @@
+#ifndef STREAMER_LIST_H
+#define STREAMER_LIST_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+
+// Файл списка стримеров целиком в памяти: mmap (POSIX) или одно чтение (Windows).
+// Имена из StreamerList::Parse - string_view в этот буфер, живут вместе с ним
+class StreamerListFile {
+private:
+    const char* data;
+    size_t size;
+    bool mapped;
+    std::string buffer;  // Без mmap
+
+public:
+    explicit StreamerListFile(const std::string& path);
+    ~StreamerListFile();
+
+    StreamerListFile(const StreamerListFile&) = delete;
+    StreamerListFile& operator=(const StreamerListFile&) = delete;
+
+    bool IsOpen() const { return data != nullptr; }
+    std::string_view GetText() const { return std::string_view(data ? data : "", size); }
+};
+
+
+// Отброшенная строка списка
+struct StreamerListReject {
+    size_t line;  // С 1
+    std::string_view text;
+    bool duplicate;  // false - невалидное имя
+};
+
+
+struct ParsedStreamerList {
+    std::vector<std::string_view> names;  // Уникальные, в порядке файла
+    std::vector<StreamerListReject> rejected;
+    size_t lines;
+
+    ParsedStreamerList() : lines(0) {}
+};
+
+
+namespace StreamerList {
+    // Разбор: строки режутся и проверяются кусками в threads потоках (0 - по числу ядер),
+    // затем одна проходка хэш-множеством убирает повторы. Пустые строки и # пропускаются
+    ParsedStreamerList Parse(std::string_view text, unsigned threads = 0);
+}
+
+#endif // STREAMER_LIST_H
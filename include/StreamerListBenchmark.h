@@ -0,0 +1,37 @@
+#ifndef STREAMER_LIST_BENCHMARK_H
+#define STREAMER_LIST_BENCHMARK_H
+
+#include <string>
+#include <cstddef>
+
+
+// Итог одного способа загрузки: лучший из прогонов
+struct StreamerListBenchmarkResult {
+    std::string method;
+    double bestMs;
+    size_t names;
+    size_t rejected;
+
+    StreamerListBenchmarkResult() : bestMs(0.0), names(0), rejected(0) {}
+};
+
+
+// Загрузка большого streamers.txt (--bench-streamer-list): прежний путь
+// (getline + Trim + проверка + set строк), StreamerListFile + StreamerList::Parse
+// в одном и в нескольких потоках и интернирование результата в StreamerNameTable.
+// Файл генерируется во временном каталоге: ~2% невалидных строк, ~5% повторов,
+// комментарии и CRLF. Отдельно - весь MultiStreamMonitor::LoadStreamersFromFile
+// с созданием мониторов на первых FULL_LOAD_LINES строках: на миллионе строк
+// мониторы не помещаются в память
+class StreamerListBenchmark {
+private:
+    size_t lines;
+    unsigned threads;
+
+public:
+    StreamerListBenchmark(size_t lineCount, unsigned threadCount);
+
+    std::string RunComparison() const;
+};
+
+#endif // STREAMER_LIST_BENCHMARK_H
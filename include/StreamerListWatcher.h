@@ -0,0 +1,58 @@
+#ifndef STREAMER_LIST_WATCHER_H
+#define STREAMER_LIST_WATCHER_H
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "Logger.h"
+
+
+// Вызывается из потока наблюдателя, когда файл списка переписан
+using ListChangedCallback = std::function<void()>;
+
+
+// Следит за файлом списка стримеров (streamers.txt) и сообщает об изменениях.
+// Linux: inotify на каталог файла - редакторы часто сохраняют через rename,
+// и watch на сам файл после этого молчит. Остальные платформы - опрос mtime/размера.
+// Серия событий одного сохранения схлопывается в один вызов (debounce)
+class StreamerListWatcher {
+private:
+    std::shared_ptr<Logger> logger;
+    std::string filePath;
+    std::string directory;
+    std::string fileName;
+    ListChangedCallback onChange;
+    int debounceMs;
+
+    std::thread watchThread;
+    std::atomic<bool> running;
+
+#ifdef __linux__
+    int inotifyFd;
+    int wakeupFd;  // eventfd: Stop() будит poll
+#else
+    std::mutex waitMutex;
+    std::condition_variable wakeup;
+#endif
+
+    void WatchThreadFunction();
+
+public:
+    StreamerListWatcher(std::shared_ptr<Logger> loggerInstance, const std::string& path,
+                        ListChangedCallback onListChanged, int debounceMilliseconds);
+    ~StreamerListWatcher();
+
+    StreamerListWatcher(const StreamerListWatcher&) = delete;
+    StreamerListWatcher& operator=(const StreamerListWatcher&) = delete;
+
+    bool Start();
+    void Stop();  // Ждет текущий onChange
+
+    const std::string& GetFilePath() const { return filePath; }
+};
+
+#endif // STREAMER_LIST_WATCHER_H
@@ -0,0 +1,93 @@
+#ifndef STREAMER_NAMES_H
+#define STREAMER_NAMES_H
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+// Компактный номер стримера в StreamerNameTable
+using StreamerId = uint32_t;
+
+
+// Строки канала, собранные один раз при интернировании. Путь статистики не
+// хранится: он нужен только при создании монитора (StatsPathFor)
+struct StreamerRecord {
+    std::string name;
+    const char* pageUrl;  // twitch_base_url + имя, в блоках URL таблицы
+
+    StreamerRecord() : pageUrl(nullptr) {}
+};
+
+
+// Таблица имен стримеров: имя -> StreamerId хэшем за O(1), по номеру - запись
+// с готовым URL страницы. Номер не меняется и не переиспользуется: то же имя
+// после удаления и нового добавления получает прежний номер. Записи и URL
+// лежат блоками и не переезжают, поэтому ссылка из Get
+// действует, пока жива таблица, а Get идет без блокировок (THREAD-SAFE)
+class StreamerNameTable {
+public:
+    static const size_t CHUNK_SIZE = 1024;
+    static const size_t MAX_CHUNKS = 4096;  // До 4M имен
+    static const size_t INITIAL_SLOTS = 1024;
+    static const size_t URL_BLOCK_SIZE = 256 * 1024;
+
+private:
+    struct Chunk {
+        StreamerRecord records[CHUNK_SIZE];
+    };
+
+    std::string baseUrl;
+
+    std::atomic<Chunk*> chunks[MAX_CHUNKS];
+    std::atomic<size_t> count;
+
+    // URL страниц подряд в больших блоках, без выделения на каждое имя. Под indexMutex
+    std::vector<std::unique_ptr<char[]>> urlBlocks;
+    char* urlCursor;
+    size_t urlFree;
+
+    // Индекс с открытой адресацией, заполнен не больше чем наполовину. Ячейка:
+    // старшие 32 бита хэша имени и StreamerId + 1 (0 - пусто). Узлов в куче нет
+    mutable std::mutex indexMutex;
+    std::vector<uint64_t> slots;
+
+    // Под indexMutex
+    bool FindLocked(std::string_view name, uint64_t hash, size_t& position) const;
+    StreamerId InternLocked(std::string_view name);
+    void Reserve(size_t names);
+    const char* StorePageUrl(std::string_view name);
+
+public:
+    explicit StreamerNameTable(const std::string& pageBaseUrl);
+    ~StreamerNameTable();
+
+    StreamerNameTable(const StreamerNameTable&) = delete;
+    StreamerNameTable& operator=(const StreamerNameTable&) = delete;
+
+    // Номер имени, новый - если имени еще не было. Имя не проверяется:
+    // валидирует вызывающий. std::length_error при переполнении
+    StreamerId Intern(std::string_view name);
+
+    // Весь список под одной блокировкой и с одним резервом индекса; ids[i] - номер names[i]
+    void InternAll(const std::vector<std::string_view>& names, std::vector<StreamerId>& ids);
+
+    // false - имя не интернировано
+    bool Find(std::string_view name, StreamerId& id) const;
+
+    // id - только полученный из Intern/Find этой таблицы
+    const StreamerRecord& Get(StreamerId id) const {
+        return chunks[id / CHUNK_SIZE].load(std::memory_order_acquire)->records[id % CHUNK_SIZE];
+    }
+
+    size_t Size() const { return count.load(std::memory_order_acquire); }
+
+    static std::string StatsPathFor(std::string_view name);
+};
+
+#endif // STREAMER_NAMES_H
@@ -2,6 +2,7 @@
 #define STRING_UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <regex>
 
@@ -14,7 +15,7 @@ namespace StringUtils {
     std::string ToLower(const std::string& str);
     
     // Проверка валидности имени стримера
-    bool IsValidStreamerName(const std::string& name);
+    bool IsValidStreamerName(std::string_view name);
     
     // Экранирование для shell команд
     std::string EscapeShellArg(const std::string& arg);
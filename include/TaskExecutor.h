@@ -0,0 +1,94 @@
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
+#include "Logger.h"
+
+
+// Короткая задача пула (завершение проверки, разбор, статистика, события)
+using ExecutorTask = std::function<void()>;
+
+
+// Метрики одного worker
+struct ExecutorWorkerStats {
+    size_t queueDepth;
+    unsigned long long executed;
+    unsigned long long steals;  // Задач, украденных этим worker у других
+
+    ExecutorWorkerStats() : queueDepth(0), executed(0), steals(0) {}
+};
+
+
+struct ExecutorStats {
+    std::vector<ExecutorWorkerStats> workers;
+    unsigned long long submitted;
+    unsigned long long executed;
+    unsigned long long steals;
+
+    ExecutorStats() : submitted(0), executed(0), steals(0) {}
+};
+
+
+// Пул с work stealing: у каждого worker своя очередь. Владелец берет
+// с конца (LIFO, теплый кэш), простаивающий worker крадет с начала
+// очереди случайной жертвы. Задачи извне раздаются по кругу.
+class TaskExecutor {
+private:
+    struct Worker {
+        std::mutex queueMutex;
+        std::deque<ExecutorTask> queue;
+        std::atomic<unsigned long long> executed;
+        std::atomic<unsigned long long> steals;
+        std::thread thread;
+
+        Worker() : executed(0), steals(0) {}
+    };
+
+    std::shared_ptr<Logger> logger;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> running;
+
+    // Сон простаивающих worker: pendingTasks считает задачи во всех очередях
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+    std::atomic<size_t> pendingTasks;
+
+    std::atomic<size_t> nextWorker;  // Round-robin для задач извне
+    std::atomic<unsigned long long> submittedCount;
+
+    void WorkerThreadFunction(size_t index);
+    bool PopLocal(size_t index, ExecutorTask& task);
+    bool Steal(size_t thief, std::mt19937& generator, ExecutorTask& task);
+    void RunTask(Worker& worker, ExecutorTask& task);
+
+public:
+    // threadCount = 0: по числу ядер
+    TaskExecutor(std::shared_ptr<Logger> loggerInstance, size_t threadCount);
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    bool Start();
+    void Stop();  // Останавливает worker, оставшиеся задачи выполняет в вызывающем потоке
+    bool IsRunning() const { return running.load(); }
+
+    // Thread-safe. Из worker этого пула - в его собственную очередь.
+    // false, если пул остановлен (задача не выполнится)
+    bool Submit(ExecutorTask task);
+
+    size_t GetWorkerCount() const { return workers.size(); }
+    ExecutorStats GetStats() const;
+    std::string GetStatsSummary() const;
+};
+
+#endif // TASK_EXECUTOR_H
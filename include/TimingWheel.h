@@ -0,0 +1,64 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "DeadlineQueue.h"
+
+
+// Иерархическое колесо таймеров: вставка, отмена и перенос за O(1).
+// Ближнее колесо - 256 слотов по 1 мс, дальше 4 уровня по 64 слота
+// (256 мс, 16 с, ~17 мин, ~18 ч на слот); покрывает ~49 суток.
+// Записи дальних уровней спускаются ниже, когда ближнее колесо делает оборот.
+class TimingWheel : public DeadlineQueue {
+private:
+    static const int NEAR_BITS = 8;
+    static const int LEVEL_BITS = 6;
+    static const int LEVELS = 4;  // Уровней над ближним колесом
+    static const int NEAR_SIZE = 1 << NEAR_BITS;
+    static const int LEVEL_SIZE = 1 << LEVEL_BITS;
+    static const uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        uint64_t taskId;
+        int64_t deadlineMs;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t* head;  // Список (слот), в котором сейчас стоит узел
+    };
+
+    std::vector<Node> nodes;             // Пул узлов, индексы стабильны
+    std::vector<uint32_t> freeNodes;
+    std::unordered_map<uint64_t, uint32_t> nodeByTask;
+
+    uint32_t nearSlots[NEAR_SIZE];
+    uint32_t levelSlots[LEVELS][LEVEL_SIZE];
+    uint32_t overdue;                    // Дедлайн уже прошел на момент вставки
+
+    int64_t currentTick;                 // Последняя обработанная мс
+    size_t higherCount;                  // Узлов на уровнях над ближним колесом
+
+    void Link(uint32_t index, uint32_t* head);
+    void Unlink(uint32_t index);
+    void Place(uint32_t index);          // Выбрать слот по дедлайну
+    void Cascade(int level, int slot);
+    void MoveExpired(uint32_t* head, std::vector<ExpiredDeadline>& out);
+    void Release(uint32_t index);
+
+public:
+    explicit TimingWheel(int64_t startMs = 0);
+
+    // Слоты хранят указатели на собственные массивы - не копируем
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    void Schedule(uint64_t taskId, int64_t deadlineMs) override;
+    bool Cancel(uint64_t taskId) override;
+    void PopExpired(int64_t nowMs, std::vector<ExpiredDeadline>& out) override;
+    int64_t NextWakeupMs() override;
+    size_t Size() const override { return nodeByTask.size(); }
+    const char* Name() const override { return "wheel"; }
+};
+
+#endif // TIMING_WHEEL_H
@@ -3,10 +3,20 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
 #include <curl/curl.h>
 #include "Logger.h"
 #include "Config.h"
 #include "HumanBehavior.h"
+#include "MarkerMatcher.h"
+#include "LatencyWindow.h"
+#include "CurlShare.h"
+#include "RateLimiter.h"
+#include "FailurePolicy.h"
+#include "MonitorContext.h"
 
 
 // RAII wrapper для CURL handle
@@ -16,6 +26,7 @@ private:
 
 public:
     CurlHandle();
+    explicit CurlHandle(CURL* adopted);  // Готовый handle (curl_easy_duphandle), nullptr = пустой
     ~CurlHandle();
     
     CurlHandle(const CurlHandle&) = delete;
@@ -30,9 +41,49 @@ public:
 
 
 struct CallbackData {
-    std::string* buffer;
-    bool* foundMarker;
+    MarkerMatcher* matcher;
     size_t maxSize;
+    bool abortOnVerdict;   // Обрывать передачу, как только вердикт известен
+    size_t bytesReceived;  // Все байты тела, пришедшие в callback
+    bool aborted;          // Передачу оборвали мы сами (не ошибка)
+};
+
+
+// Сколько байт пришло и сколько реально понадобилось для вердикта
+struct TransferStats {
+    size_t bytesReceived;
+    size_t bytesNeeded;
+    bool abortedEarly;
+    bool probed;            // Была фаза probe (use_head_request)
+    bool fullFetchSkipped;  // Probe совпал с offline-отпечатком, страницу не качали
+    
+    TransferStats() : bytesReceived(0), bytesNeeded(0), abortedEarly(false),
+                      probed(false), fullFetchSkipped(false) {}
+};
+
+
+// Отпечаток ответа для двухфазной проверки: заголовки + хэш начала тела
+struct ResponseFingerprint {
+    long httpCode;
+    std::string contentLength;
+    std::string etag;
+    std::string lastModified;
+    uint64_t bodyHash;  // FNV-1a первых probe_range_bytes байт
+    size_t bodyBytes;
+    
+    ResponseFingerprint() : httpCode(0), bodyHash(0), bodyBytes(0) {}
+    
+    void Clear();
+    bool IsUsable() const;  // Есть хоть что-то, по чему можно сравнивать
+    bool Matches(const ResponseFingerprint& other) const;
+    std::string ToString() const;
+};
+
+
+struct ProbeCallbackData {
+    ResponseFingerprint* fingerprint;
+    size_t limit;   // Сколько байт тела хэшируем (сервер может проигнорировать Range)
+    bool aborted;
 };
 
 
@@ -40,33 +91,173 @@ struct CallbackData {
 class WebScraper {
 private:
     std::shared_ptr<Logger> logger;
-    CurlHandle curlHandle;
+    std::shared_ptr<MonitorContext> context;  // Конфиг, seed и варианты заголовков - общие
+    std::shared_ptr<CurlShare> curlShare;  // Объявлен до curlHandle: переживает easy handle
+    CurlHandle curlHandle;  // memory_budget: только на время проверки, иначе - на весь срок
+    bool memoryBudget;
     std::unique_ptr<HumanBehavior> humanBehavior;
     
     size_t maxHtmlSize;
     int timeout;
     int connectTimeout;
     bool useHttp2;
+    bool http2Multiplex;  // PIPEWAIT: ждать свободный stream вместо нового соединения
     int dnsCacheTimeout;
     bool sslVerifyPeer;
     bool sslVerifyHost;
+    bool abortOnVerdict;
+    bool shareConnections;
+    std::shared_ptr<StreamerNameTable> streamerNames;  // URL страницы - готовый, по StreamerId
+    
+    // Двухфазная проверка (use_head_request)
+    bool useHeadRequest;
+    int probeRangeBytes;   // 0 = HEAD, иначе GET Range: bytes=0..N-1
+    int probeFullEvery;    // Принудительная полная загрузка после N пропусков подряд
+    ResponseFingerprint offlineFingerprint;
+    bool hasOfflineFingerprint;
+    int probeSkipsInRow;
+    bool lastVerdictOnline;
     
     int requestCounter;
     
+    // Состояние текущего запроса (живет до завершения передачи)
+    MarkerMatcher pageMatcher;
+    CallbackData callbackData;
+    TransferStats lastTransfer;
+    ResponseFingerprint probeFingerprint;
+    ProbeCallbackData probeData;
+    const char* requestUrl;       // pageUrl текущего стримера из StreamerNameTable
+    const char* currentUrl;       // URL, выставленный в handle для текущей фазы
+    std::string probeRange;       // "0-N" для probe_range_bytes, собирается один раз
+    
+    bool tlsSessionResumed;  // Выставляет debug callback CurlShare
+    
+    // Асинхронная проверка: текущая фаза и итог
+    enum class CheckPhase { EXTRA, PROBE, FULL };
+    CheckPhase currentPhase;
+    bool checkVerdict;
+    
+    // Пауза перед следующим запросом (выдерживает планировщик, не WebScraper)
+    int pacingDelayMs;
+    bool extraRequestDue;  // Следующая проверка начнется с запроса к главной странице
+    
+    std::atomic<bool> cancelRequested;  // Прервать текущую и все следующие передачи
+    
+    // Блокирующие передачи идут через свой curl_multi: Cancel() будит
+    // curl_multi_poll сразу, а не на следующем тике progress callback
+    CURLM* blockingMulti;
+    std::mutex blockingMultiMutex;
+    
+    // Общий лимитер запросов (--multi). Блокирующая передача ждет разрешения в PerformBlocking
+    std::shared_ptr<RateLimiter> rateLimiter;
+    std::atomic<uint64_t> limiterTicket;  // Ждущий запрос, для Cancel()
+    bool checkDeferred;                   // Лимитер не дал разрешения - проверка пропущена
+    
+    // Почему последняя проверка осталась без вердикта (NONE - вердикт есть)
+    FailureClass lastFailure;
+    std::string pageHost;  // Хост страниц каналов (twitch_base_url), ключ backoff
+    std::string mainPageUrl;  // Корень сервера twitch_base_url - для доп. запроса к главной
+    
+    // Hedging (hedge_requests): страница не пришла за p95 задержки канала - второй запрос
+    // на новом соединении, вердикт дает первый ответ. Таймаут передачи - по тем же замерам
+    bool hedgeRequests;
+    bool adaptiveTimeout;
+    LatencyWindow pageLatency;  // Полные загрузки страницы этого канала (мс)
+    int hedgeDelayMs;           // Для текущей проверки, -1 = без hedge
+    long transferTimeoutMs;     // CURLOPT_TIMEOUT_MS текущей проверки
+    CurlHandle hedgeHandle;
+    std::unique_ptr<MarkerMatcher> hedgeMatcher;
+    CallbackData hedgeCallbackData;
+    bool hedgeWon;              // Страницу текущей проверки дал hedge-запрос
+    std::atomic<unsigned long long> hedgesSent;
+    std::atomic<unsigned long long> hedgesWon;
+    
     static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
+    static size_t ProbeWriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
+    static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, void* userp);
     
     void ConfigureCurlWithHumanHeaders();
-    std::string DownloadPageHtml(const std::string& streamerName);
-    bool ParseStreamStatus(const std::string& html);
-    void MaybePerformExtraRequest(const std::string& streamerName);
+    bool AcquireHandle();          // memory_budget: handle и его настройки - в начале проверки
+    void ReleaseCheckResources();  // memory_budget: handle, multi и хвост страницы - после вердикта
+    void ApplyRequestHeaders();  // Случайный из общих вариантов MonitorContext
+    void SetTargetStreamer(StreamerId streamerId);
+    void PrepareRequest();
+    bool FinishRequest(CURLcode result);
+    
+    // Probe-фаза: true = страница не изменилась с последнего offline
+    bool ShouldProbe() const;
+    void PrepareProbe();
+    bool FinishProbe(CURLcode result);
+    void ResetProbeOptions();
+    void RememberVerdict(bool downloaded, bool isOnline);
+    void RecordConnectionUse(CURL* handle);  // handle - тот, что дал ответ
+    CURLcode PerformBlocking(bool allowHedge = false);  // curl_easy_perform, прерываемый Cancel()
+    bool DeferCheck();           // Проверку снял лимитер: без вердикта, статус прежний
+    bool RunBlockingCheck(StreamerId streamerId);  // Тело CheckStreamStatus
+    bool DownloadPageHtml();
+    bool EvaluatePage(bool downloaded);
+    bool ParseStreamStatus();
+    void PrepareExtraRequest();
+    void FinishExtraRequest();
+    void StartPageCheck();
+    void PlanPacing();
+    void PlanTransferTimeouts();  // hedgeDelayMs и таймаут на проверку по pageLatency
+    void AdoptHedgeResult();      // Страница hedge-запроса становится результатом проверки
 
 public:
-    WebScraper(std::shared_ptr<Logger> loggerInstance, const Config& config);
+    explicit WebScraper(std::shared_ptr<MonitorContext> contextInstance);
     ~WebScraper();
     
     // Основной метод: проверка статуса через скрапинг
-    bool CheckStreamStatus(const std::string& streamerName);
-    bool IsInitialized() const { return curlHandle.IsValid(); }
+    bool CheckStreamStatus(StreamerId streamerId);
+    
+    // Неблокирующий режим для curl_multi: BeginCheck выбирает первую фазу и ее URL
+    // (хост для лимитера), StartTransfer готовит под нее handle - в memory_budget
+    // он создается только тогда, когда лимитер пустил запрос. ContinueCheck разбирает
+    // результат и возвращает handle следующей фазы (или nullptr, когда вердикт
+    // готов - см. GetCheckVerdict)
+    void BeginCheck(StreamerId streamerId);
+    CURL* StartTransfer();
+    CURL* ContinueCheck(CURLcode result, bool fromHedge = false);
+    bool GetCheckVerdict() const { return checkVerdict; }
+    
+    // Hedge асинхронной проверки: через сколько мс после старта текущей передачи
+    // слать второй запрос (-1 = не слать) и handle для него
+    int GetHedgeDelayMs() const;
+    CURL* PrepareHedge();
+    
+    // Ответ сервера получен (в т.ч. оборван нами по готовому вердикту)
+    static bool IsResponse(CURLcode result);
+    
+    unsigned long long GetHedgesSent() const { return hedgesSent.load(); }
+    unsigned long long GetHedgesWon() const { return hedgesWon.load(); }
+    
+    // Бросить начатую асинхронную проверку, не отправив handle (отказ лимитера)
+    void AbortCheck();
+    
+    // Лимитер для блокирующих проверок; хост текущего запроса - для асинхронных
+    void SetRateLimiter(std::shared_ptr<RateLimiter> limiter) { rateLimiter = limiter; }
+    std::string GetRequestHost() const { return RateLimiter::HostOf(currentUrl); }
+    
+    // Последнюю CheckStreamStatus снял лимитер: вердикта нет
+    bool WasCheckDeferred() const { return checkDeferred; }
+    
+    // Класс ошибки последней проверки: при != NONE вердикт не годится
+    FailureClass GetLastFailure() const { return lastFailure; }
+    const std::string& GetPageHost() const { return pageHost; }
+    
+    // Сколько мс планировщик должен выждать перед следующей проверкой
+    // (имитация загрузки страницы и раздумья, распределения HumanBehavior)
+    int GetPacingDelayMs() const { return pacingDelayMs; }
+    
+    // Счетчики последней передачи (байты получены / нужны для вердикта)
+    const TransferStats& GetLastTransferStats() const { return lastTransfer; }
+    
+    bool IsInitialized() const { return memoryBudget || curlHandle.IsValid(); }
+    
+    // Прервать идущую блокирующую передачу (из любого потока) и не начинать новые.
+    // Передача завершится с CURLE_ABORTED_BY_CALLBACK.
+    void Cancel();
 };
 
 #endif // WEB_SCRAPER_H
\ No newline at end of file
@@ -14,9 +14,49 @@ g++ -std=c++17 -o stream_monitor.exe ^
     src\Notification.cpp ^
     src\Statistics.cpp ^
     src\WebScraper.cpp ^
+    src\MarkerMatcher.cpp ^
+    src\MarkerScanner.cpp ^
     src\BrowserController.cpp ^
     src\StreamMonitor.cpp ^
     src\MultiStreamMonitor.cpp ^
+    src\CurlMultiEngine.cpp ^
+    src\CurlShare.cpp ^
+    src\LatencyWindow.cpp ^
+    src\CheckScheduler.cpp ^
+    src\DeadlineQueue.cpp ^
+    src\TimingWheel.cpp ^
+    src\TaskExecutor.cpp ^
+    src\ShutdownCoordinator.cpp ^
+    src\PollPredictor.cpp ^
+    src\PollSimulator.cpp ^
+    src\RateLimiter.cpp ^
+    src\FailurePolicy.cpp ^
+    src\StreamerListWatcher.cpp ^
+    src\MonitorRegistry.cpp ^
+    src\MonitorContext.cpp ^
+    src\MemoryReport.cpp ^
+    src\ChannelStateTable.cpp ^
+    src\StreamerNames.cpp ^
+    src\StreamerList.cpp ^
+    src\StreamerListBenchmark.cpp ^
+    src\BenchmarkSupport.cpp ^
+    src\EngineBenchmark.cpp ^
+    src\MarkerBenchmark.cpp ^
+    src\MarkerScanBenchmark.cpp ^
+    src\AllocationCounter.cpp ^
+    src\AllocationBenchmark.cpp ^
+    src\SchedulerBenchmark.cpp ^
+    src\ExecutorBenchmark.cpp ^
+    src\StartupBenchmark.cpp ^
+    src\RateLimiterBenchmark.cpp ^
+    src\ReloadBenchmark.cpp ^
+    src\StandInServer.cpp ^
+    src\ProbeBenchmark.cpp ^
+    src\ShutdownBenchmark.cpp ^
+    src\H2Benchmark.cpp ^
+    src\HedgeBenchmark.cpp ^
+    src\StateTableBenchmark.cpp ^
+    src\RegistryBenchmark.cpp ^
     -L"C:\curl\lib" ^
     -lcurl -lbrotlidec -lbrotlicommon -lnghttp2 -lssl -lcrypto -lssh2 -lz -lzstd -lws2_32 -lwldap32 -lcrypt32 -lnormaliz
 
@@ -0,0 +1,121 @@
+#include "AllocationBenchmark.h"
+#include "AllocationCounter.h"
+#include "MarkerBenchmark.h"
+#include "MarkerMatcher.h"
+#include "MonitorContext.h"
+#include "WebScraper.h"
+#include "Logger.h"
+#include "Constants.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_allocs.log";
+const char* BENCH_STREAMER = "alloc_bench";
+const size_t PAGE_BYTES = 96 * 1024;
+const size_t CHUNK_BYTES = 16 * 1024;
+const int PROBE_RANGE_BYTES = 4096;
+
+
+AllocationBenchmarkResult Finish(const std::string& scenario, int checks) {
+    AllocationCounter::Stop();
+
+    AllocationBenchmarkResult result;
+    result.scenario = scenario;
+    result.checks = checks;
+    result.newPerCheck = static_cast<double>(AllocationCounter::GetNewCalls()) / checks;
+    result.curlAllocationsPerCheck = static_cast<double>(AllocationCounter::GetCurlAllocations()) / checks;
+    return result;
+}
+
+}
+
+
+AllocationBenchmark::AllocationBenchmark(std::shared_ptr<Config> configInstance, int warmupCount, int checkCount)
+    : config(configInstance), warmupChecks(std::max(1, warmupCount)), checks(std::max(1, checkCount)) {
+    
+    // Ресурсы проверки живут весь срок скрапера; второй запрос hedge не нужен
+    config->Set("memory_budget", "false");
+    config->Set("hedge_requests", "false");
+}
+
+
+AllocationBenchmarkResult AllocationBenchmark::RunMatcher() const {
+    std::vector<std::string> pages = {
+        MarkerBenchmark::MakePage(false, PAGE_BYTES),
+        MarkerBenchmark::MakePage(true, PAGE_BYTES)
+    };
+    MarkerMatcher matcher(MarkerAutomaton::GetDefault(), Constants::HTML_TAIL_WINDOW);
+    
+    auto feedPage = [&matcher](const std::string& page) {
+        matcher.Reset();
+        for (size_t offset = 0; offset < page.size(); offset += CHUNK_BYTES) {
+            matcher.Feed(page.data() + offset, std::min(CHUNK_BYTES, page.size() - offset));
+        }
+    };
+    
+    for (int i = 0; i < warmupChecks; i++) {
+        feedPage(pages[i % pages.size()]);
+    }
+    
+    AllocationCounter::Start();
+    for (int i = 0; i < checks; i++) {
+        feedPage(pages[i % pages.size()]);
+    }
+    return Finish("marker matcher", checks);
+}
+
+
+AllocationBenchmarkResult AllocationBenchmark::RunScraper(const std::string& scenario, bool useHeadRequest,
+                                                          int probeRangeBytes) const {
+    config->Set("use_head_request", useHeadRequest ? "true" : "false");
+    config->Set("probe_range_bytes", std::to_string(probeRangeBytes));
+    
+    auto logger = std::make_shared<Logger>(BENCH_LOG_FILE);
+    auto context = std::make_shared<MonitorContext>(config, logger);
+    StreamerId streamerId = context->GetStreamerNames()->Intern(BENCH_STREAMER);
+    WebScraper scraper(context);
+    
+    // Прогрев: соединение, резервы буферов, offline-отпечаток для probe
+    for (int i = 0; i < warmupChecks; i++) {
+        scraper.CheckStreamStatus(streamerId);
+    }
+    
+    AllocationCounter::Start();
+    for (int i = 0; i < checks; i++) {
+        scraper.CheckStreamStatus(streamerId);
+    }
+    return Finish(scenario, checks);
+}
+
+
+std::string AllocationBenchmark::RunComparison(bool& steadyStateClean) const {
+    steadyStateClean = false;
+    std::vector<AllocationBenchmarkResult> results;
+    results.push_back(RunMatcher());
+    results.push_back(RunScraper("full fetch", false, 0));
+    results.push_back(RunScraper("HEAD probe", true, 0));
+    results.push_back(RunScraper("range probe", true, PROBE_RANGE_BYTES));
+    
+    std::ostringstream ss;
+    ss << std::left << std::setw(18) << "scenario"
+       << std::right << std::setw(10) << "checks"
+       << std::setw(14) << "new/check"
+       << std::setw(18) << "curl malloc/check" << "\n";
+    
+    steadyStateClean = true;
+    for (const auto& result : results) {
+        steadyStateClean = steadyStateClean && result.newPerCheck == 0.0;
+        ss << std::left << std::setw(18) << result.scenario
+           << std::right << std::setw(10) << result.checks
+           << std::fixed << std::setprecision(2)
+           << std::setw(14) << result.newPerCheck
+           << std::setw(18) << result.curlAllocationsPerCheck << "\n";
+    }
+    
+    return ss.str();
+}
@@ -0,0 +1,127 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <curl/curl.h>
+
+
+namespace {
+    std::atomic<bool> counting(false);
+    std::atomic<uint64_t> newCalls(0);
+    std::atomic<uint64_t> curlAllocations(0);
+    bool curlHooked = false;
+
+
+    void CountCurlAllocation() {
+        if (counting.load(std::memory_order_relaxed)) {
+            curlAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+
+    void* CurlMalloc(size_t size) {
+        CountCurlAllocation();
+        return std::malloc(size);
+    }
+
+
+    void* CurlRealloc(void* pointer, size_t size) {
+        CountCurlAllocation();
+        return std::realloc(pointer, size);
+    }
+
+
+    void* CurlCalloc(size_t count, size_t size) {
+        CountCurlAllocation();
+        return std::calloc(count, size);
+    }
+
+
+    char* CurlStrdup(const char* text) {
+        CountCurlAllocation();
+        size_t length = std::strlen(text) + 1;
+        char* copy = static_cast<char*>(std::malloc(length));
+        if (copy) {
+            std::memcpy(copy, text, length);
+        }
+        return copy;
+    }
+
+
+    void CurlFree(void* pointer) {
+        std::free(pointer);
+    }
+}
+
+
+// Остальные формы (new[], nothrow) в libstdc++ сводятся к этой
+void* operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        newCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (;;) {
+        void* pointer = std::malloc(size ? size : 1);
+        if (pointer) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+
+namespace AllocationCounter {
+
+    bool HookCurl() {
+        if (!curlHooked) {
+            curlHooked = curl_global_init_mem(CURL_GLOBAL_DEFAULT, CurlMalloc, CurlFree, CurlRealloc,
+                                              CurlStrdup, CurlCalloc) == CURLE_OK;
+        }
+        return curlHooked;
+    }
+
+
+    void UnhookCurl() {
+        if (curlHooked) {
+            curl_global_cleanup();
+            curlHooked = false;
+        }
+    }
+
+
+    void Start() {
+        newCalls = 0;
+        curlAllocations = 0;
+        counting = true;
+    }
+
+
+    void Stop() {
+        counting = false;
+    }
+
+
+    uint64_t GetNewCalls() {
+        return newCalls.load();
+    }
+
+
+    uint64_t GetCurlAllocations() {
+        return curlAllocations.load();
+    }
+}
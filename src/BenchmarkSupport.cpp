@@ -0,0 +1,48 @@
+#include "BenchmarkSupport.h"
+#include "RateLimiter.h"
+#include "Constants.h"
+#include <fstream>
+#include <iostream>
+
+
+namespace BenchmarkSupport {
+
+    void PrepareMonitorConfig(Config& config, const std::string& logFile) {
+        config.Set("open_browser", "false");
+        config.Set("enable_notifications", "false");
+        config.Set("enable_statistics", "false");
+        config.Set("poll_strategy", "fixed");
+        config.Set("watch_streamers_file", "false");
+        config.Set("rate_limit_rps", "0");
+        config.Set("log_file", logFile);
+    }
+
+
+    int RequireLocalUrl(const Config& config) {
+        std::string url = config.GetString("twitch_base_url", Constants::TWITCH_BASE_URL);
+        std::string host = RateLimiter::HostOf(url);
+        if (host == "127.0.0.1" || host == "localhost") {
+            return 0;
+        }
+        std::cerr << "twitch_base_url must point to a local stand-in server (127.0.0.1 or localhost), got "
+                  << url << std::endl;
+        return 1;
+    }
+
+
+    long ThreadCount() {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string key;
+        while (status >> key) {
+            if (key == "Threads:") {
+                long threads = -1;
+                status >> threads;
+                return threads;
+            }
+            status.ignore(4096, '\n');
+        }
+#endif
+        return -1;
+    }
+}
@@ -10,9 +10,9 @@
 BrowserController::BrowserController(std::shared_ptr<Logger> loggerInstance, bool enable)
     : logger(loggerInstance), browserTabOpened(false), enabled(enable) {
     
-    std::cout << "[BrowserController] Initialized. Enabled: " << (enabled ? "YES" : "NO") << std::endl;
-    logger->Info("BrowserController initialized. Enabled: " + std::string(enabled ? "YES" : "NO"), 
-                "BrowserController");
+    // Создается на каждый монитор: в --multi Info-строк было бы по числу каналов
+    logger->Debug(enabled ? "BrowserController initialized. Enabled: YES" : "BrowserController initialized. Enabled: NO",
+                  "BrowserController");
 }
 
 
@@ -0,0 +1,84 @@
+#include "ChannelStateTable.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+ChannelStateTable::ChannelStateTable() : slotCount(0) {
+    for (auto& chunk : chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+
+ChannelStateTable::~ChannelStateTable() {
+    for (auto& chunk : chunks) {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+
+uint32_t ChannelStateTable::Allocate(int checkInterval, int checkIntervalFast, int fastModeDuration) {
+    std::lock_guard<std::mutex> lock(allocMutex);
+
+    uint32_t slot = 0;
+    size_t count = slotCount.load(std::memory_order_relaxed);
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        if (count >= CHUNK_SIZE * MAX_CHUNKS) {
+            throw std::length_error("Channel state table is full");
+        }
+        if (!chunks[count / CHUNK_SIZE].load(std::memory_order_relaxed)) {
+            chunks[count / CHUNK_SIZE].store(new Chunk(), std::memory_order_release);
+        }
+        slot = static_cast<uint32_t>(count);
+    }
+
+    Chunk& chunk = ChunkOf(slot);
+    size_t i = slot % CHUNK_SIZE;
+    chunk.lastOnline[i].store(0, std::memory_order_relaxed);
+    chunk.checkInterval[i].store(checkInterval, std::memory_order_relaxed);
+    chunk.checkIntervalFast[i].store(checkIntervalFast, std::memory_order_relaxed);
+    chunk.fastModeDuration[i].store(fastModeDuration, std::memory_order_relaxed);
+    chunk.flags[i].store(IN_USE, std::memory_order_release);
+
+    if (slot == count) {
+        slotCount.store(count + 1, std::memory_order_release);
+    }
+    return slot;
+}
+
+
+void ChannelStateTable::Release(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(allocMutex);
+    ChunkOf(slot).flags[slot % CHUNK_SIZE].store(0, std::memory_order_release);
+    freeSlots.push_back(slot);
+}
+
+
+ChannelStateSummary ChannelStateTable::Summarize(long long unixTime) const {
+    ChannelStateSummary summary;
+    size_t count = slotCount.load(std::memory_order_acquire);
+
+    for (size_t base = 0; base < count; base += CHUNK_SIZE) {
+        const Chunk& chunk = *chunks[base / CHUNK_SIZE].load(std::memory_order_acquire);
+        size_t end = std::min(CHUNK_SIZE, count - base);
+
+        // Без ветвлений по флагам: свободные номера дают нули
+        for (size_t i = 0; i < end; i++) {
+            unsigned flags = chunk.flags[i].load(std::memory_order_relaxed);
+            unsigned inUse = flags & IN_USE;
+            long long lastOnline = chunk.lastOnline[i].load(std::memory_order_relaxed);
+            bool fast = lastOnline > 0 &&
+                        unixTime - lastOnline < chunk.fastModeDuration[i].load(std::memory_order_relaxed);
+
+            summary.channels += inUse;
+            summary.online += inUse & (flags >> 1);
+            summary.stopped += inUse & (flags >> 2);
+            summary.fastMode += inUse & static_cast<unsigned>(fast);
+        }
+    }
+
+    return summary;
+}
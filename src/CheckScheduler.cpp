@@ -0,0 +1,246 @@
+#include "CheckScheduler.h"
+#include "TimingWheel.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+
+CheckScheduler::CheckScheduler(std::shared_ptr<Logger> loggerInstance, size_t workerThreads,
+                               int checkJitterMs, const std::string& backend)
+    : logger(loggerInstance), workerCount(std::max<size_t>(1, workerThreads)),
+      jitterMs(std::max(0, checkJitterMs)), startTime(std::chrono::steady_clock::now()),
+      nextTaskId(1), runningCount(0), executedCount(0), lagWindow(LAG_WINDOW), running(false) {
+
+    if (backend == "heap") {
+        deadlines = std::make_unique<HeapDeadlineQueue>();
+    } else {
+        if (backend != "wheel") {
+            logger->Warning("Unknown scheduler_backend '" + backend + "', using wheel", "CheckScheduler");
+        }
+        deadlines = std::make_unique<TimingWheel>(0);
+    }
+
+    std::random_device rd;
+    jitterGenerator.seed(rd());
+}
+
+
+CheckScheduler::~CheckScheduler() {
+    Stop();
+}
+
+
+bool CheckScheduler::Start() {
+    if (running.exchange(true)) {
+        return true;
+    }
+
+    try {
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back(&CheckScheduler::WorkerThreadFunction, this);
+        }
+    } catch (const std::exception& e) {
+        logger->Critical("Failed to start scheduler workers: " + std::string(e.what()),
+                         "CheckScheduler");
+        Stop();
+        return false;
+    }
+
+    logger->System("Scheduler started (" + std::string(deadlines->Name()) + ", " +
+                   std::to_string(workerCount) + " worker(s), jitter " +
+                   std::to_string(jitterMs) + " ms)", "CheckScheduler");
+    return true;
+}
+
+
+void CheckScheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        if (!running.exchange(false) && workers.empty()) {
+            return;
+        }
+    }
+    wakeup.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    for (const auto& entry : tasks) {
+        deadlines->Cancel(entry.first);
+    }
+    tasks.clear();
+    ready.clear();
+
+    logger->System("Scheduler stopped", "CheckScheduler");
+}
+
+
+int CheckScheduler::NextJitterMs() {
+    if (jitterMs == 0) {
+        return 0;
+    }
+    std::uniform_int_distribution<int> dist(0, jitterMs);
+    return dist(jitterGenerator);
+}
+
+
+int64_t CheckScheduler::NowMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+
+void CheckScheduler::PushDeadline(uint64_t taskId, int delayMs) {
+    // Разброс, чтобы проверки с одинаковым интервалом не шли пачкой
+    deadlines->Schedule(taskId, NowMs() + std::max(0, delayMs) + NextJitterMs());
+}
+
+
+uint64_t CheckScheduler::Add(int delayMs, ScheduledTask task) {
+    uint64_t taskId = 0;
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        taskId = nextTaskId++;
+
+        TaskState& state = tasks[taskId];
+        state.task = std::move(task);
+        state.running = false;
+        state.cancelled = false;
+
+        PushDeadline(taskId, delayMs);
+    }
+    wakeup.notify_one();
+    return taskId;
+}
+
+
+bool CheckScheduler::Cancel(uint64_t taskId) {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+
+    auto it = tasks.find(taskId);
+    if (it == tasks.end()) {
+        return false;
+    }
+
+    deadlines->Cancel(taskId);
+    if (it->second.running) {
+        // Worker удалит задачу сам, когда проверка закончится
+        it->second.cancelled = true;
+    } else {
+        tasks.erase(it);
+    }
+    return true;
+}
+
+
+void CheckScheduler::WorkerThreadFunction() {
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+
+    while (running.load()) {
+        int64_t nowMs = NowMs();
+
+        if (ready.empty()) {
+            deadlines->PopExpired(nowMs, expiredBuffer);
+            ready.insert(ready.end(), expiredBuffer.begin(), expiredBuffer.end());
+            expiredBuffer.clear();
+        }
+
+        if (ready.empty()) {
+            int64_t wakeupMs = deadlines->NextWakeupMs();
+            if (wakeupMs < 0) {
+                wakeup.wait(lock);
+            } else {
+                wakeup.wait_until(lock, startTime + std::chrono::milliseconds(wakeupMs));
+            }
+            continue;
+        }
+
+        ExpiredDeadline next = ready.front();
+        ready.pop_front();
+
+        auto it = tasks.find(next.taskId);
+        if (it == tasks.end() || it->second.running) {
+            continue;  // Задачу сняли
+        }
+
+        TaskState& state = it->second;
+        state.running = true;
+        runningCount++;
+        lagWindow.Add(std::max<int64_t>(0, nowMs - next.deadlineMs));
+
+        // Еще есть готовые дедлайны - пусть их заберет другой worker
+        if (!ready.empty() || deadlines->Size() > 0) {
+            wakeup.notify_one();
+        }
+
+        ScheduledTask task = state.task;
+        lock.unlock();
+
+        int nextDelayMs = -1;
+        try {
+            nextDelayMs = task();
+        } catch (const std::exception& e) {
+            logger->Error("Exception in scheduled check: " + std::string(e.what()), "CheckScheduler");
+        }
+
+        lock.lock();
+        runningCount--;
+        executedCount++;
+
+        // Пока задача выполнялась, Stop() мог очистить таблицу
+        it = tasks.find(next.taskId);
+        if (it == tasks.end()) {
+            continue;
+        }
+
+        it->second.running = false;
+        if (it->second.cancelled || nextDelayMs < 0 || !running.load()) {
+            tasks.erase(it);
+            continue;
+        }
+
+        PushDeadline(next.taskId, nextDelayMs);
+    }
+}
+
+
+SchedulerStats CheckScheduler::GetStats() const {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+
+    SchedulerStats stats;
+    stats.workers = workerCount;
+    stats.backend = deadlines->Name();
+    stats.scheduledTasks = tasks.size();
+    stats.runningTasks = runningCount;
+    stats.executedTasks = executedCount;
+    stats.lag = lagWindow.Summarize();
+    return stats;
+}
+
+
+void CheckScheduler::ResetLag() {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    lagWindow.Clear();
+}
+
+
+std::string CheckScheduler::GetStatsSummary() const {
+    SchedulerStats stats = GetStats();
+    std::ostringstream ss;
+
+    ss << "backend=" << stats.backend
+       << ", workers=" << stats.workers
+       << ", tasks=" << stats.scheduledTasks
+       << ", running=" << stats.runningTasks
+       << ", executed=" << stats.executedTasks
+       << ", lag p50/p90/p99/max=" << stats.lag.p50Ms << "/" << stats.lag.p90Ms << "/"
+       << stats.lag.p99Ms << "/" << stats.lag.maxMs << " ms";
+
+    return ss.str();
+}
@@ -142,15 +142,50 @@ bool Config::Save() {
     file << "check_interval=" << GetInt("check_interval", Constants::DEFAULT_CHECK_INTERVAL) << std::endl;
     file << "check_interval_fast=" << GetInt("check_interval_fast", Constants::FAST_CHECK_INTERVAL) << std::endl;
     file << "fast_mode_duration=" << GetInt("fast_mode_duration", Constants::FAST_MODE_DURATION) << std::endl;
+    file << "# poll_strategy: predictive (частые проверки в часы, когда канал обычно стартует) | fixed" << std::endl;
+    file << "poll_strategy=" << GetString("poll_strategy", "predictive") << std::endl;
+    file << "# Запросов в минуту к offline-каналам на все каналы (0 = как при check_interval)" << std::endl;
+    file << "poll_budget_per_minute=" << GetInt("poll_budget_per_minute", 0) << std::endl;
+    file << "poll_max_interval=" << GetInt("poll_max_interval", Constants::POLL_MAX_INTERVAL) << std::endl;
     file << "max_html_size=" << GetInt("max_html_size", Constants::MAX_HTML_SIZE) << std::endl;
+    file << "marker_scan_kernel=" << GetString("marker_scan_kernel", "auto") << std::endl;
+    file << "abort_on_verdict=" << (GetBool("abort_on_verdict", true) ? "true" : "false") << std::endl;
+    file << "# Маркер конца встроенного состояния страницы (пусто = выключено)" << std::endl;
+    file << "offline_end_marker=" << GetString("offline_end_marker", "") << std::endl;
     file << std::endl;
     
     file << "# Network Settings" << std::endl;
     file << "timeout=" << GetInt("timeout", Constants::DEFAULT_TIMEOUT) << std::endl;
     file << "connect_timeout=" << GetInt("connect_timeout", Constants::DEFAULT_CONNECT_TIMEOUT) << std::endl;
     file << "use_http2=" << (GetBool("use_http2", true) ? "true" : "false") << std::endl;
+    file << "# HTTP/2 multiplexing (--multi, event_loop): проверки идут streams на общих соединениях" << std::endl;
+    file << "http2_multiplex=" << (GetBool("http2_multiplex", true) ? "true" : "false") << std::endl;
+    file << "http2_max_connections=" << GetInt("http2_max_connections", Constants::HTTP2_MAX_CONNECTIONS) << std::endl;
+    file << "http2_max_streams=" << GetInt("http2_max_streams", Constants::HTTP2_MAX_STREAMS) << std::endl;
+    file << "# Лимитер --multi: запросов в секунду (0 = без лимита), запас, параллельных на хост" << std::endl;
+    file << "rate_limit_rps=" << GetInt("rate_limit_rps", Constants::RATE_LIMIT_RPS) << std::endl;
+    file << "rate_limit_burst=" << GetInt("rate_limit_burst", Constants::RATE_LIMIT_BURST) << std::endl;
+    file << "max_inflight_per_host=" << GetInt("max_inflight_per_host", Constants::MAX_INFLIGHT_PER_HOST) << std::endl;
+    file << "# Проверка, прождавшая токен дольше (мс), пропускается до следующей по расписанию" << std::endl;
+    file << "rate_limit_max_wait_ms=" << GetInt("rate_limit_max_wait_ms", Constants::RATE_LIMIT_MAX_WAIT_MS) << std::endl;
+    file << "# Ошибки: быстрых повторов после сбоя сети, backoff хоста после 429 (мс)," << std::endl;
+    file << "# breaker после N permanent-ошибок подряд (404, TLS) на breaker_cooldown секунд" << std::endl;
+    file << "retry_fast_max=" << GetInt("retry_fast_max", Constants::RETRY_FAST_MAX) << std::endl;
+    file << "backoff_base_ms=" << GetInt("backoff_base_ms", Constants::BACKOFF_BASE_MS) << std::endl;
+    file << "backoff_max_ms=" << GetInt("backoff_max_ms", Constants::BACKOFF_MAX_MS) << std::endl;
+    file << "breaker_threshold=" << GetInt("breaker_threshold", Constants::BREAKER_THRESHOLD) << std::endl;
+    file << "breaker_cooldown=" << GetInt("breaker_cooldown", Constants::BREAKER_COOLDOWN_SECONDS) << std::endl;
+    file << "# Hedge: страница медленнее p95 канала - второй запрос на новом соединении, первый ответ побеждает." << std::endl;
+    file << "# adaptive_timeout: таймаут загрузки по p99 канала, но не больше timeout" << std::endl;
+    file << "hedge_requests=" << (GetBool("hedge_requests", false) ? "true" : "false") << std::endl;
+    file << "adaptive_timeout=" << (GetBool("adaptive_timeout", false) ? "true" : "false") << std::endl;
     file << "dns_cache_timeout=" << GetInt("dns_cache_timeout", Constants::DNS_CACHE_TIMEOUT_SECONDS) << std::endl;
+    file << "share_connections=" << (GetBool("share_connections", true) ? "true" : "false") << std::endl;
     file << "use_head_request=" << (GetBool("use_head_request", true) ? "true" : "false") << std::endl;
+    file << "# Probe: 0 = HEAD, N = GET первых N байт; полная загрузка раз в probe_full_every пропусков" << std::endl;
+    file << "probe_range_bytes=" << GetInt("probe_range_bytes", 0) << std::endl;
+    file << "probe_full_every=" << GetInt("probe_full_every", 10) << std::endl;
+    file << "twitch_base_url=" << GetString("twitch_base_url", Constants::TWITCH_BASE_URL) << std::endl;
     file << std::endl;
     
     file << "# SSL Settings" << std::endl;
@@ -173,6 +208,25 @@ bool Config::Save() {
     file << "# Features v2.2+" << std::endl;
     file << "enable_notifications=" << (GetBool("enable_notifications", true) ? "true" : "false") << std::endl;
     file << "enable_statistics=" << (GetBool("enable_statistics", true) ? "true" : "false") << std::endl;
+    file << std::endl;
+    
+    file << "# Multi-monitor Settings (event_loop | threads)" << std::endl;
+    file << "multi_engine=" << GetString("multi_engine", "event_loop") << std::endl;
+    file << "# Первые проверки всех стримеров разносятся по этому окну (мс)" << std::endl;
+    file << "startup_warmup_ms=" << GetInt("startup_warmup_ms", Constants::STARTUP_WARMUP_MS) << std::endl;
+    file << "# threads: фиксированный пул проверок + разброс дедлайнов" << std::endl;
+    file << "worker_threads=" << GetInt("worker_threads", Constants::DEFAULT_WORKER_THREADS) << std::endl;
+    file << "check_jitter_ms=" << GetInt("check_jitter_ms", Constants::REQUEST_INTERVAL_JITTER_MS) << std::endl;
+    file << "# scheduler_backend: wheel (колесо таймеров) | heap" << std::endl;
+    file << "scheduler_backend=" << GetString("scheduler_backend", "wheel") << std::endl;
+    file << "# Пул для разбора ответов и событий (0 = по числу ядер)" << std::endl;
+    file << "executor_threads=" << GetInt("executor_threads", Constants::DEFAULT_EXECUTOR_THREADS) << std::endl;
+    file << "# Сколько ждать записи статистики при остановке (мс)" << std::endl;
+    file << "shutdown_timeout_ms=" << GetInt("shutdown_timeout_ms", Constants::SHUTDOWN_TIMEOUT_MS) << std::endl;
+    file << "# Перечитывать список стримеров при изменении файла: новые запускаются, удаленные останавливаются" << std::endl;
+    file << "watch_streamers_file=" << (GetBool("watch_streamers_file", true) ? "true" : "false") << std::endl;
+    file << "# Меньше памяти на канал: curl handle и буферы только на время проверки, история сессий - с диска по запросу" << std::endl;
+    file << "memory_budget=" << (GetBool("memory_budget", false) ? "true" : "false") << std::endl;
     
     file.close();
     std::cout << "Configuration saved to '" << configFilePath << "'" << std::endl;
@@ -185,14 +239,38 @@ void Config::CreateDefault() {
     settings["check_interval"] = std::to_string(Constants::DEFAULT_CHECK_INTERVAL);
     settings["check_interval_fast"] = std::to_string(Constants::FAST_CHECK_INTERVAL);
     settings["fast_mode_duration"] = std::to_string(Constants::FAST_MODE_DURATION);
+    settings["poll_strategy"] = "predictive";
+    settings["poll_budget_per_minute"] = "0";
+    settings["poll_max_interval"] = std::to_string(Constants::POLL_MAX_INTERVAL);
     settings["max_html_size"] = std::to_string(Constants::MAX_HTML_SIZE);
+    settings["marker_scan_kernel"] = "auto";
+    settings["abort_on_verdict"] = "true";
+    settings["offline_end_marker"] = "";
     
     // Network Settings
     settings["timeout"] = std::to_string(Constants::DEFAULT_TIMEOUT);
     settings["connect_timeout"] = std::to_string(Constants::DEFAULT_CONNECT_TIMEOUT);
     settings["use_http2"] = "true";
+    settings["http2_multiplex"] = "true";
+    settings["http2_max_connections"] = std::to_string(Constants::HTTP2_MAX_CONNECTIONS);
+    settings["http2_max_streams"] = std::to_string(Constants::HTTP2_MAX_STREAMS);
+    settings["rate_limit_rps"] = std::to_string(Constants::RATE_LIMIT_RPS);
+    settings["rate_limit_burst"] = std::to_string(Constants::RATE_LIMIT_BURST);
+    settings["max_inflight_per_host"] = std::to_string(Constants::MAX_INFLIGHT_PER_HOST);
+    settings["rate_limit_max_wait_ms"] = std::to_string(Constants::RATE_LIMIT_MAX_WAIT_MS);
+    settings["retry_fast_max"] = std::to_string(Constants::RETRY_FAST_MAX);
+    settings["backoff_base_ms"] = std::to_string(Constants::BACKOFF_BASE_MS);
+    settings["backoff_max_ms"] = std::to_string(Constants::BACKOFF_MAX_MS);
+    settings["breaker_threshold"] = std::to_string(Constants::BREAKER_THRESHOLD);
+    settings["breaker_cooldown"] = std::to_string(Constants::BREAKER_COOLDOWN_SECONDS);
+    settings["hedge_requests"] = "false";
+    settings["adaptive_timeout"] = "false";
     settings["dns_cache_timeout"] = std::to_string(Constants::DNS_CACHE_TIMEOUT_SECONDS);
+    settings["share_connections"] = "true";
     settings["use_head_request"] = "true";
+    settings["probe_range_bytes"] = "0";
+    settings["probe_full_every"] = "10";
+    settings["twitch_base_url"] = Constants::TWITCH_BASE_URL;
     
     // SSL Settings
     settings["ssl_verify_peer"] = "false";
@@ -211,6 +289,17 @@ void Config::CreateDefault() {
     // Features
     settings["enable_notifications"] = "true";
     settings["enable_statistics"] = "true";
+    
+    // Multi-monitor
+    settings["multi_engine"] = "event_loop";
+    settings["startup_warmup_ms"] = std::to_string(Constants::STARTUP_WARMUP_MS);
+    settings["worker_threads"] = std::to_string(Constants::DEFAULT_WORKER_THREADS);
+    settings["check_jitter_ms"] = std::to_string(Constants::REQUEST_INTERVAL_JITTER_MS);
+    settings["scheduler_backend"] = "wheel";
+    settings["executor_threads"] = std::to_string(Constants::DEFAULT_EXECUTOR_THREADS);
+    settings["shutdown_timeout_ms"] = std::to_string(Constants::SHUTDOWN_TIMEOUT_MS);
+    settings["watch_streamers_file"] = "true";
+    settings["memory_budget"] = "false";
 }
 
 
@@ -0,0 +1,471 @@
+#include "CurlMultiEngine.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+
+namespace {
+    const int MAX_EPOLL_EVENTS = 256;
+    const int IDLE_WAIT_MS = 1000;
+}
+
+
+CurlMultiEngine::CurlMultiEngine(std::shared_ptr<Logger> loggerInstance)
+    : logger(loggerInstance), multiHandle(nullptr), running(false),
+      timerSequence(0), curlTimerArmed(false),
+      activeCount(0), completedCount(0), latencies(LATENCY_WINDOW), timerLags(LATENCY_WINDOW) {
+
+#ifdef __linux__
+    epollFd = -1;
+    wakeupFd = -1;
+#endif
+
+    multiHandle = curl_multi_init();
+    if (!multiHandle) {
+        std::cerr << "CRITICAL: Failed to initialize cURL multi handle" << std::endl;
+        logger->Critical("Failed to initialize cURL multi handle", "CurlMultiEngine");
+        return;
+    }
+
+    curl_multi_setopt(multiHandle, CURLMOPT_SOCKETFUNCTION, SocketCallback);
+    curl_multi_setopt(multiHandle, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multiHandle, CURLMOPT_TIMERFUNCTION, TimerCallback);
+    curl_multi_setopt(multiHandle, CURLMOPT_TIMERDATA, this);
+    
+    // libcurl с 7.62 мультиплексирует по умолчанию: без ConfigureMultiplexing - соединение на передачу
+    curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, CURLPIPE_NOTHING);
+}
+
+
+CurlMultiEngine::~CurlMultiEngine() {
+    Stop();
+
+    if (multiHandle) {
+        curl_multi_cleanup(multiHandle);
+        multiHandle = nullptr;
+    }
+
+#ifdef __linux__
+    if (wakeupFd >= 0) close(wakeupFd);
+    if (epollFd >= 0) close(epollFd);
+#endif
+}
+
+
+void CurlMultiEngine::ConfigureMultiplexing(long maxConnections, long maxStreams) {
+    if (!multiHandle) {
+        return;
+    }
+
+    // Параллельные проверки становятся streams на уже открытых соединениях.
+    // Лимит соединений на хост: лишние передачи ждут свободный stream.
+    curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, maxConnections);
+    curl_multi_setopt(multiHandle, CURLMOPT_MAX_CONCURRENT_STREAMS, maxStreams);
+
+    logger->Info("HTTP/2 multiplexing: max " + std::to_string(maxConnections) +
+                 " connection(s) per host, " + std::to_string(maxStreams) +
+                 " stream(s) per connection", "CurlMultiEngine");
+}
+
+
+bool CurlMultiEngine::Start() {
+    if (!multiHandle) {
+        return false;
+    }
+    if (running.load()) {
+        return true;
+    }
+
+#ifdef __linux__
+    if (epollFd < 0) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (epollFd < 0 || wakeupFd < 0) {
+            logger->Critical("Failed to create epoll/eventfd", "CurlMultiEngine");
+            return false;
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = wakeupFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeupFd, &ev);
+    }
+#endif
+
+    running = true;
+    loopThread = std::thread(&CurlMultiEngine::LoopThreadFunction, this);
+
+    logger->System("Event loop started", "CurlMultiEngine");
+    return true;
+}
+
+
+void CurlMultiEngine::Stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    Wakeup();
+    if (loopThread.joinable()) {
+        loopThread.join();
+    }
+
+    AbortActiveTransfers();
+
+    logger->System("Event loop stopped", "CurlMultiEngine");
+}
+
+
+void CurlMultiEngine::AbortActiveTransfers() {
+    // Поток event loop уже остановлен - можно трогать multi handle напрямую
+    for (auto& entry : activeTransfers) {
+        curl_multi_remove_handle(multiHandle, entry.first);
+    }
+    activeTransfers.clear();
+    activeCount = 0;
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingTransfers.clear();
+    while (!timers.empty()) {
+        timers.pop();
+    }
+}
+
+
+void CurlMultiEngine::Submit(CURL* easy, TransferCallback onDone) {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pendingTransfers.push_back({easy, std::move(onDone)});
+    }
+    Wakeup();
+}
+
+
+void CurlMultiEngine::ScheduleAfter(int delayMs, LoopTask task) {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        Timer timer;
+        timer.when = std::chrono::steady_clock::now() +
+                     std::chrono::milliseconds(std::max(0, delayMs));
+        timer.sequence = timerSequence++;
+        timer.task = std::move(task);
+        timers.push(std::move(timer));
+    }
+    Wakeup();
+}
+
+
+void CurlMultiEngine::Cancel(CURL* easy) {
+    auto it = activeTransfers.find(easy);
+    if (it != activeTransfers.end()) {
+        curl_multi_remove_handle(multiHandle, easy);
+        activeTransfers.erase(it);
+        activeCount = activeTransfers.size();
+        return;
+    }
+
+    // Submit из этой же итерации цикла еще не добавлен в multi
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingTransfers.erase(std::remove_if(pendingTransfers.begin(), pendingTransfers.end(),
+        [easy](const PendingTransfer& pending) { return pending.easy == easy; }), pendingTransfers.end());
+}
+
+
+void CurlMultiEngine::Wakeup() {
+#ifdef __linux__
+    if (wakeupFd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeupFd, &one, sizeof(one));
+        (void)written;
+    }
+#else
+    if (multiHandle) {
+        curl_multi_wakeup(multiHandle);
+    }
+#endif
+}
+
+
+int CurlMultiEngine::SocketCallback(CURL* easy, curl_socket_t socket, int what,
+                                    void* userp, void* socketp) {
+    (void)easy;
+    (void)socketp;
+
+#ifdef __linux__
+    CurlMultiEngine* engine = static_cast<CurlMultiEngine*>(userp);
+
+    if (what == CURL_POLL_REMOVE) {
+        epoll_ctl(engine->epollFd, EPOLL_CTL_DEL, socket, nullptr);
+        return 0;
+    }
+
+    epoll_event ev{};
+    ev.data.fd = socket;
+    if (what == CURL_POLL_IN || what == CURL_POLL_INOUT) ev.events |= EPOLLIN;
+    if (what == CURL_POLL_OUT || what == CURL_POLL_INOUT) ev.events |= EPOLLOUT;
+
+    if (epoll_ctl(engine->epollFd, EPOLL_CTL_MOD, socket, &ev) != 0 && errno == ENOENT) {
+        epoll_ctl(engine->epollFd, EPOLL_CTL_ADD, socket, &ev);
+    }
+#else
+    // curl_multi_poll сам следит за сокетами
+    (void)socket;
+    (void)what;
+    (void)userp;
+#endif
+    return 0;
+}
+
+
+int CurlMultiEngine::TimerCallback(CURLM* multi, long timeoutMs, void* userp) {
+    (void)multi;
+    CurlMultiEngine* engine = static_cast<CurlMultiEngine*>(userp);
+
+    if (timeoutMs < 0) {
+        engine->curlTimerArmed = false;
+    } else {
+        engine->curlTimerArmed = true;
+        engine->curlTimerDeadline = std::chrono::steady_clock::now() +
+                                    std::chrono::milliseconds(timeoutMs);
+    }
+    return 0;
+}
+
+
+void CurlMultiEngine::DrainPendingTransfers() {
+    std::vector<PendingTransfer> batch;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        batch.swap(pendingTransfers);
+    }
+
+    for (auto& pending : batch) {
+        CURLMcode rc = curl_multi_add_handle(multiHandle, pending.easy);
+        if (rc != CURLM_OK) {
+            logger->Error("curl_multi_add_handle failed: " + std::string(curl_multi_strerror(rc)),
+                         "CurlMultiEngine");
+            completedCount++;
+            pending.onDone(CURLE_FAILED_INIT);
+            continue;
+        }
+        activeTransfers[pending.easy] = std::move(pending.onDone);
+        activeCount = activeTransfers.size();
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.peakActiveTransfers = std::max(stats.peakActiveTransfers, activeTransfers.size());
+}
+
+
+int CurlMultiEngine::RunDueTimers() {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<Timer> dueTasks;
+    int nextWaitMs = -1;
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        while (!timers.empty() && timers.top().when <= now) {
+            dueTasks.push_back(std::move(const_cast<Timer&>(timers.top())));
+            timers.pop();
+        }
+        if (!timers.empty()) {
+            nextWaitMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                timers.top().when - now).count()) + 1;
+        }
+    }
+
+    // Задачи выполняем без блокировки: они сами могут вызывать Submit/ScheduleAfter
+    for (auto& due : dueTasks) {
+        // Опоздание считается к запуску: задачи пачки ждут и друг друга
+        long long lagMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - due.when).count();
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            timerLags.Add(lagMs);
+        }
+
+        try {
+            due.task();
+        } catch (const std::exception& e) {
+            logger->Error("Exception in loop task: " + std::string(e.what()), "CurlMultiEngine");
+        }
+    }
+
+    return dueTasks.empty() ? nextWaitMs : 0;
+}
+
+
+int CurlMultiEngine::ComputeWaitMs(int timerWaitMs) const {
+    int waitMs = IDLE_WAIT_MS;
+
+    if (timerWaitMs >= 0) {
+        waitMs = std::min(waitMs, timerWaitMs);
+    }
+
+    if (curlTimerArmed) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            curlTimerDeadline - std::chrono::steady_clock::now()).count();
+        waitMs = std::min(waitMs, static_cast<int>(std::max<long long>(0, left)));
+    }
+
+    return waitMs;
+}
+
+
+void CurlMultiEngine::RecordTransferMetrics(CURL* easy) {
+    long numConnects = 0;
+    long httpVersion = 0;
+    curl_off_t totalTimeUs = 0;
+
+    curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &numConnects);
+    curl_easy_getinfo(easy, CURLINFO_HTTP_VERSION, &httpVersion);
+    curl_easy_getinfo(easy, CURLINFO_TOTAL_TIME_T, &totalTimeUs);
+
+    bool isHttp2 = httpVersion == CURL_HTTP_VERSION_2_0;
+    long long latencyMs = static_cast<long long>(totalTimeUs / 1000);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    stats.transfers++;
+    stats.connectionsOpened += static_cast<unsigned long long>(numConnects);
+    if (isHttp2) {
+        stats.http2Transfers++;
+        stats.http2ConnectionsOpened += static_cast<unsigned long long>(numConnects);
+    }
+
+    latencies.Add(latencyMs);
+}
+
+
+EngineStats CurlMultiEngine::GetStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    EngineStats snapshot = stats;
+    LatencySummary latency = latencies.Summarize();
+    snapshot.latencyP50Ms = latency.p50Ms;
+    snapshot.latencyP90Ms = latency.p90Ms;
+    snapshot.latencyP99Ms = latency.p99Ms;
+    snapshot.latencyMaxMs = latency.maxMs;
+    snapshot.timerLag = timerLags.Summarize();
+    return snapshot;
+}
+
+
+void CurlMultiEngine::ResetTimerLag() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    timerLags.Clear();
+}
+
+
+std::string CurlMultiEngine::GetStatsSummary() const {
+    EngineStats snapshot = GetStats();
+    std::ostringstream ss;
+
+    ss << "transfers=" << snapshot.transfers
+       << ", connections opened=" << snapshot.connectionsOpened
+       << ", http2 streams/connection=" << std::fixed << std::setprecision(1)
+       << snapshot.StreamsPerConnection()
+       << ", peak active=" << snapshot.peakActiveTransfers
+       << ", latency p50/p90/p99/max=" << snapshot.latencyP50Ms << "/"
+       << snapshot.latencyP90Ms << "/" << snapshot.latencyP99Ms << "/"
+       << snapshot.latencyMaxMs << " ms"
+       << ", timer lag p50/p99/max=" << snapshot.timerLag.p50Ms << "/" << snapshot.timerLag.p99Ms << "/"
+       << snapshot.timerLag.maxMs << " ms";
+
+    return ss.str();
+}
+
+
+void CurlMultiEngine::ProcessCompletions() {
+    int messagesLeft = 0;
+    CURLMsg* message = nullptr;
+
+    while ((message = curl_multi_info_read(multiHandle, &messagesLeft)) != nullptr) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+
+        CURL* easy = message->easy_handle;
+        CURLcode result = message->data.result;
+
+        curl_multi_remove_handle(multiHandle, easy);
+        RecordTransferMetrics(easy);
+
+        auto it = activeTransfers.find(easy);
+        if (it == activeTransfers.end()) {
+            continue;
+        }
+
+        TransferCallback onDone = std::move(it->second);
+        activeTransfers.erase(it);
+        activeCount = activeTransfers.size();
+        completedCount++;
+
+        try {
+            onDone(result);
+        } catch (const std::exception& e) {
+            logger->Error("Exception in transfer callback: " + std::string(e.what()),
+                         "CurlMultiEngine");
+        }
+    }
+}
+
+
+void CurlMultiEngine::LoopThreadFunction() {
+    int stillRunning = 0;
+
+#ifdef __linux__
+    epoll_event events[MAX_EPOLL_EVENTS];
+#endif
+
+    while (running.load()) {
+        DrainPendingTransfers();
+        int waitMs = ComputeWaitMs(RunDueTimers());
+
+        // Таймерные задачи могли добавить новые передачи
+        DrainPendingTransfers();
+
+#ifdef __linux__
+        int count = epoll_wait(epollFd, events, MAX_EPOLL_EVENTS, waitMs);
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == wakeupFd) {
+                uint64_t value = 0;
+                ssize_t readBytes = read(wakeupFd, &value, sizeof(value));
+                (void)readBytes;
+                continue;
+            }
+
+            int flags = 0;
+            if (events[i].events & EPOLLIN) flags |= CURL_CSELECT_IN;
+            if (events[i].events & EPOLLOUT) flags |= CURL_CSELECT_OUT;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) flags |= CURL_CSELECT_ERR;
+
+            curl_multi_socket_action(multiHandle, fd, flags, &stillRunning);
+        }
+
+        if (curlTimerArmed && std::chrono::steady_clock::now() >= curlTimerDeadline) {
+            curlTimerArmed = false;
+            curl_multi_socket_action(multiHandle, CURL_SOCKET_TIMEOUT, 0, &stillRunning);
+        }
+#else
+        curl_multi_perform(multiHandle, &stillRunning);
+        curl_multi_poll(multiHandle, nullptr, 0, waitMs, nullptr);
+        curl_multi_perform(multiHandle, &stillRunning);
+#endif
+
+        ProcessCompletions();
+    }
+}
@@ -0,0 +1,160 @@
+#include "CurlShare.h"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+
+
+CurlShare::CurlShare()
+    : share(nullptr), transfers(0), connectionsOpened(0), connectionsReused(0),
+      tlsHandshakes(0), tlsResumed(0) {
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    share = curl_share_init();
+    if (!share) {
+        std::cerr << "CRITICAL: Failed to initialize cURL share handle" << std::endl;
+        return;
+    }
+
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, LockCallback);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, UnlockCallback);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+}
+
+
+CurlShare::~CurlShare() {
+    if (share) {
+        curl_share_cleanup(share);
+        share = nullptr;
+    }
+    curl_global_cleanup();
+}
+
+
+std::shared_ptr<CurlShare> CurlShare::Acquire() {
+    static std::mutex instanceMutex;
+    static std::weak_ptr<CurlShare> instance;
+
+    std::lock_guard<std::mutex> lock(instanceMutex);
+
+    std::shared_ptr<CurlShare> current = instance.lock();
+    if (!current) {
+        current = std::shared_ptr<CurlShare>(new CurlShare());
+        instance = current;
+    }
+
+    return current;
+}
+
+
+void CurlShare::LockCallback(CURL* handle, curl_lock_data data,
+                             curl_lock_access access, void* userp) {
+    (void)handle;
+    (void)access;  // Все данные share меняются и при чтении - только эксклюзивно
+    CurlShare* self = static_cast<CurlShare*>(userp);
+    self->locks[data].lock();
+}
+
+
+void CurlShare::UnlockCallback(CURL* handle, curl_lock_data data, void* userp) {
+    (void)handle;
+    CurlShare* self = static_cast<CurlShare*>(userp);
+    self->locks[data].unlock();
+}
+
+
+int CurlShare::DebugCallback(CURL* handle, curl_infotype type, char* text,
+                             size_t size, void* userp) {
+    (void)handle;
+
+    // libcurl не отдает факт возобновления через getinfo - ловим его info-строку
+    if (type != CURLINFO_TEXT) {
+        return 0;
+    }
+
+    static const char RESUMED_TEXT[] = "using session ID";
+    const size_t markerLength = sizeof(RESUMED_TEXT) - 1;
+
+    for (size_t i = 0; i + markerLength <= size; ++i) {
+        if (std::memcmp(text + i, RESUMED_TEXT, markerLength) == 0) {
+            *static_cast<bool*>(userp) = true;
+            break;
+        }
+    }
+
+    return 0;
+}
+
+
+bool CurlShare::Attach(CURL* easy, bool* tlsResumedFlag) {
+    if (!share || !easy) {
+        return false;
+    }
+
+    if (curl_easy_setopt(easy, CURLOPT_SHARE, share) != CURLE_OK) {
+        return false;
+    }
+
+    if (tlsResumedFlag) {
+        curl_easy_setopt(easy, CURLOPT_DEBUGFUNCTION, DebugCallback);
+        curl_easy_setopt(easy, CURLOPT_DEBUGDATA, tlsResumedFlag);
+        curl_easy_setopt(easy, CURLOPT_VERBOSE, 1L);
+    }
+
+    return true;
+}
+
+
+void CurlShare::RecordTransfer(CURL* easy, bool resumed) {
+    long numConnects = 0;
+    curl_off_t appConnectTime = 0;
+
+    curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &numConnects);
+    curl_easy_getinfo(easy, CURLINFO_APPCONNECT_TIME_T, &appConnectTime);
+
+    transfers++;
+
+    if (numConnects == 0) {
+        connectionsReused++;
+        return;
+    }
+
+    connectionsOpened += static_cast<unsigned long long>(numConnects);
+
+    // APPCONNECT > 0 только если на новом соединении было TLS-рукопожатие
+    if (appConnectTime > 0) {
+        tlsHandshakes++;
+        if (resumed) {
+            tlsResumed++;
+        }
+    }
+}
+
+
+ShareStats CurlShare::GetStats() const {
+    ShareStats stats;
+    stats.transfers = transfers.load();
+    stats.connectionsOpened = connectionsOpened.load();
+    stats.connectionsReused = connectionsReused.load();
+    stats.tlsHandshakes = tlsHandshakes.load();
+    stats.tlsResumed = tlsResumed.load();
+    return stats;
+}
+
+
+std::string CurlShare::GetSummaryString() const {
+    ShareStats stats = GetStats();
+    std::ostringstream ss;
+
+    ss << "transfers=" << stats.transfers
+       << ", connections opened=" << stats.connectionsOpened
+       << ", reused=" << stats.connectionsReused
+       << ", TLS handshakes=" << stats.tlsHandshakes
+       << " (resumed " << stats.tlsResumed << ")";
+
+    return ss.str();
+}
@@ -0,0 +1,51 @@
+#include "DeadlineQueue.h"
+
+
+HeapDeadlineQueue::HeapDeadlineQueue() : nextGeneration(1) {
+}
+
+
+bool HeapDeadlineQueue::IsStale(const Entry& entry) const {
+    auto it = generations.find(entry.taskId);
+    return it == generations.end() || it->second != entry.generation;
+}
+
+
+void HeapDeadlineQueue::DropStaleTop() {
+    while (!heap.empty() && IsStale(heap.top())) {
+        heap.pop();
+    }
+}
+
+
+void HeapDeadlineQueue::Schedule(uint64_t taskId, int64_t deadlineMs) {
+    uint64_t generation = nextGeneration++;
+    generations[taskId] = generation;
+    heap.push({deadlineMs, taskId, generation});
+}
+
+
+bool HeapDeadlineQueue::Cancel(uint64_t taskId) {
+    return generations.erase(taskId) > 0;
+}
+
+
+void HeapDeadlineQueue::PopExpired(int64_t nowMs, std::vector<ExpiredDeadline>& out) {
+    DropStaleTop();
+
+    while (!heap.empty() && heap.top().deadlineMs <= nowMs) {
+        Entry entry = heap.top();
+        heap.pop();
+
+        generations.erase(entry.taskId);
+        out.push_back({entry.taskId, entry.deadlineMs});
+
+        DropStaleTop();
+    }
+}
+
+
+int64_t HeapDeadlineQueue::NextWakeupMs() {
+    DropStaleTop();
+    return heap.empty() ? -1 : heap.top().deadlineMs;
+}
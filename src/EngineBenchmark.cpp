@@ -0,0 +1,134 @@
+#include "EngineBenchmark.h"
+#include "BenchmarkSupport.h"
+#include "MultiStreamMonitor.h"
+#include "StreamMonitor.h"
+#include "MonitorContext.h"
+#include "MemoryReport.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_engines.log";
+const char* BENCH_CHECK_INTERVAL = "5";  // Нижняя граница check_interval в Config::ValidateSettings
+
+
+std::vector<std::string> ChannelNames(size_t channels) {
+    std::vector<std::string> names;
+    names.reserve(channels);
+    for (size_t i = 0; i < channels; i++) {
+        names.push_back("bench_" + std::to_string(i));
+    }
+    return names;
+}
+
+
+EngineBenchmarkResult Sample(const std::string& engine, unsigned long long checks, int seconds) {
+    EngineBenchmarkResult result;
+    result.engine = engine;
+    result.threads = BenchmarkSupport::ThreadCount();
+    result.rssKb = MemoryUsage::Current().rssKb;
+    result.checks = checks;
+    result.checksPerSecond = static_cast<double>(checks) / seconds;
+    return result;
+}
+
+}
+
+
+EngineBenchmark::EngineBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int durationSeconds)
+    : config(configInstance), channels(std::max<size_t>(1, channelCount)), seconds(std::max(1, durationSeconds)) {
+    
+    // Меряются движки, а не побочные действия проверок
+    BenchmarkSupport::PrepareMonitorConfig(*config, BENCH_LOG_FILE);
+    config->Set("check_interval", BENCH_CHECK_INTERVAL);
+    config->Set("check_interval_fast", BENCH_CHECK_INTERVAL);
+    config->Set("startup_warmup_ms", "0");
+}
+
+
+EngineBenchmarkResult EngineBenchmark::RunMulti(const std::string& engine) const {
+    config->Set("multi_engine", engine);
+    
+    MultiStreamMonitor monitor(config);
+    monitor.ApplyStreamerList(ChannelNames(channels));
+    
+    monitor.StartAll();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    EngineBenchmarkResult result = Sample(engine == "threads" ? "worker pool" : "event loop",
+                                          monitor.GetCheckCount(), seconds);
+    monitor.StopAll();
+    return result;
+}
+
+
+EngineBenchmarkResult EngineBenchmark::RunThreadPerStreamer() const {
+    auto logger = std::make_shared<Logger>(BENCH_LOG_FILE);
+    auto context = std::make_shared<MonitorContext>(config, logger);
+    
+    std::vector<std::shared_ptr<StreamMonitor>> monitors;
+    monitors.reserve(channels);
+    for (const auto& name : ChannelNames(channels)) {
+        monitors.push_back(std::make_shared<StreamMonitor>(name, context));
+    }
+    
+    // Как до event loop: свой поток и свой цикл StartMonitoring на каждого стримера
+    std::vector<std::thread> threads;
+    threads.reserve(channels);
+    for (const auto& monitor : monitors) {
+        threads.emplace_back([monitor]() { monitor->StartMonitoring(); });
+    }
+    
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    
+    unsigned long long checks = 0;
+    for (const auto& monitor : monitors) {
+        checks += static_cast<unsigned long long>(monitor->GetCheckCount());
+    }
+    EngineBenchmarkResult result = Sample("thread/streamer", checks, seconds);
+    
+    for (const auto& monitor : monitors) {
+        monitor->Stop();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return result;
+}
+
+
+std::string EngineBenchmark::RunComparison() const {
+    // По возрастанию ожидаемого числа потоков: остаток прогона не портит следующий
+    std::vector<EngineBenchmarkResult> results;
+    results.push_back(RunMulti("event_loop"));
+    results.push_back(RunMulti("threads"));
+    results.push_back(RunThreadPerStreamer());
+    
+    std::ostringstream ss;
+    ss << std::left << std::setw(18) << "engine"
+       << std::right << std::setw(10) << "threads"
+       << std::setw(12) << "RSS, MB"
+       << std::setw(12) << "checks"
+       << std::setw(14) << "checks/sec" << "\n";
+    
+    for (const auto& result : results) {
+        ss << std::left << std::setw(18) << result.engine
+           << std::right << std::setw(10) << result.threads
+           << std::fixed << std::setprecision(1) << std::setw(12);
+        if (result.rssKb < 0) {
+            ss << "n/a";
+        } else {
+            ss << result.rssKb / 1024.0;
+        }
+        ss << std::setw(12) << result.checks
+           << std::setw(14) << result.checksPerSecond << "\n";
+    }
+    
+    return ss.str();
+}
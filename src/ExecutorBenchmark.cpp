@@ -0,0 +1,177 @@
+#include "ExecutorBenchmark.h"
+#include "TaskExecutor.h"
+#include "MarkerBenchmark.h"
+#include "MarkerMatcher.h"
+#include "Constants.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const size_t FAST_PAGE_BYTES = 4 * 1024;
+const size_t SLOW_PAGE_BYTES = 512 * 1024;
+const size_t SLOW_EVERY = 50;        // Каждая N-я задача - большая страница
+const size_t FOLLOW_UP_EVERY = 4;    // Каждая N-я быстрая ставит задачу из worker
+const size_t MAX_OUTSTANDING = 256;  // Извне не больше стольких невыполненных задач
+const int IDLE_SAMPLE_MS = 500;
+const double MAX_IDLE_CPU_PERCENT = 5.0;
+
+typedef std::chrono::steady_clock Clock;
+
+
+void ParsePage(const std::string& page) {
+    thread_local MarkerMatcher matcher(MarkerAutomaton::GetDefault(), Constants::HTML_TAIL_WINDOW);
+    matcher.Reset();
+    matcher.Feed(page.data(), page.size());
+}
+
+
+double Percentile(std::vector<double>& values, size_t p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(values.size() - 1) * p / 100];
+}
+
+
+double ProcessCpuMs() {
+    return static_cast<double>(std::clock()) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+}
+
+
+ExecutorBenchmark::ExecutorBenchmark(size_t workers, size_t taskCount)
+    : workerCount(workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency())),
+      tasks(std::max<size_t>(SLOW_EVERY, taskCount)) {
+}
+
+
+ExecutorBenchmarkResult ExecutorBenchmark::Run(size_t workers) const {
+    const std::string fastPage = MarkerBenchmark::MakePage(false, FAST_PAGE_BYTES);
+    const std::string slowPage = MarkerBenchmark::MakePage(false, SLOW_PAGE_BYTES);
+
+    auto logger = std::make_shared<Logger>("logs/bench_executor.log");
+    TaskExecutor executor(logger, workers);
+    executor.Start();
+
+    // Ожидание каждой задачи пишется в свою ячейку - без общей блокировки
+    size_t followUps = 0;
+    for (size_t i = 0; i < tasks; i++) {
+        if (i % SLOW_EVERY != 0 && i % FOLLOW_UP_EVERY == 0) {
+            followUps++;
+        }
+    }
+    std::vector<double> waitUs(tasks + followUps, 0.0);
+    std::atomic<size_t> nextFollowUp(tasks);
+    std::atomic<size_t> completed(0);
+    std::atomic<size_t> primaryDone(0);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < tasks; i++) {
+        bool slow = i % SLOW_EVERY == 0;
+        bool followUp = !slow && i % FOLLOW_UP_EVERY == 0;
+        Clock::time_point submitted = Clock::now();
+
+        executor.Submit([&, i, slow, followUp, submitted]() {
+            waitUs[i] = std::chrono::duration<double, std::micro>(Clock::now() - submitted).count();
+            ParsePage(slow ? slowPage : fastPage);
+
+            if (followUp) {
+                size_t slot = nextFollowUp.fetch_add(1);
+                Clock::time_point queued = Clock::now();
+                executor.Submit([&, slot, queued]() {
+                    waitUs[slot] = std::chrono::duration<double, std::micro>(Clock::now() - queued).count();
+                    ParsePage(fastPage);
+                    completed++;
+                });
+            }
+            primaryDone++;
+            completed++;
+        });
+
+        // Как поток завершений event loop: очередь ограничена, ожидание - не от бесконечного бэклога
+        while (i + 1 - primaryDone.load() >= MAX_OUTSTANDING) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    while (completed.load() < waitUs.size()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double elapsedSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Простой: задач нет, worker должны спать
+    double cpuBefore = ProcessCpuMs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SAMPLE_MS));
+    double idleCpuMs = ProcessCpuMs() - cpuBefore;
+
+    ExecutorStats stats = executor.GetStats();
+    executor.Stop();
+
+    ExecutorBenchmarkResult result;
+    result.workers = workers;
+    result.tasksPerSec = static_cast<double>(waitUs.size()) / elapsedSec;
+    result.steals = stats.steals;
+    result.allExecuted = stats.submitted == waitUs.size() && stats.executed == stats.submitted;
+    result.idleCpuPercent = idleCpuMs * 100.0 / IDLE_SAMPLE_MS;
+
+    std::vector<double> fastWaits;
+    std::vector<double> slowWaits;
+    fastWaits.reserve(waitUs.size());
+    for (size_t i = 0; i < waitUs.size(); i++) {
+        if (i < tasks && i % SLOW_EVERY == 0) {
+            slowWaits.push_back(waitUs[i]);
+        } else {
+            fastWaits.push_back(waitUs[i]);
+        }
+    }
+    result.fastP50WaitUs = Percentile(fastWaits, 50);
+    result.fastP99WaitUs = Percentile(fastWaits, 99);
+    result.slowP99WaitUs = Percentile(slowWaits, 99);
+    return result;
+}
+
+
+std::string ExecutorBenchmark::RunComparison(bool& executorHealthy) const {
+    std::vector<ExecutorBenchmarkResult> results;
+    results.push_back(Run(1));
+    if (workerCount > 1) {
+        results.push_back(Run(workerCount));
+    }
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(9) << "workers"
+       << std::right << std::setw(12) << "tasks/s"
+       << std::setw(14) << "fast p50, us"
+       << std::setw(14) << "fast p99, us"
+       << std::setw(14) << "slow p99, us"
+       << std::setw(10) << "steals"
+       << std::setw(10) << "all run"
+       << std::setw(12) << "idle CPU %" << "\n";
+
+    executorHealthy = true;
+    for (const auto& result : results) {
+        executorHealthy = executorHealthy && result.allExecuted && result.idleCpuPercent <= MAX_IDLE_CPU_PERCENT;
+        ss << std::left << std::setw(9) << result.workers
+           << std::right << std::fixed << std::setprecision(0) << std::setw(12) << result.tasksPerSec
+           << std::setprecision(1)
+           << std::setw(14) << result.fastP50WaitUs
+           << std::setw(14) << result.fastP99WaitUs
+           << std::setw(14) << result.slowP99WaitUs
+           << std::setw(10) << result.steals
+           << std::setw(10) << (result.allExecuted ? "yes" : "NO")
+           << std::setw(12) << result.idleCpuPercent << "\n";
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,331 @@
+#include "FailurePolicy.h"
+#include "Constants.h"
+#include <algorithm>
+
+
+namespace {
+    const int MAX_BACKOFF_LEVEL = 20;
+
+    int MillisecondsUntil(std::chrono::steady_clock::time_point now,
+                          std::chrono::steady_clock::time_point until) {
+        if (until <= now) {
+            return 0;
+        }
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(until - now).count();
+        return static_cast<int>(std::max<long long>(1, left));
+    }
+}
+
+
+FailureStats& FailureStats::operator+=(const FailureStats& other) {
+    transient += other.transient;
+    throttled += other.throttled;
+    permanent += other.permanent;
+    fastRetries += other.fastRetries;
+    skipped += other.skipped;
+    breakerOpens += other.breakerOpens;
+    return *this;
+}
+
+
+// ==================== HostBackoff Implementation ====================
+
+HostBackoff::HostBackoff(int baseDelayMs, int maxDelayMs)
+    : baseMs(std::max(1, baseDelayMs)), maxMs(std::max(baseMs, maxDelayMs)) {
+    std::random_device rd;
+    randomGenerator.seed(rd());
+}
+
+
+int HostBackoff::JitterMs(int spanMs) {
+    if (spanMs <= 0) {
+        return 0;
+    }
+    std::uniform_int_distribution<int> jitter(0, spanMs);
+    return jitter(randomGenerator);
+}
+
+
+int HostBackoff::RecordThrottle(const std::string& host) {
+    std::lock_guard<std::mutex> lock(backoffMutex);
+    auto now = std::chrono::steady_clock::now();
+
+    HostState& state = hosts.emplace(host, HostState{0, now, false, now}).first->second;
+    if (now < state.until && !state.probing) {
+        return MillisecondsUntil(now, state.until) + JitterMs(baseMs);
+    }
+
+    // Equal jitter: половина задержки фиксирована, половина случайна
+    long long ceiling = std::min<long long>(maxMs, static_cast<long long>(baseMs) << state.level);
+    int delayMs = static_cast<int>(ceiling - ceiling / 2) + JitterMs(static_cast<int>(ceiling / 2));
+
+    state.level = std::min(state.level + 1, MAX_BACKOFF_LEVEL);
+    state.until = now + std::chrono::milliseconds(delayMs);
+    state.probing = false;
+    return delayMs;
+}
+
+
+void HostBackoff::RecordSuccess(const std::string& host) {
+    std::lock_guard<std::mutex> lock(backoffMutex);
+
+    auto it = hosts.find(host);
+    if (it != hosts.end() && (it->second.probing || std::chrono::steady_clock::now() >= it->second.until)) {
+        hosts.erase(it);
+    }
+}
+
+
+int HostBackoff::Admit(const std::string& host) {
+    std::lock_guard<std::mutex> lock(backoffMutex);
+
+    auto it = hosts.find(host);
+    if (it == hosts.end()) {
+        return 0;
+    }
+
+    HostState& state = it->second;
+    auto now = std::chrono::steady_clock::now();
+    if (now < state.until) {
+        return MillisecondsUntil(now, state.until) + JitterMs(baseMs);
+    }
+
+    // Окно прошло: один пробный запрос, остальные ждут его ответа.
+    // Проба, не вернувшаяся за baseMs (отменена, ушла в transient), уступает место следующей
+    if (state.probing && now < state.probeExpires) {
+        return MillisecondsUntil(now, state.probeExpires) + JitterMs(baseMs);
+    }
+
+    state.probing = true;
+    state.probeExpires = now + std::chrono::milliseconds(baseMs);
+    return 0;
+}
+
+
+size_t HostBackoff::GetBackedOffHosts() const {
+    std::lock_guard<std::mutex> lock(backoffMutex);
+    auto now = std::chrono::steady_clock::now();
+
+    return static_cast<size_t>(std::count_if(hosts.begin(), hosts.end(),
+        [now](const std::pair<const std::string, HostState>& entry) {
+            return entry.second.until > now || entry.second.probing;
+        }));
+}
+
+
+// ==================== FailurePolicy Implementation ====================
+
+FailurePolicy::FailurePolicy(std::shared_ptr<Logger> loggerInstance, std::shared_ptr<HostBackoff> sharedBackoff,
+                             int maxFastRetryCount, int breakerFailureThreshold, int breakerCooldownSeconds,
+                             uint32_t seed)
+    : logger(loggerInstance), hostBackoff(sharedBackoff), maxFastRetries(std::max(0, maxFastRetryCount)),
+      breakerThreshold(std::max(0, breakerFailureThreshold)),
+      breakerCooldownSec(std::max(1, breakerCooldownSeconds)), fastRetriesInRow(0), permanentInRow(0),
+      breaker(BreakerState::CLOSED), currentCooldownSec(breakerCooldownSec), hasRetryAt(false),
+      randomGenerator(seed) {
+}
+
+
+void FailurePolicy::SetHostBackoff(std::shared_ptr<HostBackoff> sharedBackoff) {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    hostBackoff = sharedBackoff;
+}
+
+
+void FailurePolicy::SetRetryIn(std::chrono::steady_clock::time_point now, int delayMs) {
+    hasRetryAt = true;
+    retryAt = now + std::chrono::milliseconds(std::max(0, delayMs));
+}
+
+
+void FailurePolicy::OpenBreaker(std::chrono::steady_clock::time_point now) {
+    breaker = BreakerState::OPEN;
+    breakerUntil = now + std::chrono::seconds(currentCooldownSec);
+    stats.breakerOpens++;
+
+    logger->Warning("Circuit breaker OPEN for " + std::to_string(currentCooldownSec) + "s after " +
+                    std::to_string(permanentInRow) + " permanent failure(s) in a row", "FailurePolicy");
+}
+
+
+bool FailurePolicy::BeforeCheck(const std::string& host) {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    auto now = std::chrono::steady_clock::now();
+    hasRetryAt = false;
+
+    if (breaker == BreakerState::OPEN) {
+        if (now < breakerUntil) {
+            SetRetryIn(now, MillisecondsUntil(now, breakerUntil));
+            stats.skipped++;
+            return false;
+        }
+
+        // Остывание прошло - одна пробная проверка решит, закрывать ли breaker
+        breaker = BreakerState::HALF_OPEN;
+        logger->Info("Circuit breaker HALF-OPEN, sending trial request", "FailurePolicy");
+    }
+
+    int backoffMs = hostBackoff ? hostBackoff->Admit(host) : 0;
+    if (backoffMs > 0) {
+        SetRetryIn(now, backoffMs);
+        stats.skipped++;
+        return false;
+    }
+
+    return true;
+}
+
+
+void FailurePolicy::OnSuccess(const std::string& host) {
+    std::lock_guard<std::mutex> lock(policyMutex);
+
+    fastRetriesInRow = 0;
+    permanentInRow = 0;
+    hasRetryAt = false;
+
+    if (breaker != BreakerState::CLOSED) {
+        breaker = BreakerState::CLOSED;
+        currentCooldownSec = breakerCooldownSec;
+        logger->Success("Circuit breaker closed", "FailurePolicy");
+    }
+
+    if (hostBackoff) {
+        hostBackoff->RecordSuccess(host);
+    }
+}
+
+
+void FailurePolicy::OnFailure(FailureClass failure, const std::string& host) {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    auto now = std::chrono::steady_clock::now();
+    hasRetryAt = false;
+
+    switch (failure) {
+        case FailureClass::TRANSIENT:
+            stats.transient++;
+            // Сбой сети обычно проходит за секунды - не ждем целый интервал
+            if (fastRetriesInRow < maxFastRetries) {
+                fastRetriesInRow++;
+                stats.fastRetries++;
+                std::uniform_int_distribution<int> delay(Constants::RETRY_FAST_MIN_MS,
+                                                         Constants::RETRY_FAST_MAX_MS);
+                SetRetryIn(now, delay(randomGenerator));
+            }
+            break;
+
+        case FailureClass::THROTTLED:
+            stats.throttled++;
+            fastRetriesInRow = 0;
+            if (hostBackoff) {
+                SetRetryIn(now, hostBackoff->RecordThrottle(host));
+            }
+            break;
+
+        case FailureClass::PERMANENT:
+            stats.permanent++;
+            fastRetriesInRow = 0;
+            permanentInRow++;
+
+            if (breaker == BreakerState::HALF_OPEN) {
+                // Пробный запрос не прошел - остываем вдвое дольше
+                currentCooldownSec = std::min(currentCooldownSec * 2,
+                                              std::max(breakerCooldownSec, Constants::BREAKER_MAX_COOLDOWN_SECONDS));
+                OpenBreaker(now);
+            } else if (breakerThreshold > 0 && permanentInRow >= breakerThreshold) {
+                OpenBreaker(now);
+            }
+
+            if (breaker == BreakerState::OPEN) {
+                SetRetryIn(now, MillisecondsUntil(now, breakerUntil));
+            }
+            break;
+
+        case FailureClass::NONE:
+            break;
+    }
+}
+
+
+int FailurePolicy::GetRetryDelayMs() const {
+    std::lock_guard<std::mutex> lock(policyMutex);
+
+    if (!hasRetryAt) {
+        return -1;
+    }
+    return MillisecondsUntil(std::chrono::steady_clock::now(), retryAt);
+}
+
+
+BreakerState FailurePolicy::GetBreakerState() const {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    return breaker;
+}
+
+
+FailureStats FailurePolicy::GetStats() const {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    return stats;
+}
+
+
+FailureClass FailurePolicy::ClassifyTransfer(CURLcode result) {
+    switch (result) {
+        case CURLE_OK:
+            return FailureClass::NONE;
+
+        // Ошибки настройки: повтор даст то же самое
+        case CURLE_UNSUPPORTED_PROTOCOL:
+        case CURLE_URL_MALFORMAT:
+        case CURLE_PEER_FAILED_VERIFICATION:
+        case CURLE_SSL_CERTPROBLEM:
+        case CURLE_SSL_CIPHER:
+        case CURLE_SSL_CACERT_BADFILE:
+        case CURLE_SSL_CRL_BADFILE:
+        case CURLE_SSL_ISSUER_ERROR:
+        case CURLE_SSL_PINNEDPUBKEYNOTMATCH:
+        case CURLE_SSL_ENGINE_NOTFOUND:
+        case CURLE_SSL_ENGINE_SETFAILED:
+        case CURLE_TOO_MANY_REDIRECTS:
+            return FailureClass::PERMANENT;
+
+        // Таймауты, обрывы, DNS, сбой рукопожатия
+        default:
+            return FailureClass::TRANSIENT;
+    }
+}
+
+
+FailureClass FailurePolicy::ClassifyHttp(long httpCode) {
+    if (httpCode == Constants::HTTP_OK) {
+        return FailureClass::NONE;
+    }
+    if (httpCode == 429 || httpCode == 403) {
+        return FailureClass::THROTTLED;
+    }
+    if (httpCode == 408 || httpCode >= 500) {
+        return FailureClass::TRANSIENT;
+    }
+    if (httpCode >= 400) {
+        return FailureClass::PERMANENT;  // 404 - канала нет, 410, 401 ...
+    }
+    return FailureClass::TRANSIENT;
+}
+
+
+const char* FailurePolicy::ClassName(FailureClass failure) {
+    switch (failure) {
+        case FailureClass::TRANSIENT: return "transient";
+        case FailureClass::THROTTLED: return "throttled";
+        case FailureClass::PERMANENT: return "permanent";
+        default:                      return "none";
+    }
+}
+
+
+const char* FailurePolicy::BreakerStateName(BreakerState state) {
+    switch (state) {
+        case BreakerState::OPEN:      return "OPEN";
+        case BreakerState::HALF_OPEN: return "HALF-OPEN";
+        default:                      return "CLOSED";
+    }
+}
@@ -0,0 +1,91 @@
+#include "H2Benchmark.h"
+#include "BenchmarkSupport.h"
+#include "MultiStreamMonitor.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_h2.log";
+const char* BENCH_CHECK_INTERVAL = "5";  // Нижняя граница check_interval в Config::ValidateSettings
+
+
+std::vector<std::string> ChannelNames(size_t channels) {
+    std::vector<std::string> names;
+    names.reserve(channels);
+    for (size_t i = 0; i < channels; i++) {
+        names.push_back("h2_" + std::to_string(i));
+    }
+    return names;
+}
+
+
+std::string FormatLatency(const EngineStats& stats) {
+    return std::to_string(stats.latencyP50Ms) + "/" + std::to_string(stats.latencyP90Ms) + "/" +
+           std::to_string(stats.latencyP99Ms) + "/" + std::to_string(stats.latencyMaxMs);
+}
+
+}
+
+
+H2Benchmark::H2Benchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int durationSeconds)
+    : config(configInstance), channels(std::max<size_t>(1, channelCount)), seconds(std::max(1, durationSeconds)) {
+    BenchmarkSupport::PrepareMonitorConfig(*config, BENCH_LOG_FILE);
+    config->Set("check_interval", BENCH_CHECK_INTERVAL);
+    config->Set("check_interval_fast", BENCH_CHECK_INTERVAL);
+    config->Set("startup_warmup_ms", "0");
+    config->Set("multi_engine", "event_loop");
+    config->Set("use_http2", "true");
+}
+
+
+H2BenchmarkResult H2Benchmark::Run(bool multiplex) const {
+    config->Set("http2_multiplex", multiplex ? "true" : "false");
+
+    MultiStreamMonitor monitor(config);
+    monitor.ApplyStreamerList(ChannelNames(channels));
+
+    monitor.StartAll();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+    H2BenchmarkResult result;
+    result.mode = multiplex ? "multiplex" : "no multiplex";
+    result.stats = monitor.GetEngineStats();
+    monitor.StopAll();
+    return result;
+}
+
+
+std::string H2Benchmark::RunComparison() const {
+    std::vector<H2BenchmarkResult> results;
+    results.push_back(Run(true));
+    results.push_back(Run(false));
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(14) << "mode"
+       << std::right << std::setw(11) << "transfers"
+       << std::setw(13) << "connections"
+       << std::setw(10) << "h2 conn"
+       << std::setw(15) << "streams/conn"
+       << std::setw(12) << "in flight"
+       << std::setw(26) << "latency p50/p90/p99/max" << "\n";
+
+    for (const auto& result : results) {
+        const EngineStats& stats = result.stats;
+        ss << std::left << std::setw(14) << result.mode
+           << std::right << std::setw(11) << stats.transfers
+           << std::setw(13) << stats.connectionsOpened
+           << std::setw(10) << stats.http2ConnectionsOpened
+           << std::fixed << std::setprecision(1) << std::setw(15) << stats.StreamsPerConnection()
+           << std::setw(12) << stats.peakActiveTransfers
+           << std::setw(26) << FormatLatency(stats) + " ms" << "\n";
+    }
+    ss << "\nin flight - peak concurrent transfers; h2 conn = 0 - the stand-in does not speak HTTP/2\n";
+
+    return ss.str();
+}
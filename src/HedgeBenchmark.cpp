@@ -0,0 +1,132 @@
+#include "HedgeBenchmark.h"
+#include "StandInServer.h"
+#include "MonitorContext.h"
+#include "WebScraper.h"
+#include "Logger.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_hedge.log";
+const size_t PAGE_BYTES = 96 * 1024;
+const double STALL_FRACTION = 0.02;  // Меньше 5%: p95 (срок hedge) - по быстрым ответам
+const int STALL_MS = 3000;  // > ADAPTIVE_TIMEOUT_MIN_MS и < timeout по умолчанию
+
+typedef std::chrono::steady_clock Clock;
+
+
+std::string ChannelName(size_t index) {
+    return "hedge_" + std::to_string(index);
+}
+
+}
+
+
+HedgeBenchmark::HedgeBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int checkCount)
+    : config(configInstance), channels(std::max<size_t>(1, channelCount)), checks(std::max(1, checkCount)) {
+    config->Set("use_head_request", "false");
+    config->Set("log_file", BENCH_LOG_FILE);
+}
+
+
+HedgeBenchmarkResult HedgeBenchmark::Run(StandInServer& server, bool hedge, bool adaptiveTimeout) const {
+    config->Set("hedge_requests", hedge ? "true" : "false");
+    config->Set("adaptive_timeout", adaptiveTimeout ? "true" : "false");
+
+    auto logger = std::make_shared<Logger>(BENCH_LOG_FILE);
+    auto context = std::make_shared<MonitorContext>(config, logger);
+
+    std::vector<StreamerId> ids;
+    std::vector<std::unique_ptr<WebScraper>> scrapers;
+    for (size_t i = 0; i < channels; i++) {
+        ids.push_back(context->GetStreamerNames()->Intern(ChannelName(i)));
+        scrapers.push_back(std::make_unique<WebScraper>(context));
+    }
+
+    // Одинаковый порядок зависших ответов для каждого прогона
+    server.SetStall(STALL_FRACTION, STALL_MS);
+
+    // Канал - поток со своим скрапером, как монитор; замеры собираются после join
+    std::vector<std::vector<long long>> durations(channels);
+    std::vector<size_t> failures(channels, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < channels; i++) {
+        threads.emplace_back([&, i]() {
+            durations[i].reserve(static_cast<size_t>(checks));
+            for (int check = 0; check < checks; check++) {
+                auto start = Clock::now();
+                scrapers[i]->CheckStreamStatus(ids[i]);
+                durations[i].push_back(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    Clock::now() - start).count());
+                if (scrapers[i]->GetLastFailure() != FailureClass::NONE) {
+                    failures[i]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    HedgeBenchmarkResult result;
+    result.mode = std::string(hedge ? "hedge" : "-") + " / " + (adaptiveTimeout ? "adaptive" : "-");
+    LatencyWindow window(channels * static_cast<size_t>(checks));
+    for (size_t i = 0; i < channels; i++) {
+        for (long long durationMs : durations[i]) {
+            window.Add(durationMs);
+        }
+        result.failedChecks += failures[i];
+        result.hedgesSent += scrapers[i]->GetHedgesSent();
+        result.hedgesWon += scrapers[i]->GetHedgesWon();
+    }
+    result.latency = window.Summarize();
+    result.checks = result.latency.samples;
+    return result;
+}
+
+
+std::string HedgeBenchmark::RunComparison(bool& standInStarted) const {
+    StandInServer server(PAGE_BYTES);
+    standInStarted = server.Start();
+    if (!standInStarted) {
+        return "stand-in server did not start on 127.0.0.1";
+    }
+    config->Set("twitch_base_url", server.GetBaseUrl());
+
+    std::vector<HedgeBenchmarkResult> results;
+    results.push_back(Run(server, false, false));
+    results.push_back(Run(server, true, false));
+    results.push_back(Run(server, false, true));
+    results.push_back(Run(server, true, true));
+    server.Stop();
+
+    std::ostringstream ss;
+    ss << channels << " channel(s) x " << checks << " check(s), " << STALL_FRACTION * 100 << "% of responses stall "
+       << STALL_MS << " ms, timeout " << config->GetInt("timeout", Constants::DEFAULT_TIMEOUT) << " s\n\n";
+    ss << std::left << std::setw(22) << "hedge / timeout"
+       << std::right << std::setw(10) << "p50, ms"
+       << std::setw(10) << "p99, ms"
+       << std::setw(10) << "max, ms"
+       << std::setw(9) << "failed"
+       << std::setw(16) << "hedges sent"
+       << std::setw(12) << "won" << "\n";
+
+    for (const auto& result : results) {
+        ss << std::left << std::setw(22) << result.mode
+           << std::right << std::setw(10) << result.latency.p50Ms
+           << std::setw(10) << result.latency.p99Ms
+           << std::setw(10) << result.latency.maxMs
+           << std::setw(9) << result.failedChecks
+           << std::setw(16) << result.hedgesSent
+           << std::setw(12) << result.hedgesWon << "\n";
+    }
+
+    return ss.str();
+}
@@ -8,27 +8,31 @@ HumanBehavior::HumanBehavior() {
 }
 
 
+HumanBehavior::HumanBehavior(uint32_t seed) : randomGenerator(seed) {
+}
+
+
 int HumanBehavior::GenerateThinkingDelay() const {
     std::uniform_int_distribution<> dist(500, 2000);
-    return dist(const_cast<std::mt19937&>(randomGenerator));
+    return dist(const_cast<std::minstd_rand&>(randomGenerator));
 }
 
 
 int HumanBehavior::GenerateTypingDelay() const {
     std::uniform_int_distribution<> dist(100, 300);
-    return dist(const_cast<std::mt19937&>(randomGenerator));
+    return dist(const_cast<std::minstd_rand&>(randomGenerator));
 }
 
 
 int HumanBehavior::GenerateMouseMoveDelay() const {
     std::uniform_int_distribution<> dist(50, 150);
-    return dist(const_cast<std::mt19937&>(randomGenerator));
+    return dist(const_cast<std::minstd_rand&>(randomGenerator));
 }
 
 
 int HumanBehavior::GeneratePageLoadWait() const {
     std::uniform_int_distribution<> dist(1000, 3000);
-    return dist(const_cast<std::mt19937&>(randomGenerator));
+    return dist(const_cast<std::minstd_rand&>(randomGenerator));
 }
 
 
@@ -58,7 +62,7 @@ std::string HumanBehavior::GetRandomUserAgent() const {
     };
     
     std::uniform_int_distribution<> dist(0, userAgents.size() - 1);
-    return userAgents[dist(const_cast<std::mt19937&>(randomGenerator))];
+    return userAgents[dist(const_cast<std::minstd_rand&>(randomGenerator))];
 }
 
 
@@ -75,7 +79,7 @@ std::string HumanBehavior::GetRandomAcceptLanguage() const {
     };
     
     std::uniform_int_distribution<> dist(0, languages.size() - 1);
-    return languages[dist(const_cast<std::mt19937&>(randomGenerator))];
+    return languages[dist(const_cast<std::minstd_rand&>(randomGenerator))];
 }
 
 
@@ -91,7 +95,7 @@ std::string HumanBehavior::GetRandomReferer() const {
     };
     
     std::uniform_int_distribution<> dist(0, referers.size() - 1);
-    return referers[dist(const_cast<std::mt19937&>(randomGenerator))];
+    return referers[dist(const_cast<std::minstd_rand&>(randomGenerator))];
 }
 
 
@@ -123,11 +127,27 @@ void HumanBehavior::SimulatePageLoad() const {
 
 void HumanBehavior::RandomDelay(int minMs, int maxMs) const {
     std::uniform_int_distribution<> dist(minMs, maxMs);
-    int delayMs = dist(const_cast<std::mt19937&>(randomGenerator));
+    int delayMs = dist(const_cast<std::minstd_rand&>(randomGenerator));
     std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
 }
 
 
+int HumanBehavior::NextThinkingDelayMs() const {
+    return GenerateThinkingDelay();
+}
+
+
+int HumanBehavior::NextPageLoadWaitMs() const {
+    return GeneratePageLoadWait();
+}
+
+
+int HumanBehavior::NextRandomDelayMs(int minMs, int maxMs) const {
+    std::uniform_int_distribution<> dist(minMs, maxMs);
+    return dist(const_cast<std::minstd_rand&>(randomGenerator));
+}
+
+
 std::string HumanBehavior::GetSessionUserAgent() const {
     // Для всей сессии используем один и тот же User-Agent
     static std::string sessionUA = GetRandomUserAgent();
@@ -160,13 +180,22 @@ std::vector<std::pair<std::string, std::string>> HumanBehavior::GetHumanLikeHead
     
     // Перемешиваем порядок (кроме User-Agent, который всегда первый)
     std::shuffle(headers.begin() + 1, headers.end(), 
-                const_cast<std::mt19937&>(randomGenerator));
+                const_cast<std::minstd_rand&>(randomGenerator));
     
     return headers;
 }
 
 
+size_t HumanBehavior::PickIndex(size_t count) const {
+    if (count == 0) {
+        return 0;
+    }
+    std::uniform_int_distribution<size_t> dist(0, count - 1);
+    return dist(const_cast<std::minstd_rand&>(randomGenerator));
+}
+
+
 bool HumanBehavior::ShouldMakeExtraRequest() const {
     std::uniform_int_distribution<> dist(1, 100);
-    return dist(const_cast<std::mt19937&>(randomGenerator)) <= 20;  // 20% шанс
+    return dist(const_cast<std::minstd_rand&>(randomGenerator)) <= 20;  // 20% шанс
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "LatencyWindow.h"
+#include <algorithm>
+
+
+LatencyWindow::LatencyWindow(size_t windowSize)
+    : capacity(windowSize > 0 ? windowSize : 1), next(0) {
+    samples.reserve(capacity);
+}
+
+
+void LatencyWindow::Add(long long valueMs) {
+    if (samples.size() < capacity) {
+        samples.push_back(valueMs);
+    } else {
+        samples[next] = valueMs;
+    }
+    next = (next + 1) % capacity;
+}
+
+
+void LatencyWindow::Clear() {
+    samples.clear();
+    next = 0;
+}
+
+
+LatencySummary LatencyWindow::Summarize() const {
+    LatencySummary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+
+    // Сортировка - в буфере потока: Summarize идет на каждой проверке и не выделяет память
+    thread_local std::vector<long long> sorted;
+    if (sorted.capacity() < capacity) {
+        sorted.reserve(capacity);  // Сразу на полное окно, а не по мере его заполнения
+    }
+    sorted.assign(samples.begin(), samples.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [](size_t p) {
+        return sorted[(sorted.size() - 1) * p / 100];
+    };
+
+    summary.samples = sorted.size();
+    summary.p50Ms = percentile(50);
+    summary.p90Ms = percentile(90);
+    summary.p95Ms = percentile(95);
+    summary.p99Ms = percentile(99);
+    summary.maxMs = sorted.back();
+    return summary;
+}
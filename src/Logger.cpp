@@ -3,6 +3,8 @@
 #include <iomanip>
 #include <chrono>
 #include <sstream>
+#include <ctime>
+#include <cstdio>
 
 
 Logger::Logger(const std::string& filePath, bool verbose)
@@ -64,7 +66,25 @@ std::string Logger::GetCurrentTimestamp() const {
 }
 
 
-std::string Logger::LogLevelToString(LogLevel level) const {
+void Logger::FormatTimestamp(char* buffer, size_t size) const {
+    auto now = std::chrono::system_clock::now();
+    auto timeT = std::chrono::system_clock::to_time_t(now);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now.time_since_epoch()) % 1000;
+    
+    std::tm localTime{};
+    #ifdef _WIN32
+        localtime_s(&localTime, &timeT);
+    #else
+        localtime_r(&timeT, &localTime);
+    #endif
+    
+    size_t length = std::strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &localTime);
+    std::snprintf(buffer + length, size - length, ".%03d", static_cast<int>(ms.count()));
+}
+
+
+const char* Logger::LogLevelToString(LogLevel level) const {
     switch (level) {
         case LogLevel::DEBUG:       return "DEBUG";
         case LogLevel::INFO:        return "INFO";
@@ -92,10 +112,18 @@ void Logger::Log(const std::string& message, LogLevel level, const std::string&
         return;
     }
     
+    WriteEntry(message.c_str(), level, module.c_str());
+}
+
+
+void Logger::WriteEntry(const char* message, LogLevel level, const char* module) {
+    char timestamp[32];
+    FormatTimestamp(timestamp, sizeof(timestamp));
+    
     std::lock_guard<std::mutex> lock(logMutex);
     
     if (logFile.is_open()) {
-        logFile << "[" << GetCurrentTimestamp() << "] "
+        logFile << "[" << timestamp << "] "
                 << "[" << LogLevelToString(level) << "] "
                 << "[" << module << "] "
                 << message << std::endl;
@@ -107,6 +135,15 @@ void Logger::Log(const std::string& message, LogLevel level, const std::string&
 }
 
 
+void Logger::Log(const char* message, LogLevel level, const char* module) {
+    if (!ShouldLog(level)) {
+        return;
+    }
+    
+    WriteEntry(message, level, module);
+}
+
+
 void Logger::SetVerbose(bool verbose) {
     verboseLogging = verbose;
 }
@@ -154,4 +191,19 @@ void Logger::Event(const std::string& message, const std::string& module) {
 
 void Logger::System(const std::string& message, const std::string& module) {
     Log(message, LogLevel::SYSTEM, module);
-}
\ No newline at end of file
+}
+
+
+void Logger::Debug(const char* message, const char* module) {
+    Log(message, LogLevel::DEBUG, module);
+}
+
+
+void Logger::Info(const char* message, const char* module) {
+    Log(message, LogLevel::INFO, module);
+}
+
+
+void Logger::Warning(const char* message, const char* module) {
+    Log(message, LogLevel::WARNING, module);
+}
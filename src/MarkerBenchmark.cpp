@@ -0,0 +1,160 @@
+#include "MarkerBenchmark.h"
+#include "MarkerMatcher.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+const size_t CHUNK_BYTES = 16 * 1024;  // CURL_MAX_WRITE_SIZE
+const double LIVE_MARKER_POSITION = 0.8;
+const double MIN_ROUND_SECONDS = 0.2;
+
+
+// Прежний путь: WriteCallback дописывает чанк и ищет три live-маркера по всему
+// буферу, после загрузки ParseStreamStatus проходит страницу заново
+bool ScanWithFind(const std::string& page, std::string& buffer, bool& antiBot) {
+    buffer.clear();
+    bool foundMarker = false;
+
+    for (size_t offset = 0; offset < page.size() && !foundMarker; offset += CHUNK_BYTES) {
+        buffer.append(page, offset, CHUNK_BYTES);
+
+        if (buffer.find(Constants::TwitchMarkers::IS_LIVE_BROADCAST) != std::string::npos ||
+            buffer.find(Constants::TwitchMarkers::TYPE_LIVE) != std::string::npos ||
+            buffer.find(Constants::TwitchMarkers::BROADCAST_TYPE) != std::string::npos) {
+            foundMarker = true;
+        }
+    }
+
+    antiBot = buffer.find(Constants::AntiBotKeywords::CLOUDFLARE) != std::string::npos ||
+              buffer.find(Constants::AntiBotKeywords::RECAPTCHA) != std::string::npos;
+
+    if (buffer.find(Constants::TwitchMarkers::IS_LIVE_BROADCAST) != std::string::npos) {
+        return true;
+    }
+    size_t streamPos = buffer.find(Constants::TwitchMarkers::STREAM_SECTION);
+    if (streamPos != std::string::npos) {
+        size_t searchEnd = std::min(streamPos + Constants::STREAM_SECTION_WINDOW, buffer.size());
+        if (buffer.substr(streamPos, searchEnd - streamPos).find(Constants::TwitchMarkers::TYPE_LIVE) != std::string::npos) {
+            return true;
+        }
+    }
+    return buffer.find(Constants::TwitchMarkers::BROADCAST_TYPE) != std::string::npos;
+}
+
+
+bool ScanWithMatcher(const std::string& page, MarkerMatcher& matcher) {
+    matcher.Reset();
+    for (size_t offset = 0; offset < page.size(); offset += CHUNK_BYTES) {
+        matcher.Feed(page.data() + offset, std::min(CHUNK_BYTES, page.size() - offset));
+    }
+    return matcher.IsLive();
+}
+
+
+template <typename Scan>
+MarkerBenchmarkResult Measure(const std::string& pageName, const std::string& method,
+                              const std::string& page, int rounds, Scan scan) {
+    MarkerBenchmarkResult result;
+    result.page = pageName;
+    result.method = method;
+
+    // Страница прогоняется, пока не наберется MIN_ROUND_SECONDS: find() на больших страницах квадратичен
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        double seconds = 0.0;
+        size_t scanned = 0;
+        do {
+            result.live = scan(page);
+            scanned += page.size();
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (seconds < MIN_ROUND_SECONDS);
+
+        result.megabytesPerSecond = std::max(result.megabytesPerSecond,
+                                             static_cast<double>(scanned) / seconds / (1024.0 * 1024.0));
+    }
+    return result;
+}
+
+}
+
+
+MarkerBenchmark::MarkerBenchmark(size_t pageSize, int roundCount)
+    : pageBytes(std::max<size_t>(Constants::MIN_HTML_SIZE, pageSize)), rounds(std::max(1, roundCount)) {
+}
+
+
+std::string MarkerBenchmark::MakePage(bool live, size_t bytes) {
+    std::string page = "<!DOCTYPE html><html><head><title>Twitch</title></head><body><script>window.__STATE__=[";
+    page.reserve(bytes + 256);
+
+    size_t markerAt = static_cast<size_t>(static_cast<double>(bytes) * LIVE_MARKER_POSITION);
+    bool markerPlaced = false;
+
+    for (size_t i = 0; page.size() < bytes; i++) {
+        if (!markerPlaced && page.size() >= markerAt) {
+            page += live ? "{\"__typename\":\"User\",\"stream\":{\"id\":\"4071\",\"type\":\"live\",\"viewersCount\":812}},"
+                         : "{\"__typename\":\"User\",\"stream\":null,\"lastBroadcast\":{\"id\":\"4070\"}},";
+            markerPlaced = true;
+            continue;
+        }
+
+        // Ключи начинаются и кончаются на те же байты, что и маркеры: префильтру есть что отсеивать
+        std::string id = std::to_string(i);
+        page += "{\"__typename\":\"Video\",\"id\":\"" + id + "\",\"type\":\"archive\",\"title\":\"Stream #" + id +
+                "\",\"game\":{\"name\":\"Just Chatting\"},\"isLive\":false,\"streamKey\":null},";
+    }
+
+    page += "]</script></body></html>";
+    return page;
+}
+
+
+std::string MarkerBenchmark::RunComparison(bool& verdictsAgree) const {
+    auto automaton = MarkerAutomaton::GetDefault();
+    MarkerMatcher matcher(automaton, Constants::HTML_TAIL_WINDOW);
+    std::string buffer;
+    buffer.reserve(pageBytes + 1024);
+    bool antiBot = false;
+
+    std::vector<MarkerBenchmarkResult> results;
+    for (bool live : {false, true}) {
+        std::string page = MakePage(live, pageBytes);
+        const char* pageName = live ? "live" : "offline";
+
+        results.push_back(Measure(pageName, "find()", page, rounds,
+                                  [&buffer, &antiBot](const std::string& p) { return ScanWithFind(p, buffer, antiBot); }));
+        results.push_back(Measure(pageName, "aho-corasick", page, rounds,
+                                  [&matcher](const std::string& p) { return ScanWithMatcher(p, matcher); }));
+    }
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(10) << "page"
+       << std::setw(16) << "method"
+       << std::right << std::setw(12) << "MB/s"
+       << std::setw(10) << "verdict" << "\n";
+
+    verdictsAgree = !antiBot;
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        ss << std::left << std::setw(10) << result.page
+           << std::setw(16) << result.method
+           << std::right << std::fixed << std::setprecision(1) << std::setw(12) << result.megabytesPerSecond
+           << std::setw(10) << (result.live ? "live" : "offline") << "\n";
+
+        // Строки парами: find() и автомат на одной странице
+        if (i % 2 == 1 && result.live != results[i - 1].live) {
+            verdictsAgree = false;
+        }
+        if (result.live != (result.page == "live")) {
+            verdictsAgree = false;
+        }
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,287 @@
+#include "MarkerMatcher.h"
+#include "Constants.h"
+#include <queue>
+#include <algorithm>
+#include <stdexcept>
+#include <map>
+#include <mutex>
+
+
+// ==================== MarkerAutomaton Implementation ====================
+
+MarkerAutomaton::MarkerAutomaton(const std::vector<std::string>& patterns) {
+    if (patterns.empty() || patterns.size() > PrefilterTable::MAX_PATTERNS) {
+        throw std::invalid_argument("MarkerAutomaton supports 1-32 patterns");
+    }
+
+    // Бор: -1 = перехода нет (до построения fail-ссылок)
+    std::vector<std::vector<int>> trie(1, std::vector<int>(256, -1));
+    outputs.assign(1, 0);
+
+    for (size_t id = 0; id < patterns.size(); ++id) {
+        const std::string& pattern = patterns[id];
+        if (pattern.empty()) {
+            throw std::invalid_argument("MarkerAutomaton: empty pattern");
+        }
+
+        int node = 0;
+        for (unsigned char c : pattern) {
+            if (trie[node][c] < 0) {
+                trie[node][c] = static_cast<int>(trie.size());
+                trie.emplace_back(256, -1);
+                outputs.push_back(0);
+            }
+            node = trie[node][c];
+        }
+        outputs[node] |= (1u << id);
+        patternLengths.push_back(pattern.size());
+        
+        prefilter.firstBytes[id] = static_cast<unsigned char>(pattern.front());
+        prefilter.lastBytes[id] = static_cast<unsigned char>(pattern.back());
+        prefilter.lastOffsets[id] = pattern.size() - 1;
+        prefilter.maxPatternLength = std::max(prefilter.maxPatternLength, pattern.size());
+    }
+    prefilter.count = patterns.size();
+
+    if (trie.size() > 0xFFFF) {
+        throw std::invalid_argument("MarkerAutomaton: too many states");
+    }
+
+    // BFS: fail-ссылки и полная таблица переходов (DFA)
+    std::vector<int> fail(trie.size(), 0);
+    std::queue<int> queue;
+
+    for (int c = 0; c < 256; ++c) {
+        if (trie[0][c] < 0) {
+            trie[0][c] = 0;
+        } else {
+            fail[trie[0][c]] = 0;
+            queue.push(trie[0][c]);
+        }
+    }
+
+    while (!queue.empty()) {
+        int node = queue.front();
+        queue.pop();
+        outputs[node] |= outputs[fail[node]];
+
+        for (int c = 0; c < 256; ++c) {
+            int next = trie[node][c];
+            if (next < 0) {
+                trie[node][c] = trie[fail[node]][c];
+            } else {
+                fail[next] = trie[fail[node]][c];
+                queue.push(next);
+            }
+        }
+    }
+
+    transitions.resize(trie.size() * 256);
+    for (size_t node = 0; node < trie.size(); ++node) {
+        for (int c = 0; c < 256; ++c) {
+            transitions[(node << 8) | c] = static_cast<uint16_t>(trie[node][c]);
+        }
+    }
+}
+
+
+namespace {
+    // Порядок должен совпадать с MarkerId
+    std::vector<std::string> GetDefaultPatterns() {
+        return {
+            Constants::TwitchMarkers::IS_LIVE_BROADCAST,
+            Constants::TwitchMarkers::TYPE_LIVE,
+            Constants::TwitchMarkers::BROADCAST_TYPE,
+            Constants::TwitchMarkers::STREAM_SECTION,
+            Constants::AntiBotKeywords::CLOUDFLARE,
+            Constants::AntiBotKeywords::RECAPTCHA
+        };
+    }
+}
+
+
+std::shared_ptr<const MarkerAutomaton> MarkerAutomaton::GetDefault() {
+    static const std::shared_ptr<const MarkerAutomaton> instance =
+        std::make_shared<const MarkerAutomaton>(GetDefaultPatterns());
+    return instance;
+}
+
+
+std::shared_ptr<const MarkerAutomaton> MarkerAutomaton::GetWithOfflineEnd(const std::string& offlineEndMarker) {
+    if (offlineEndMarker.empty()) {
+        return GetDefault();
+    }
+    
+    // Все скраперы с одинаковым маркером делят один автомат
+    static std::mutex cacheMutex;
+    static std::map<std::string, std::shared_ptr<const MarkerAutomaton>> cache;
+    
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    
+    auto it = cache.find(offlineEndMarker);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    
+    std::vector<std::string> patterns = GetDefaultPatterns();
+    patterns.push_back(offlineEndMarker);
+    
+    auto automaton = std::make_shared<const MarkerAutomaton>(patterns);
+    cache[offlineEndMarker] = automaton;
+    return automaton;
+}
+
+
+// ==================== MarkerMatcher Implementation ====================
+
+MarkerMatcher::MarkerMatcher(std::shared_ptr<const MarkerAutomaton> automatonInstance,
+                             size_t tailWindowSize)
+    : automaton(automatonInstance), state(0), bytesSeen(0),
+      typeLiveInStreamSection(false), liveFound(false), offlineEndFound(false),
+      verdictOffset(0), tailWindow(tailWindowSize) {
+    Reset();
+}
+
+
+void MarkerMatcher::Reset() {
+    state = 0;
+    bytesSeen = 0;
+    firstMatchEnd.assign(automaton->GetPatternCount(), std::string::npos);
+    typeLiveInStreamSection = false;
+    liveFound = false;
+    offlineEndFound = false;
+    verdictOffset = 0;
+    tail.clear();
+}
+
+
+void MarkerMatcher::ReleaseBuffers() {
+    std::string().swap(tail);
+}
+
+
+void MarkerMatcher::Feed(const char* data, size_t length) {
+    const MarkerAutomaton& dfa = *automaton;
+    const PrefilterTable& table = dfa.GetPrefilter();
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    
+    // Дальше limit последний байт самого длинного маркера выходит за чанк -
+    // эти позиции проходит только автомат, состояние уходит в следующий чанк
+    size_t limit = length >= table.maxPatternLength ? length - table.maxPatternLength + 1 : 0;
+    uint16_t current = state;
+    size_t pos = 0;
+
+    while (pos < length) {
+        // В корне ни одно вхождение не начато: до кандидата автомат остался бы в корне
+        if (current == 0 && pos < limit) {
+            pos = MarkerScanner::FindCandidate(table, bytes, pos, limit);
+            if (pos >= length) {
+                break;
+            }
+        }
+
+        current = dfa.Next(current, bytes[pos]);
+        uint32_t mask = dfa.Output(current);
+        if (mask) {
+            OnMatches(mask, bytesSeen + pos + 1);
+        }
+        ++pos;
+    }
+
+    state = current;
+    bytesSeen += length;
+    AppendTail(data, length);
+}
+
+
+void MarkerMatcher::OnMatches(uint32_t mask, size_t matchEnd) {
+    for (size_t id = 0; mask != 0; ++id, mask >>= 1) {
+        if (!(mask & 1u)) {
+            continue;
+        }
+
+        if (firstMatchEnd[id] == std::string::npos) {
+            firstMatchEnd[id] = matchEnd;
+        }
+
+        switch (static_cast<MarkerId>(id)) {
+            case MarkerId::IS_LIVE_BROADCAST:
+            case MarkerId::BROADCAST_TYPE:
+                MarkLive(matchEnd);
+                break;
+
+            case MarkerId::TYPE_LIVE: {
+                // "type":"live" считается только в первых 500 байтах после "stream":{
+                size_t sectionEnd = firstMatchEnd[static_cast<size_t>(MarkerId::STREAM_SECTION)];
+                if (sectionEnd != std::string::npos) {
+                    size_t sectionStart = sectionEnd -
+                        automaton->GetPatternLength(static_cast<size_t>(MarkerId::STREAM_SECTION));
+                    if (matchEnd <= sectionStart + Constants::STREAM_SECTION_WINDOW) {
+                        typeLiveInStreamSection = true;
+                        MarkLive(matchEnd);
+                    }
+                }
+                break;
+            }
+            
+            case MarkerId::OFFLINE_END:
+                // Конец встроенного состояния без live-маркера - стрим offline
+                if (!IsVerdictDecided()) {
+                    offlineEndFound = true;
+                    verdictOffset = matchEnd;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+
+void MarkerMatcher::MarkLive(size_t matchEnd) {
+    if (!IsVerdictDecided()) {
+        verdictOffset = matchEnd;
+    }
+    liveFound = true;
+}
+
+
+void MarkerMatcher::AppendTail(const char* data, size_t length) {
+    if (tailWindow == 0) {
+        return;
+    }
+    if (tail.capacity() < tailWindow) {
+        tail.reserve(tailWindow);  // Окно - с первой страницы, а не с создания монитора
+    }
+
+    if (length >= tailWindow) {
+        tail.assign(data + length - tailWindow, tailWindow);
+        return;
+    }
+
+    if (tail.size() + length > tailWindow) {
+        tail.erase(0, tail.size() + length - tailWindow);
+    }
+    tail.append(data, length);
+}
+
+
+LiveReason MarkerMatcher::GetLiveReason() const {
+    // Приоритет как у прежнего ParseStreamStatus
+    if (IsFound(MarkerId::IS_LIVE_BROADCAST)) return LiveReason::IS_LIVE_BROADCAST;
+    if (typeLiveInStreamSection)              return LiveReason::TYPE_LIVE;
+    if (IsFound(MarkerId::BROADCAST_TYPE))    return LiveReason::BROADCAST_TYPE;
+    return LiveReason::NONE;
+}
+
+
+bool MarkerMatcher::IsFound(MarkerId id) const {
+    size_t index = static_cast<size_t>(id);
+    return index < firstMatchEnd.size() && firstMatchEnd[index] != std::string::npos;
+}
+
+
+bool MarkerMatcher::IsAntiBotDetected() const {
+    return IsFound(MarkerId::ANTI_BOT_CLOUDFLARE) || IsFound(MarkerId::ANTI_BOT_RECAPTCHA);
+}
@@ -0,0 +1,251 @@
+#include "MarkerScanBenchmark.h"
+#include "MarkerBenchmark.h"
+#include "MarkerMatcher.h"
+#include "MarkerScanner.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+typedef size_t (*FindCandidateFunction)(const PrefilterTable&, const unsigned char*, size_t, size_t);
+
+const size_t SPLIT_PAGE_BYTES = 4096;  // Короткая страница: разрез в каждой позиции
+const size_t CHUNK_BYTES = 16 * 1024;
+const size_t CHUNK_SIZES[] = {1, 2, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 4096, 16 * 1024};
+const char* OFFLINE_END_MARKER = "</script>";
+const double MIN_ROUND_SECONDS = 0.2;
+
+
+FindCandidateFunction KernelFunction(ScanKernel kernel) {
+    switch (kernel) {
+        case ScanKernel::AVX2: return MarkerScanner::FindCandidateAvx2;
+        case ScanKernel::SSE2: return MarkerScanner::FindCandidateSse2;
+        default:               return MarkerScanner::FindCandidateScalar;
+    }
+}
+
+
+std::vector<size_t> Candidates(FindCandidateFunction find, const PrefilterTable& table, const std::string& page) {
+    std::vector<size_t> positions;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(page.data());
+    size_t limit = page.size() >= table.maxPatternLength ? page.size() - table.maxPatternLength + 1 : 0;
+
+    for (size_t pos = find(table, data, 0, limit); pos < limit; pos = find(table, data, pos + 1, limit)) {
+        positions.push_back(pos);
+    }
+    return positions;
+}
+
+
+// Проход префильтра без записи позиций - для замера скорости
+size_t CountCandidates(FindCandidateFunction find, const PrefilterTable& table, const std::string& page) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(page.data());
+    size_t limit = page.size() >= table.maxPatternLength ? page.size() - table.maxPatternLength + 1 : 0;
+
+    size_t count = 0;
+    for (size_t pos = find(table, data, 0, limit); pos < limit; pos = find(table, data, pos + 1, limit)) {
+        count++;
+    }
+    return count;
+}
+
+
+// Все, что MarkerMatcher знает о странице после последнего чанка
+struct Verdict {
+    bool live;
+    bool decided;
+    size_t offset;
+    LiveReason reason;
+    uint32_t found;
+
+    bool operator==(const Verdict& other) const {
+        return live == other.live && decided == other.decided && offset == other.offset &&
+               reason == other.reason && found == other.found;
+    }
+    bool operator!=(const Verdict& other) const { return !(*this == other); }
+};
+
+
+Verdict TakeVerdict(const MarkerMatcher& matcher) {
+    Verdict verdict;
+    verdict.live = matcher.IsLive();
+    verdict.decided = matcher.IsVerdictDecided();
+    verdict.offset = matcher.GetVerdictOffset();
+    verdict.reason = matcher.GetLiveReason();
+    verdict.found = 0;
+    for (size_t id = 0; id < static_cast<size_t>(MarkerId::COUNT); id++) {
+        if (matcher.IsFound(static_cast<MarkerId>(id))) {
+            verdict.found |= 1u << id;
+        }
+    }
+    return verdict;
+}
+
+
+Verdict FeedChunks(MarkerMatcher& matcher, const std::string& page, size_t chunkBytes) {
+    matcher.Reset();
+    for (size_t offset = 0; offset < page.size(); offset += chunkBytes) {
+        matcher.Feed(page.data() + offset, std::min(chunkBytes, page.size() - offset));
+    }
+    return TakeVerdict(matcher);
+}
+
+
+Verdict FeedSplit(MarkerMatcher& matcher, const std::string& page, size_t split) {
+    matcher.Reset();
+    matcher.Feed(page.data(), split);
+    matcher.Feed(page.data() + split, page.size() - split);
+    return TakeVerdict(matcher);
+}
+
+
+// Байт в секунду за лучший из rounds; каждый проход - не короче MIN_ROUND_SECONDS
+template <typename Scan>
+double BestBytesPerSecond(int rounds, Scan scan) {
+    double best = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        double seconds = 0.0;
+        size_t scanned = 0;
+        do {
+            scanned += scan();
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (seconds < MIN_ROUND_SECONDS);
+        best = std::max(best, static_cast<double>(scanned) / seconds);
+    }
+    return best;
+}
+
+}
+
+
+MarkerScanBenchmark::MarkerScanBenchmark(size_t pageSize, int roundCount)
+    : pageBytes(std::max<size_t>(Constants::MIN_HTML_SIZE, pageSize)), rounds(std::max(1, roundCount)) {
+}
+
+
+std::string MarkerScanBenchmark::RunComparison(bool& kernelsAgree) const {
+    std::vector<std::string> pages = {
+        MarkerBenchmark::MakePage(false, pageBytes),
+        MarkerBenchmark::MakePage(true, pageBytes)
+    };
+    std::vector<std::string> splitPages = {
+        MarkerBenchmark::MakePage(false, SPLIT_PAGE_BYTES),
+        MarkerBenchmark::MakePage(true, SPLIT_PAGE_BYTES)
+    };
+    std::vector<std::shared_ptr<const MarkerAutomaton>> automata = {
+        MarkerAutomaton::GetDefault(),
+        MarkerAutomaton::GetWithOfflineEnd(OFFLINE_END_MARKER)
+    };
+
+    ScanKernel savedKernel = MarkerScanner::GetActiveKernel();
+
+    // Эталон: скалярное ядро, страница одним чанком
+    MarkerScanner::SetActiveKernel(ScanKernel::SCALAR);
+    std::vector<std::vector<size_t>> referenceCandidates;
+    std::vector<Verdict> referencePages;
+    std::vector<Verdict> referenceSplitPages;
+    for (const auto& automaton : automata) {
+        MarkerMatcher matcher(automaton, Constants::HTML_TAIL_WINDOW);
+        for (const auto& page : pages) {
+            referenceCandidates.push_back(Candidates(MarkerScanner::FindCandidateScalar, automaton->GetPrefilter(), page));
+            referencePages.push_back(FeedChunks(matcher, page, page.size()));
+        }
+        for (const auto& page : splitPages) {
+            referenceSplitPages.push_back(FeedChunks(matcher, page, page.size()));
+        }
+    }
+
+    std::vector<MarkerScanKernelResult> results;
+    for (ScanKernel kernel : {ScanKernel::SCALAR, ScanKernel::SSE2, ScanKernel::AVX2}) {
+        if (!MarkerScanner::SetActiveKernel(kernel)) {
+            continue;
+        }
+
+        MarkerScanKernelResult result;
+        result.kernel = MarkerScanner::KernelName(kernel);
+        FindCandidateFunction find = KernelFunction(kernel);
+
+        for (size_t a = 0; a < automata.size(); a++) {
+            MarkerMatcher matcher(automata[a], Constants::HTML_TAIL_WINDOW);
+
+            for (size_t p = 0; p < pages.size(); p++) {
+                std::vector<size_t> candidates = Candidates(find, automata[a]->GetPrefilter(), pages[p]);
+                result.candidatesMatch = result.candidatesMatch && candidates == referenceCandidates[a * pages.size() + p];
+                if (a == 0) {
+                    result.candidates += candidates.size();
+                }
+
+                for (size_t chunkBytes : CHUNK_SIZES) {
+                    result.verdictsMatch = result.verdictsMatch &&
+                        FeedChunks(matcher, pages[p], chunkBytes) == referencePages[a * pages.size() + p];
+                    result.splitsChecked++;
+                }
+            }
+
+            for (size_t p = 0; p < splitPages.size(); p++) {
+                const Verdict& reference = referenceSplitPages[a * splitPages.size() + p];
+                for (size_t split = 0; split <= splitPages[p].size(); split++) {
+                    result.verdictsMatch = result.verdictsMatch && FeedSplit(matcher, splitPages[p], split) == reference;
+                    result.splitsChecked++;
+                }
+            }
+        }
+
+        // Скорость - на автомате по умолчанию, как в --multi без offline_end_marker
+        const PrefilterTable& table = automata[0]->GetPrefilter();
+        MarkerMatcher matcher(automata[0], Constants::HTML_TAIL_WINDOW);
+        size_t walked = 0;
+        result.prefilterGbps = BestBytesPerSecond(rounds, [&]() {
+            size_t bytes = 0;
+            for (const auto& page : pages) {
+                walked += CountCandidates(find, table, page);
+                bytes += page.size();
+            }
+            return bytes;
+        }) / 1e9;
+        result.candidatesMatch = result.candidatesMatch && (result.candidates == 0 || walked % result.candidates == 0);
+        result.matcherGbps = BestBytesPerSecond(rounds, [&]() {
+            size_t bytes = 0;
+            for (const auto& page : pages) {
+                FeedChunks(matcher, page, CHUNK_BYTES);
+                bytes += page.size();
+            }
+            return bytes;
+        }) / 1e9;
+
+        results.push_back(result);
+    }
+
+    MarkerScanner::SetActiveKernel(savedKernel);
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(10) << "kernel"
+       << std::right << std::setw(12) << "candidates"
+       << std::setw(10) << "splits"
+       << std::setw(12) << "same cand."
+       << std::setw(12) << "same verd."
+       << std::setw(16) << "prefilter GB/s"
+       << std::setw(16) << "matcher GB/s" << "\n";
+
+    kernelsAgree = true;
+    for (const auto& result : results) {
+        kernelsAgree = kernelsAgree && result.candidatesMatch && result.verdictsMatch;
+        ss << std::left << std::setw(10) << result.kernel
+           << std::right << std::setw(12) << result.candidates
+           << std::setw(10) << result.splitsChecked
+           << std::setw(12) << (result.candidatesMatch ? "yes" : "NO")
+           << std::setw(12) << (result.verdictsMatch ? "yes" : "NO")
+           << std::fixed << std::setprecision(2)
+           << std::setw(16) << result.prefilterGbps
+           << std::setw(16) << result.matcherGbps << "\n";
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,194 @@
+#include "MarkerScanner.h"
+#include "StringUtils.h"
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define MARKER_SCANNER_X86 1
+    #include <immintrin.h>
+#endif
+
+
+namespace MarkerScanner {
+
+namespace {
+    std::atomic<ScanKernel> activeKernel(DetectBestKernel());
+
+    inline bool IsCandidateAt(const PrefilterTable& table, const unsigned char* data, size_t pos) {
+        for (size_t p = 0; p < table.count; ++p) {
+            if (data[pos] == table.firstBytes[p] &&
+                data[pos + table.lastOffsets[p]] == table.lastBytes[p]) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+
+size_t FindCandidateScalar(const PrefilterTable& table, const unsigned char* data,
+                           size_t from, size_t limit) {
+    for (size_t pos = from; pos < limit; ++pos) {
+        if (IsCandidateAt(table, data, pos)) {
+            return pos;
+        }
+    }
+    return limit;
+}
+
+
+#ifdef MARKER_SCANNER_X86
+
+__attribute__((target("sse2")))
+size_t FindCandidateSse2(const PrefilterTable& table, const unsigned char* data,
+                         size_t from, size_t limit) {
+    __m128i firstVec[PrefilterTable::MAX_PATTERNS];
+    __m128i lastVec[PrefilterTable::MAX_PATTERNS];
+
+    for (size_t p = 0; p < table.count; ++p) {
+        firstVec[p] = _mm_set1_epi8(static_cast<char>(table.firstBytes[p]));
+        lastVec[p] = _mm_set1_epi8(static_cast<char>(table.lastBytes[p]));
+    }
+
+    size_t pos = from;
+    for (; pos + 16 <= limit; pos += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i hits = _mm_setzero_si128();
+
+        for (size_t p = 0; p < table.count; ++p) {
+            __m128i tail = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + pos + table.lastOffsets[p]));
+            hits = _mm_or_si128(hits, _mm_and_si128(_mm_cmpeq_epi8(block, firstVec[p]),
+                                                    _mm_cmpeq_epi8(tail, lastVec[p])));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask) {
+            return pos + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+
+    return FindCandidateScalar(table, data, pos, limit);
+}
+
+
+__attribute__((target("avx2")))
+size_t FindCandidateAvx2(const PrefilterTable& table, const unsigned char* data,
+                         size_t from, size_t limit) {
+    __m256i firstVec[PrefilterTable::MAX_PATTERNS];
+    __m256i lastVec[PrefilterTable::MAX_PATTERNS];
+
+    for (size_t p = 0; p < table.count; ++p) {
+        firstVec[p] = _mm256_set1_epi8(static_cast<char>(table.firstBytes[p]));
+        lastVec[p] = _mm256_set1_epi8(static_cast<char>(table.lastBytes[p]));
+    }
+
+    size_t pos = from;
+    for (; pos + 32 <= limit; pos += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        __m256i hits = _mm256_setzero_si256();
+
+        for (size_t p = 0; p < table.count; ++p) {
+            __m256i tail = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + pos + table.lastOffsets[p]));
+            hits = _mm256_or_si256(hits, _mm256_and_si256(_mm256_cmpeq_epi8(block, firstVec[p]),
+                                                          _mm256_cmpeq_epi8(tail, lastVec[p])));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask) {
+            return pos + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+
+    return FindCandidateSse2(table, data, pos, limit);
+}
+
+#else
+
+// Не x86: векторные ядра сводятся к скалярному
+size_t FindCandidateSse2(const PrefilterTable& table, const unsigned char* data,
+                         size_t from, size_t limit) {
+    return FindCandidateScalar(table, data, from, limit);
+}
+
+
+size_t FindCandidateAvx2(const PrefilterTable& table, const unsigned char* data,
+                         size_t from, size_t limit) {
+    return FindCandidateScalar(table, data, from, limit);
+}
+
+#endif
+
+
+size_t FindCandidate(const PrefilterTable& table, const unsigned char* data,
+                     size_t from, size_t limit) {
+    switch (activeKernel.load(std::memory_order_relaxed)) {
+        case ScanKernel::AVX2: return FindCandidateAvx2(table, data, from, limit);
+        case ScanKernel::SSE2: return FindCandidateSse2(table, data, from, limit);
+        default:               return FindCandidateScalar(table, data, from, limit);
+    }
+}
+
+
+bool IsKernelSupported(ScanKernel kernel) {
+#ifdef MARKER_SCANNER_X86
+    __builtin_cpu_init();  // Может вызываться из статической инициализации
+#endif
+
+    switch (kernel) {
+        case ScanKernel::SCALAR:
+            return true;
+#ifdef MARKER_SCANNER_X86
+        case ScanKernel::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case ScanKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+
+ScanKernel DetectBestKernel() {
+    if (IsKernelSupported(ScanKernel::AVX2)) return ScanKernel::AVX2;
+    if (IsKernelSupported(ScanKernel::SSE2)) return ScanKernel::SSE2;
+    return ScanKernel::SCALAR;
+}
+
+
+bool SetActiveKernel(ScanKernel kernel) {
+    if (!IsKernelSupported(kernel)) {
+        return false;
+    }
+    activeKernel = kernel;
+    return true;
+}
+
+
+ScanKernel GetActiveKernel() {
+    return activeKernel.load();
+}
+
+
+const char* KernelName(ScanKernel kernel) {
+    switch (kernel) {
+        case ScanKernel::SCALAR: return "scalar";
+        case ScanKernel::SSE2:   return "sse2";
+        case ScanKernel::AVX2:   return "avx2";
+        default:                 return "unknown";
+    }
+}
+
+
+bool ParseKernelName(const std::string& name, ScanKernel& kernel) {
+    std::string lowerName = StringUtils::ToLower(name);
+
+    if (lowerName == "scalar") { kernel = ScanKernel::SCALAR; return true; }
+    if (lowerName == "sse2")   { kernel = ScanKernel::SSE2;   return true; }
+    if (lowerName == "avx2")   { kernel = ScanKernel::AVX2;   return true; }
+    if (lowerName == "auto")   { kernel = DetectBestKernel(); return true; }
+    return false;
+}
+
+} // namespace MarkerScanner
@@ -0,0 +1,202 @@
+#include "MemoryReport.h"
+#include "MonitorRegistry.h"
+#include "StreamMonitor.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+    #include <unistd.h>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    #include <malloc.h>
+    #define MEMORY_REPORT_MALLINFO2
+#endif
+
+
+namespace {
+
+const size_t MAX_SAMPLE = 1000;           // Экземпляров подсистемы на замер
+const size_t PROJECTED_CHANNELS = 100000;
+const size_t SYNTHETIC_PAGE_BYTES = 64 * 1024;
+
+
+// Средний прирост кучи на экземпляр: create(i) возвращает владеющий указатель
+template <typename Factory>
+long long HeapPerInstance(size_t count, Factory create) {
+    std::vector<decltype(create(size_t(0)))> items;
+    items.reserve(count);
+
+    long long before = MemoryUsage::Current().heapBytes;
+    for (size_t i = 0; i < count; i++) {
+        items.push_back(create(i));
+    }
+    long long after = MemoryUsage::Current().heapBytes;
+
+    if (before < 0 || count == 0) {
+        return -1;
+    }
+    return (after - before) / static_cast<long long>(count);
+}
+
+
+std::string SampleName(const char* prefix, size_t i) {
+    return std::string(prefix) + std::to_string(i);
+}
+
+
+void AppendRow(std::ostringstream& ss, const std::string& label, long long bytes) {
+    ss << "  " << std::left << std::setw(40) << label << std::right << std::setw(10);
+    if (bytes < 0) {
+        ss << "n/a";
+    } else {
+        ss << bytes;
+    }
+    ss << "\n";
+}
+
+}
+
+
+MemoryUsage MemoryUsage::Current() {
+    MemoryUsage usage;
+
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    long sizePages = 0;
+    long residentPages = 0;
+    if (statm >> sizePages >> residentPages) {
+        usage.rssKb = residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+#endif
+
+#ifdef MEMORY_REPORT_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    usage.heapBytes = static_cast<long long>(info.uordblks + info.hblkhd);
+#endif
+
+    return usage;
+}
+
+
+MemoryReport::MemoryReport(std::shared_ptr<MonitorContext> contextInstance, size_t channelCount)
+    : context(contextInstance), channels(std::max<size_t>(1, channelCount)),
+      sampleSize(std::min(MAX_SAMPLE, std::max<size_t>(1, channelCount))) {
+}
+
+
+std::string MemoryReport::Run() {
+    const Config& config = context->GetConfig();
+    bool memoryBudget = context->IsMemoryBudget();
+    std::ostringstream ss;
+
+    // Первый монитор инициализирует libcurl, общий кэш соединений и автоматы маркеров - не в счет
+    auto warmup = std::make_shared<StreamMonitor>("memreport_warmup", context);
+
+    ss << "memory_budget: " << (memoryBudget ? "on" : "off") << ", sample: " << sampleSize << " instance(s)\n\n";
+    ss << "  " << std::left << std::setw(40) << "subsystem" << std::right << std::setw(10) << "heap, B" << "\n";
+
+    AppendRow(ss, "StreamMonitor (whole channel)", HeapPerInstance(sampleSize, [this](size_t i) {
+        return std::make_shared<StreamMonitor>(SampleName("memreport_m", i), context);
+    }));
+
+    AppendRow(ss, "  WebScraper", HeapPerInstance(sampleSize, [this](size_t) {
+        return std::make_unique<WebScraper>(context);
+    }));
+
+    AppendRow(ss, "  Statistics", HeapPerInstance(sampleSize, [memoryBudget](size_t i) {
+        std::string name = SampleName("memreport_s", i);
+        auto statistics = std::make_unique<Statistics>(name, StreamerNameTable::StatsPathFor(name));
+        if (memoryBudget) {
+            statistics->ReleaseSessions();
+        }
+        return statistics;
+    }));
+
+    AppendRow(ss, "  PollPredictor", HeapPerInstance(sampleSize, [this, &config](size_t) {
+        return std::make_unique<PollPredictor>(
+            context->GetPollBudget(),
+            config.GetInt("check_interval_fast", Constants::FAST_CHECK_INTERVAL),
+            config.GetInt("poll_max_interval", Constants::POLL_MAX_INTERVAL), 0);
+    }));
+
+    AppendRow(ss, "  FailurePolicy", HeapPerInstance(sampleSize, [this, &config](size_t) {
+        return std::make_unique<FailurePolicy>(
+            context->GetLogger(), context->GetHostBackoff(),
+            config.GetInt("retry_fast_max", Constants::RETRY_FAST_MAX),
+            config.GetInt("breaker_threshold", Constants::BREAKER_THRESHOLD),
+            config.GetInt("breaker_cooldown", Constants::BREAKER_COOLDOWN_SECONDS),
+            context->NextSeed());
+    }));
+
+    AppendRow(ss, "  Notification + BrowserController", HeapPerInstance(sampleSize, [this](size_t) {
+        return std::make_pair(std::make_unique<Notification>(false),
+                              std::make_unique<BrowserController>(context->GetLogger(), false));
+    }));
+
+    // Хвост страницы для диагностики появляется с первой загрузкой; memory_budget отдает его после вердикта
+    {
+        std::string page(SYNTHETIC_PAGE_BYTES, 'x');
+        std::vector<std::unique_ptr<MarkerMatcher>> matchers;
+        for (size_t i = 0; i < sampleSize; i++) {
+            matchers.push_back(std::make_unique<MarkerMatcher>(
+                MarkerAutomaton::GetWithOfflineEnd(config.GetString("offline_end_marker", "")),
+                Constants::HTML_TAIL_WINDOW));
+        }
+
+        long long before = MemoryUsage::Current().heapBytes;
+        for (auto& matcher : matchers) {
+            matcher->Feed(page.data(), page.size());
+            if (memoryBudget) {
+                matcher->ReleaseBuffers();
+            }
+        }
+        long long after = MemoryUsage::Current().heapBytes;
+        AppendRow(ss, "  + page tail after a check", before < 0 ? -1 : (after - before) / static_cast<long long>(sampleSize));
+    }
+
+    AppendRow(ss, memoryBudget ? "curl easy handle (per check in flight)" : "curl easy handle (in WebScraper)",
+              HeapPerInstance(sampleSize, [](size_t) { return std::make_unique<CurlHandle>(); }));
+
+    // N полных каналов одной версией реестра, как LoadStreamersFromFile в --multi
+    MonitorRegistry registry;
+    MemoryUsage before = MemoryUsage::Current();
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::shared_ptr<MonitorInfo>> infos;
+        infos.reserve(channels);
+        for (size_t i = 0; i < channels; i++) {
+            std::string name = SampleName("memreport_c", i);
+            infos.push_back(std::make_shared<MonitorInfo>(name, std::make_shared<StreamMonitor>(name, context)));
+        }
+
+        std::vector<std::shared_ptr<MonitorInfo>> removed;
+        std::vector<std::shared_ptr<MonitorInfo>> added;
+        registry.Apply({}, infos, removed, added);
+    }
+    double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    MemoryUsage after = MemoryUsage::Current();
+
+    double count = static_cast<double>(channels);
+    ss << "\n" << channels << " channel(s) in the registry, " << std::fixed << std::setprecision(1)
+       << elapsedUs / count << " us per channel\n";
+    if (before.heapBytes >= 0) {
+        ss << "  heap: " << static_cast<double>(after.heapBytes - before.heapBytes) / count << " B per channel, "
+           << static_cast<double>(after.heapBytes) / (1024.0 * 1024.0) << " MB total\n";
+    }
+    if (before.rssKb >= 0) {
+        double perChannelKb = static_cast<double>(after.rssKb - before.rssKb) / count;
+        ss << "  RSS:  " << perChannelKb * 1024.0 << " B per channel, "
+           << static_cast<double>(after.rssKb) / 1024.0 << " MB total\n";
+        ss << "  RSS projected for " << PROJECTED_CHANNELS << " channels: "
+           << (static_cast<double>(before.rssKb) + perChannelKb * PROJECTED_CHANNELS) / 1024.0 << " MB\n";
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,82 @@
+#include "MonitorContext.h"
+#include "HumanBehavior.h"
+#include "Constants.h"
+#include <random>
+#include <filesystem>
+
+
+MonitorContext::MonitorContext(std::shared_ptr<Config> configInstance, std::shared_ptr<Logger> loggerInstance,
+                               bool standaloneMonitor)
+    : config(configInstance), logger(loggerInstance), standalone(standaloneMonitor),
+      memoryBudget(configInstance->GetBool("memory_budget", false)), seedCounter(0) {
+
+    std::random_device rd;
+    seedBase = (static_cast<uint64_t>(rd()) << 32) | rd();
+
+    EnsureDirectories();
+    BuildHeaderVariants();
+
+    hostBackoff = std::make_shared<HostBackoff>(
+        config->GetInt("backoff_base_ms", Constants::BACKOFF_BASE_MS),
+        config->GetInt("backoff_max_ms", Constants::BACKOFF_MAX_MS));
+
+    pollBudget = std::make_shared<PollBudget>(
+        config->GetInt("poll_budget_per_minute", 0),
+        config->GetInt("check_interval", Constants::DEFAULT_CHECK_INTERVAL));
+
+    stateTable = std::make_shared<ChannelStateTable>();
+    streamerNames = std::make_shared<StreamerNameTable>(
+        config->GetString("twitch_base_url", Constants::TWITCH_BASE_URL));
+}
+
+
+MonitorContext::~MonitorContext() {
+    for (struct curl_slist* headers : headerVariants) {
+        curl_slist_free_all(headers);
+    }
+}
+
+
+std::shared_ptr<MonitorContext> MonitorContext::CreateStandalone(const std::string& configPath) {
+    auto logger = std::make_shared<Logger>("logs/stream_monitor.log");
+    auto config = std::make_shared<Config>(configPath);
+    if (!config->Load()) {
+        logger->Warning("Failed to load config, using defaults", "StreamMonitor");
+    }
+    logger->SetVerbose(config->GetBool("verbose_logging", false));
+    logger->Info("Configuration loaded from: " + configPath, "StreamMonitor");
+
+    return std::make_shared<MonitorContext>(config, logger, true);
+}
+
+
+void MonitorContext::EnsureDirectories() {
+    std::error_code error;
+    std::filesystem::create_directories("logs", error);
+    std::filesystem::create_directories("stats", error);
+}
+
+
+uint32_t MonitorContext::NextSeed() {
+    uint64_t z = seedBase + (seedCounter.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+
+
+void MonitorContext::BuildHeaderVariants() {
+    HumanBehavior humanBehavior(NextSeed());
+    headerVariants.reserve(Constants::HEADER_VARIANTS);
+
+    for (int i = 0; i < Constants::HEADER_VARIANTS; ++i) {
+        struct curl_slist* headers = nullptr;
+
+        for (const auto& header : humanBehavior.GetHumanLikeHeaders()) {
+            std::string headerStr = header.first + ": " + header.second;
+            headers = curl_slist_append(headers, headerStr.c_str());
+        }
+
+        headerVariants.push_back(headers);
+    }
+}
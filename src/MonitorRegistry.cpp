@@ -0,0 +1,122 @@
+#include "MonitorRegistry.h"
+
+
+std::shared_ptr<MonitorInfo> MonitorSnapshot::Find(std::string_view streamerName) const {
+    auto it = index.find(streamerName);
+    return it == index.end() ? nullptr : monitors[it->second];
+}
+
+
+MonitorRegistry::MonitorRegistry() : current(std::make_shared<const MonitorSnapshot>()) {
+}
+
+
+std::shared_ptr<const MonitorSnapshot> MonitorRegistry::GetSnapshot() const {
+    return std::atomic_load_explicit(&current, std::memory_order_acquire);
+}
+
+
+std::shared_ptr<MonitorInfo> MonitorRegistry::Find(std::string_view streamerName) const {
+    return GetSnapshot()->Find(streamerName);
+}
+
+
+size_t MonitorRegistry::Size() const {
+    return GetSnapshot()->monitors.size();
+}
+
+
+std::shared_ptr<MonitorSnapshot> MonitorRegistry::CopyCurrent() const {
+    auto next = std::make_shared<MonitorSnapshot>(*GetSnapshot());
+    next->version++;
+    return next;
+}
+
+
+void MonitorRegistry::Publish(std::shared_ptr<MonitorSnapshot> next) {
+    std::shared_ptr<const MonitorSnapshot> published = std::move(next);
+    std::atomic_store_explicit(&current, published, std::memory_order_release);
+}
+
+
+bool MonitorRegistry::Insert(MonitorSnapshot& snapshot, std::shared_ptr<MonitorInfo> info) {
+    std::string_view key = info->streamerName;
+    if (snapshot.index.count(key) != 0) {
+        return false;
+    }
+
+    snapshot.monitors.push_back(std::move(info));
+    snapshot.index.emplace(key, snapshot.monitors.size() - 1);
+    return true;
+}
+
+
+std::shared_ptr<MonitorInfo> MonitorRegistry::Erase(MonitorSnapshot& snapshot, std::string_view streamerName) {
+    auto it = snapshot.index.find(streamerName);
+    if (it == snapshot.index.end()) {
+        return nullptr;
+    }
+
+    size_t position = it->second;
+    std::shared_ptr<MonitorInfo> erased = snapshot.monitors[position];
+    snapshot.index.erase(it);
+
+    // На место удаленного - последний, порядок остальных не важен
+    if (position + 1 != snapshot.monitors.size()) {
+        snapshot.monitors[position] = std::move(snapshot.monitors.back());
+        snapshot.index[snapshot.monitors[position]->streamerName] = position;
+    }
+    snapshot.monitors.pop_back();
+    return erased;
+}
+
+
+bool MonitorRegistry::Add(std::shared_ptr<MonitorInfo> info) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    auto next = CopyCurrent();
+    if (!Insert(*next, std::move(info))) {
+        return false;
+    }
+
+    Publish(std::move(next));
+    return true;
+}
+
+
+std::shared_ptr<MonitorInfo> MonitorRegistry::Remove(std::string_view streamerName) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    auto next = CopyCurrent();
+    auto erased = Erase(*next, streamerName);
+    if (erased) {
+        Publish(std::move(next));
+    }
+    return erased;
+}
+
+
+void MonitorRegistry::Apply(const std::vector<std::string>& removeNames,
+                            const std::vector<std::shared_ptr<MonitorInfo>>& addInfos,
+                            std::vector<std::shared_ptr<MonitorInfo>>& removed,
+                            std::vector<std::shared_ptr<MonitorInfo>>& added) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    auto next = CopyCurrent();
+    for (const auto& name : removeNames) {
+        if (auto erased = Erase(*next, name)) {
+            removed.push_back(std::move(erased));
+        }
+    }
+
+    next->monitors.reserve(next->monitors.size() + addInfos.size());
+    for (const auto& info : addInfos) {
+        if (Insert(*next, info)) {
+            added.push_back(info);
+        }
+    }
+
+    if (!removed.empty() || !added.empty()) {
+        Publish(std::move(next));
+    }
+}
@@ -1,24 +1,90 @@
 #include "MultiStreamMonitor.h"
 #include "StringUtils.h"
 #include "Constants.h"
+#include "StreamerList.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
 #include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_set>
+
+
+namespace {
+    // Основной и hedge-запрос одной передачи. Живет только в потоке event loop
+    struct TransferRace {
+        CURL* primary = nullptr;
+        CURL* hedge = nullptr;
+        bool primaryDone = false;
+        bool hedgeDone = false;
+        bool finished = false;
+    };
+    
+    std::shared_ptr<Config> LoadConfig(const std::string& configPath) {
+        auto config = std::make_shared<Config>(configPath);
+        config->Load();
+        return config;
+    }
+}
 
 
 MultiStreamMonitor::MultiStreamMonitor(const std::string& configPath)
-    : isRunning(false) {
-    
-    config = std::make_shared<Config>(configPath);
-    config->Load();
+    : MultiStreamMonitor(LoadConfig(configPath)) {
+}
+
+
+MultiStreamMonitor::MultiStreamMonitor(std::shared_ptr<Config> configInstance)
+    : config(configInstance), isRunning(false), useEventLoop(true) {
     
     logger = std::make_shared<Logger>(
         config->GetString("log_file", Constants::DEFAULT_LOG_FILE),
         config->GetBool("verbose_logging", false)
     );
     
-    logger->System("Multi-Stream Monitor initialized", "MultiStreamMonitor");
+    // Конфиг, лог, seed и заголовки запросов мониторов - эти же, а не свои у каждого
+    context = std::make_shared<MonitorContext>(config, logger);
+    
+    // event_loop (по умолчанию) или threads (пул worker_threads с планировщиком дедлайнов)
+    useEventLoop = StringUtils::ToLower(config->GetString("multi_engine", "event_loop")) != "threads";
+    if (!useEventLoop) {
+        scheduler = std::make_unique<CheckScheduler>(
+            logger,
+            static_cast<size_t>(std::max(1, config->GetInt("worker_threads", Constants::DEFAULT_WORKER_THREADS))),
+            config->GetInt("check_jitter_ms", Constants::REQUEST_INTERVAL_JITTER_MS),
+            StringUtils::ToLower(config->GetString("scheduler_backend", "wheel")));
+    }
+    if (useEventLoop) {
+        engine = std::make_unique<CurlMultiEngine>(logger);
+        
+        if (config->GetBool("use_http2", true) && config->GetBool("http2_multiplex", true)) {
+            engine->ConfigureMultiplexing(
+                std::max(1, config->GetInt("http2_max_connections", Constants::HTTP2_MAX_CONNECTIONS)),
+                std::max(1, config->GetInt("http2_max_streams", Constants::HTTP2_MAX_STREAMS)));
+        }
+    }
+    
+    // 0 = по числу ядер
+    executor = std::make_shared<TaskExecutor>(
+        logger, static_cast<size_t>(std::max(0, config->GetInt("executor_threads", Constants::DEFAULT_EXECUTOR_THREADS))));
+    
+    rateLimiter = std::make_shared<RateLimiter>(
+        logger,
+        config->GetInt("rate_limit_rps", Constants::RATE_LIMIT_RPS),
+        config->GetInt("rate_limit_burst", Constants::RATE_LIMIT_BURST),
+        config->GetInt("max_inflight_per_host", Constants::MAX_INFLIGHT_PER_HOST),
+        config->GetInt("rate_limit_max_wait_ms", Constants::RATE_LIMIT_MAX_WAIT_MS));
+    
+    hostBackoff = context->GetHostBackoff();
+    pollBudget = context->GetPollBudget();
+    
+    if (config->GetBool("share_connections", true)) {
+        curlShare = CurlShare::Acquire();
+    }
+    
+    logger->System("Multi-Stream Monitor initialized (engine: " + 
+                   std::string(useEventLoop ? "event_loop" : "threads") + ")", "MultiStreamMonitor");
 }
 
 
@@ -28,21 +94,34 @@ MultiStreamMonitor::~MultiStreamMonitor() {
 }
 
 
-void MultiStreamMonitor::MonitorThreadFunction(StreamMonitor* monitor) {
-    try {
-        logger->Info("Starting monitor thread for: " + monitor->GetStreamerName(), 
-                    "MultiStreamMonitor");
-        monitor->StartMonitoring();
-    } catch (const std::exception& e) {
-        logger->Error("Error in monitor thread: " + std::string(e.what()), 
-                     "MultiStreamMonitor");
+int MultiStreamMonitor::RunPooledCheck(std::shared_ptr<StreamMonitor> monitor) {
+    if (monitor->IsStopped()) {
+        return -1;
     }
+    
+    monitor->RunCheckOnce();
+    
+    return monitor->IsStopped() ? -1 : NextCheckDelayMs(*monitor);
+}
+
+
+std::shared_ptr<MonitorInfo> MultiStreamMonitor::CreateMonitor(const std::string& streamerName) {
+    auto monitor = std::make_shared<StreamMonitor>(streamerName, context);
+    monitor->SetEventExecutor(executor);
+    monitor->SetRateLimiter(rateLimiter);
+    return std::make_shared<MonitorInfo>(streamerName, monitor);
+}
+
+
+std::shared_ptr<MonitorInfo> MultiStreamMonitor::CreateMonitor(StreamerId streamerId) {
+    auto monitor = std::make_shared<StreamMonitor>(streamerId, context);
+    monitor->SetEventExecutor(executor);
+    monitor->SetRateLimiter(rateLimiter);
+    return std::make_shared<MonitorInfo>(monitor->GetStreamerName(), monitor);
 }
 
 
 bool MultiStreamMonitor::AddStreamer(const std::string& streamerName) {
-    std::lock_guard<std::mutex> lock(monitorsMutex);
-    
     // Валидация имени стримера
     if (!StringUtils::IsValidStreamerName(streamerName)) {
         logger->Error("Invalid streamer name: " + streamerName, "MultiStreamMonitor");
@@ -50,23 +129,31 @@ bool MultiStreamMonitor::AddStreamer(const std::string& streamerName) {
         return false;
     }
     
-    // Проверка на дубликаты
-    for (const auto& info : monitors) {
-        if (info.streamerName == streamerName) {
-            logger->Warning("Streamer " + streamerName + " already being monitored", 
-                           "MultiStreamMonitor");
-            std::cerr << "Streamer " << streamerName << " is already being monitored" << std::endl;
-            return false;
-        }
+    auto reportDuplicate = [this, &streamerName]() {
+        logger->Warning("Streamer " + streamerName + " already being monitored", 
+                       "MultiStreamMonitor");
+        std::cerr << "Streamer " << streamerName << " is already being monitored" << std::endl;
+        return false;
+    };
+    
+    // Проверка на дубликаты - поиск по индексу снапшота
+    if (registry.Find(streamerName)) {
+        return reportDuplicate();
     }
     
     try {
-        MonitorInfo info;
-        info.streamerName = streamerName;
-        info.monitor = std::make_unique<StreamMonitor>(streamerName, "config.ini");
-        info.isRunning = false;
+        // Конструктор читает конфиг и статистику - без блокировок, чтобы не держать остальные операции
+        std::shared_ptr<MonitorInfo> info = CreateMonitor(streamerName);
+        
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        if (!registry.Add(info)) {
+            return reportDuplicate();
+        }
         
-        monitors.push_back(std::move(info));
+        // Система уже работает - первая проверка сразу, без ожидания StartAll
+        if (isRunning.load()) {
+            StartMonitor(*info, info->monitor->GetPacingDelayMs());
+        }
         
         logger->Success("Added streamer: " + streamerName, "MultiStreamMonitor");
         std::cout << "Added streamer: " << streamerName << std::endl;
@@ -81,32 +168,31 @@ bool MultiStreamMonitor::AddStreamer(const std::string& streamerName) {
 }
 
 
+void MultiStreamMonitor::StopMonitor(MonitorInfo& info) {
+    // Graceful остановка (monitor освободят callbacks event loop / задача пула)
+    if (info.isRunning.exchange(false) && info.monitor) {
+        info.monitor->Stop();
+        
+        uint64_t scheduleId = info.scheduleId.exchange(0);
+        if (scheduler && scheduleId != 0) {
+            scheduler->Cancel(scheduleId);
+        }
+    }
+}
+
+
 bool MultiStreamMonitor::RemoveStreamer(const std::string& streamerName) {
-    std::lock_guard<std::mutex> lock(monitorsMutex);
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
     
-    auto it = std::find_if(monitors.begin(), monitors.end(),
-        [&streamerName](const MonitorInfo& info) {
-            return info.streamerName == streamerName;
-        });
-    
-    if (it == monitors.end()) {
+    std::shared_ptr<MonitorInfo> info = registry.Remove(streamerName);
+    if (!info) {
         logger->Warning("Streamer " + streamerName + " not found", "MultiStreamMonitor");
         std::cerr << "Streamer " << streamerName << " not found" << std::endl;
         return false;
     }
     
-    // Graceful остановка потока
-    if (it->isRunning && it->monitor) {
-        logger->Info("Stopping monitor for: " + streamerName, "MultiStreamMonitor");
-        it->monitor->Stop();
-        
-        if (it->thread && it->thread->joinable()) {
-            logger->Debug("Waiting for thread to finish: " + streamerName, "MultiStreamMonitor");
-            it->thread->join();
-        }
-    }
-    
-    monitors.erase(it);
+    logger->Info("Stopping monitor for: " + streamerName, "MultiStreamMonitor");
+    StopMonitor(*info);
     
     logger->Success("Removed streamer: " + streamerName, "MultiStreamMonitor");
     std::cout << "Removed streamer: " << streamerName << std::endl;
@@ -115,21 +201,194 @@ bool MultiStreamMonitor::RemoveStreamer(const std::string& streamerName) {
 
 
 std::vector<std::string> MultiStreamMonitor::GetStreamers() const {
-    std::lock_guard<std::mutex> lock(monitorsMutex);
+    auto snapshot = registry.GetSnapshot();
     
     std::vector<std::string> streamers;
-    streamers.reserve(monitors.size());
+    streamers.reserve(snapshot->monitors.size());
     
-    for (const auto& info : monitors) {
-        streamers.push_back(info.streamerName);
+    for (const auto& info : snapshot->monitors) {
+        streamers.push_back(info->streamerName);
     }
     
     return streamers;
 }
 
 
+unsigned long long MultiStreamMonitor::GetCheckCount() const {
+    auto snapshot = registry.GetSnapshot();
+    
+    unsigned long long checks = 0;
+    for (const auto& info : snapshot->monitors) {
+        checks += info->monitor->GetCheckCount();
+    }
+    return checks;
+}
+
+
+size_t MultiStreamMonitor::GetCheckedMonitorCount() const {
+    auto snapshot = registry.GetSnapshot();
+    return static_cast<size_t>(std::count_if(snapshot->monitors.begin(), snapshot->monitors.end(),
+        [](const std::shared_ptr<MonitorInfo>& info) { return info->monitor->GetCheckCount() > 0; }));
+}
+
+
+EngineStats MultiStreamMonitor::GetEngineStats() const {
+    return engine ? engine->GetStats() : EngineStats();
+}
+
+
+LatencySummary MultiStreamMonitor::GetSchedulingLag() const {
+    if (engine) {
+        return engine->GetStats().timerLag;
+    }
+    return scheduler ? scheduler->GetStats().lag : LatencySummary();
+}
+
+
+void MultiStreamMonitor::ResetSchedulingLag() {
+    if (engine) {
+        engine->ResetTimerLag();
+    } else if (scheduler) {
+        scheduler->ResetLag();
+    }
+}
+
+
+int MultiStreamMonitor::NextCheckDelayMs(StreamMonitor& monitor) {
+    // После ошибки - пауза FailurePolicy (быстрый повтор, backoff хоста, breaker)
+    int retryMs = monitor.GetRetryDelayMs();
+    if (retryMs >= 0) {
+        return retryMs;
+    }
+    
+    // Интервал + пауза HumanBehavior: таймер event loop вместо sleep в проверке
+    return monitor.GetCurrentCheckInterval() * 1000 + monitor.GetPacingDelayMs();
+}
+
+
+void MultiStreamMonitor::ScheduleCheck(std::shared_ptr<StreamMonitor> monitor, int delayMs) {
+    engine->ScheduleAfter(delayMs, [this, monitor]() {
+        RunAsyncCheck(monitor);
+    });
+}
+
+
+void MultiStreamMonitor::RunAsyncCheck(std::shared_ptr<StreamMonitor> monitor) {
+    if (monitor->IsStopped()) {
+        return;
+    }
+    
+    if (!monitor->BeginAsyncCheck()) {
+        ScheduleCheck(monitor, NextCheckDelayMs(*monitor));
+        return;
+    }
+    
+    // Handle первой фазы - по разрешению лимитера: в очереди проверка памяти не держит
+    SubmitTransfer(monitor, nullptr);
+}
+
+
+void MultiStreamMonitor::SubmitTransfer(std::shared_ptr<StreamMonitor> monitor, CURL* easy) {
+    std::string host = monitor->GetRequestHost();
+    
+    // В event loop handle попадает только с токеном лимитера
+    rateLimiter->Submit(host, [this, monitor, easy, host](bool granted) {
+        if (!granted) {
+            DeferCheck(monitor);
+            return;
+        }
+        
+        CURL* transfer = easy ? easy : monitor->StartAsyncTransfer();
+        if (!transfer) {
+            rateLimiter->Release(host);
+            ScheduleCheck(monitor, NextCheckDelayMs(*monitor));
+            return;
+        }
+        
+        auto race = std::make_shared<TransferRace>();
+        race->primary = transfer;
+        
+        // Первый ответ побеждает, второй запрос снимается с engine вместе с разрешением лимитера.
+        // Ошибка одного запроса ждет второй, пока тот в полете
+        auto onDone = [this, monitor, host, race](bool fromHedge, CURLcode result) {
+            if (race->finished) {
+                return;
+            }
+            rateLimiter->Release(host);
+            (fromHedge ? race->hedgeDone : race->primaryDone) = true;
+            
+            CURL* other = fromHedge ? race->primary : race->hedge;
+            bool otherRunning = other && !(fromHedge ? race->primaryDone : race->hedgeDone);
+            if (!WebScraper::IsResponse(result) && otherRunning) {
+                return;
+            }
+            
+            race->finished = true;
+            if (otherRunning) {
+                engine->Cancel(other);
+                rateLimiter->Release(host);
+            }
+            
+            // Разбор ответа и статистику - в пул, чтобы медленная страница не держала event loop
+            if (!executor->Submit([this, monitor, result, fromHedge]() { FinishTransfer(monitor, result, fromHedge); })) {
+                FinishTransfer(monitor, result, fromHedge);
+            }
+        };
+        
+        engine->Submit(transfer, [onDone](CURLcode result) { onDone(false, result); });
+        
+        int hedgeDelayMs = monitor->GetHedgeDelayMs();
+        if (hedgeDelayMs < 0) {
+            return;
+        }
+        
+        engine->ScheduleAfter(hedgeDelayMs, [this, monitor, host, race, onDone]() {
+            if (race->finished || monitor->IsStopped()) {
+                return;
+            }
+            // Hedge - необязательный запрос: только если лимитер пускает без очереди
+            if (!rateLimiter->TryAcquire(host)) {
+                return;
+            }
+            race->hedge = monitor->BeginHedge();
+            if (!race->hedge) {
+                rateLimiter->Release(host);
+                return;
+            }
+            engine->Submit(race->hedge, [onDone](CURLcode result) { onDone(true, result); });
+        });
+    });
+}
+
+
+void MultiStreamMonitor::DeferCheck(std::shared_ptr<StreamMonitor> monitor) {
+    monitor->AbortAsyncCheck();
+    
+    if (!monitor->IsStopped()) {
+        ScheduleCheck(monitor, NextCheckDelayMs(*monitor));
+    }
+}
+
+
+void MultiStreamMonitor::FinishTransfer(std::shared_ptr<StreamMonitor> monitor, CURLcode result, bool fromHedge) {
+    CURL* nextTransfer = monitor->CompleteAsyncCheck(result, fromHedge);
+    
+    if (monitor->IsStopped()) {
+        return;
+    }
+    
+    if (nextTransfer) {
+        SubmitTransfer(monitor, nextTransfer);
+    } else {
+        ScheduleCheck(monitor, NextCheckDelayMs(*monitor));
+    }
+}
+
+
 void MultiStreamMonitor::StartAll() {
-    std::lock_guard<std::mutex> lock(monitorsMutex);
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    auto snapshot = registry.GetSnapshot();
+    const auto& monitors = snapshot->monitors;
     
     if (monitors.empty()) {
         logger->Warning("No streamers to monitor", "MultiStreamMonitor");
@@ -141,86 +400,227 @@ void MultiStreamMonitor::StartAll() {
                    "MultiStreamMonitor");
     std::cout << "\nStarting monitoring for " << monitors.size() << " streamer(s)...\n" << std::endl;
     
-    for (auto& info : monitors) {
-        if (!info.isRunning) {
-            try {
-                info.thread = std::make_unique<std::thread>(
-                    &MultiStreamMonitor::MonitorThreadFunction, 
-                    this, 
-                    info.monitor.get()
-                );
-                
-                info.isRunning = true;
-                
-                logger->Success("Started monitoring: " + info.streamerName, "MultiStreamMonitor");
-                std::cout << "  ✓ Started monitoring: " << info.streamerName << std::endl;
-                
-                // Задержка между запусками потоков
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds(Constants::THREAD_START_DELAY_MS)
-                );
-                
-            } catch (const std::exception& e) {
-                logger->Error("Failed to start thread for " + info.streamerName + ": " + e.what(), 
-                             "MultiStreamMonitor");
-                std::cerr << "  ✗ Failed to start: " << info.streamerName << std::endl;
-            }
+    if (!executor->Start()) {
+        logger->Critical("Failed to start task executor", "MultiStreamMonitor");
+        std::cerr << "Failed to start task executor" << std::endl;
+        return;
+    }
+    
+    if (!rateLimiter->Start()) {
+        std::cerr << "Failed to start rate limiter" << std::endl;
+        return;
+    }
+    
+    if (useEventLoop) {
+        if (!engine->Start()) {
+            logger->Critical("Failed to start event loop", "MultiStreamMonitor");
+            std::cerr << "Failed to start event loop" << std::endl;
+            return;
+        }
+    } else if (!scheduler->Start()) {
+        logger->Critical("Failed to start scheduler", "MultiStreamMonitor");
+        std::cerr << "Failed to start scheduler" << std::endl;
+        return;
+    }
+    
+    // Все первые проверки ставятся сразу, дедлайны - равномерно по окну прогрева:
+    // последний стример проверяется через warmup, а не через N * задержку
+    int warmupMs = std::max(0, config->GetInt("startup_warmup_ms", Constants::STARTUP_WARMUP_MS));
+    size_t toStart = static_cast<size_t>(std::count_if(monitors.begin(), monitors.end(),
+        [](const std::shared_ptr<MonitorInfo>& info) { return !info->isRunning.load(); }));
+    
+    size_t startIndex = 0;
+    for (const auto& info : monitors) {
+        if (!info->isRunning.load()) {
+            int offsetMs = static_cast<int>(static_cast<long long>(warmupMs) * startIndex / toStart);
+            StartMonitor(*info, offsetMs + info->monitor->GetPacingDelayMs());
+            startIndex++;
+            
+            logger->Success("Scheduled monitoring: " + info->streamerName, "MultiStreamMonitor");
         }
     }
     
     isRunning = true;
     
-    logger->System("All monitors started", "MultiStreamMonitor");
-    std::cout << "\nAll monitors started! Press Ctrl+C to stop.\n" << std::endl;
+    // Правка streamers.txt применяется на лету, без перезапуска
+    if (!streamersFilePath.empty() && config->GetBool("watch_streamers_file", true)) {
+        listWatcher = std::make_unique<StreamerListWatcher>(
+            logger, streamersFilePath, [this]() { ReloadStreamersFromFile(); },
+            Constants::STREAMERS_WATCH_DEBOUNCE_MS);
+        if (!listWatcher->Start()) {
+            listWatcher.reset();
+        }
+    }
+    
+    logger->System("All monitors scheduled (" + std::string(useEventLoop ? "event loop" : "worker pool") +
+                   ", warm-up " + std::to_string(warmupMs) + " ms)", "MultiStreamMonitor");
+    std::cout << "All " << monitors.size() << " monitor(s) scheduled, first checks within "
+              << warmupMs / 1000 << "s. Press Ctrl+C to stop.\n" << std::endl;
 }
 
 
-void MultiStreamMonitor::StopAll() {
-    std::lock_guard<std::mutex> lock(monitorsMutex);
+void MultiStreamMonitor::StartMonitor(MonitorInfo& info, int delayMs) {
+    std::shared_ptr<StreamMonitor> monitor = info.monitor;
     
-    if (!isRunning.load()) {
-        return;
+    if (useEventLoop) {
+        ScheduleCheck(monitor, delayMs);
+    } else {
+        // Проверки выполняет фиксированный пул: поток на стримера не нужен
+        info.scheduleId = scheduler->Add(delayMs, [this, monitor]() { return RunPooledCheck(monitor); });
     }
     
-    logger->System("Stopping all monitors (graceful shutdown)", "MultiStreamMonitor");
-    std::cout << "\nStopping all monitors (graceful shutdown)..." << std::endl;
-    
-    // Сначала отправляем сигнал остановки всем мониторам
-    for (auto& info : monitors) {
-        if (info.isRunning && info.monitor) {
-            logger->Debug("Sending stop signal to: " + info.streamerName, "MultiStreamMonitor");
-            info.monitor->Stop();
+    info.isRunning = true;
+}
+
+
+size_t MultiStreamMonitor::FlushStatistics(const std::vector<std::shared_ptr<StreamMonitor>>& toFlush,
+                                           int timeoutMs) {
+    struct FlushState {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining;
+        std::atomic<bool> expired;
+    };
+    
+    auto state = std::make_shared<FlushState>();
+    state->remaining = toFlush.size();
+    state->expired = false;
+    
+    for (const auto& monitor : toFlush) {
+        ExecutorTask task = [state, monitor]() {
+            // После дедлайна запись пропускаем - остановку уже не ждут
+            if (!state->expired.load()) {
+                monitor->SaveStatistics();
+            }
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->remaining == 0) {
+                state->done.notify_all();
+            }
+        };
+        
+        if (!executor->Submit(task)) {
+            task();
         }
     }
     
-    // Теперь ждем завершения всех потоков
-    for (auto& info : monitors) {
-        if (info.thread && info.thread->joinable()) {
-            logger->Debug("Waiting for thread to finish: " + info.streamerName, "MultiStreamMonitor");
-            
-            try {
-                info.thread->join();
-                info.isRunning = false;
-                logger->Success("Stopped: " + info.streamerName, "MultiStreamMonitor");
-                std::cout << "  ✓ Stopped: " << info.streamerName << std::endl;
-                
-            } catch (const std::exception& e) {
-                logger->Error("Error joining thread for " + info.streamerName + ": " + e.what(), 
-                             "MultiStreamMonitor");
-                std::cerr << "  ✗ Error stopping: " << info.streamerName << std::endl;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->done.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                              [&state]() { return state->remaining == 0; })) {
+        state->expired = true;
+        logger->Warning("Statistics flush deadline exceeded, " + std::to_string(state->remaining) +
+                        " file(s) not saved", "MultiStreamMonitor");
+    }
+    return state->remaining;
+}
+
+
+void MultiStreamMonitor::StopAll() {
+    auto callStart = std::chrono::steady_clock::now();
+    auto sinceCall = [&callStart]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - callStart).count();
+    };
+    
+    std::vector<std::shared_ptr<StreamMonitor>> stopping;
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        
+        if (!isRunning.exchange(false)) {
+            return;
+        }
+        
+        logger->System("Stopping all monitors (graceful shutdown)", "MultiStreamMonitor");
+        std::cout << "\nStopping all monitors (graceful shutdown)..." << std::endl;
+        
+        // Сигнал остановки: паузы просыпаются, идущие передачи прерываются
+        for (const auto& info : registry.GetSnapshot()->monitors) {
+            if (info->isRunning.load() && info->monitor) {
+                info->monitor->Stop();
+                stopping.push_back(info->monitor);
             }
         }
     }
     
-    isRunning = false;
+    // Ожидание потоков - без lifecycleMutex
+    auto stopStart = std::chrono::steady_clock::now();
+    
+    // Идущий diff увидит isRunning = false и бросит создание мониторов
+    if (listWatcher) {
+        listWatcher->Stop();
+    }
+    
+    // Проверки, ждущие токен, снимаются сразу (и в пуле, и в event loop)
+    rateLimiter->Stop();
+    
+    if (useEventLoop) {
+        engine->Stop();
+    } else {
+        // Ждет только уже начатые проверки, новые не стартуют
+        scheduler->Stop();
+    }
+    
+    ShutdownTimings timings;
+    timings.monitors = stopping.size();
+    timings.checksStoppedMs = sinceCall();
+    
+    timings.statisticsNotSaved = FlushStatistics(
+        stopping, std::max(0, config->GetInt("shutdown_timeout_ms", Constants::SHUTDOWN_TIMEOUT_MS)));
+    timings.statisticsFlushedMs = sinceCall();
+    
+    // После источников задач: оставшиеся события дорабатываются здесь
+    executor->Stop();
+    
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        for (const auto& info : registry.GetSnapshot()->monitors) {
+            info->isRunning = false;
+            info->scheduleId = 0;
+        }
+        timings.stoppedMs = sinceCall();
+        lastShutdown = timings;
+    }
+    
+    auto stopMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - stopStart).count();
     
-    logger->System("All monitors stopped", "MultiStreamMonitor");
-    std::cout << "\nAll monitors stopped gracefully." << std::endl;
+    if (curlShare) {
+        logger->Info("Connection cache: " + curlShare->GetSummaryString(), "MultiStreamMonitor");
+    }
+    if (engine) {
+        logger->Info("Event loop: " + engine->GetStatsSummary(), "MultiStreamMonitor");
+    }
+    if (scheduler) {
+        logger->Info("Scheduler: " + scheduler->GetStatsSummary(), "MultiStreamMonitor");
+    }
+    logger->Info("Executor: " + executor->GetStatsSummary(), "MultiStreamMonitor");
+    logger->Info("Rate limiter: " + rateLimiter->GetStatsSummary(), "MultiStreamMonitor");
+    
+    unsigned long long hedgesSent = 0;
+    unsigned long long hedgesWon = 0;
+    for (const auto& monitor : stopping) {
+        hedgesSent += monitor->GetHedgesSent();
+        hedgesWon += monitor->GetHedgesWon();
+    }
+    if (hedgesSent > 0) {
+        logger->Info("Hedged requests: " + std::to_string(hedgesSent) + " sent, " +
+                     std::to_string(hedgesWon) + " won", "MultiStreamMonitor");
+    }
+    
+    logger->System("All monitors stopped (" + std::to_string(stopping.size()) + " in " +
+                   std::to_string(stopMs) + " ms)", "MultiStreamMonitor");
+    std::cout << "\nAll monitors stopped gracefully (" << stopMs << " ms)." << std::endl;
+}
+
+
+ShutdownTimings MultiStreamMonitor::GetLastShutdownTimings() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    return lastShutdown;
 }
 
 
 void MultiStreamMonitor::PrintStatus() const {
-    std::lock_guard<std::mutex> lock(monitorsMutex);
+    // Снапшот: вывод не держит добавление и удаление стримеров
+    auto snapshot = registry.GetSnapshot();
+    const auto& monitors = snapshot->monitors;
     
     std::cout << "\n╔════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║        MULTI-STREAM MONITOR STATUS            ║" << std::endl;
@@ -229,15 +629,109 @@ void MultiStreamMonitor::PrintStatus() const {
               << monitors.size() << "║" << std::endl;
     std::cout << "║ System running:  " << std::left << std::setw(29) 
               << (isRunning.load() ? "YES" : "NO") << "║" << std::endl;
+    
+    // Проход по массивам горячего состояния, без обращения к мониторам
+    long long now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    ChannelStateSummary states = context->GetStateTable()->Summarize(now);
+    std::cout << "║ Online / fast:   " << std::left << std::setw(29)
+              << (std::to_string(states.online) + " / " + std::to_string(states.fastMode) +
+                  " of " + std::to_string(states.channels)) << "║" << std::endl;
+    
+    if (curlShare) {
+        ShareStats shareStats = curlShare->GetStats();
+        std::cout << "║ Connections:     " << std::left << std::setw(29)
+                  << (std::to_string(shareStats.connectionsOpened) + " opened, " +
+                      std::to_string(shareStats.connectionsReused) + " reused") << "║" << std::endl;
+        std::cout << "║ TLS handshakes:  " << std::left << std::setw(29)
+                  << (std::to_string(shareStats.tlsHandshakes) + " (" +
+                      std::to_string(shareStats.tlsResumed) + " resumed)") << "║" << std::endl;
+    }
+    
+    if (engine) {
+        EngineStats engineStats = engine->GetStats();
+        std::ostringstream streams;
+        streams << std::fixed << std::setprecision(1) << engineStats.StreamsPerConnection()
+                << " (" << engineStats.connectionsOpened << " conn)";
+        std::cout << "║ H2 streams/conn: " << std::left << std::setw(29)
+                  << streams.str() << "║" << std::endl;
+        std::cout << "║ Latency p50/p99: " << std::left << std::setw(29)
+                  << (std::to_string(engineStats.latencyP50Ms) + " / " +
+                      std::to_string(engineStats.latencyP99Ms) + " ms") << "║" << std::endl;
+        std::cout << "║ Lag p50/p99:     " << std::left << std::setw(29)
+                  << (std::to_string(engineStats.timerLag.p50Ms) + " / " +
+                      std::to_string(engineStats.timerLag.p99Ms) + " ms") << "║" << std::endl;
+    }
+    
+    if (scheduler) {
+        SchedulerStats schedulerStats = scheduler->GetStats();
+        std::cout << "║ Workers:         " << std::left << std::setw(29)
+                  << (std::to_string(schedulerStats.workers) + " (" +
+                      std::to_string(schedulerStats.runningTasks) + " busy)") << "║" << std::endl;
+        std::cout << "║ Lag p50/p99:     " << std::left << std::setw(29)
+                  << (std::to_string(schedulerStats.lag.p50Ms) + " / " +
+                      std::to_string(schedulerStats.lag.p99Ms) + " ms") << "║" << std::endl;
+    }
+    
+    RateLimiterStats limiterStats = rateLimiter->GetStats();
+    std::cout << "║ Rate limiter:    " << std::left << std::setw(29)
+              << (std::to_string(limiterStats.queued) + " queued, " +
+                  std::to_string(limiterStats.rejected) + " rejected") << "║" << std::endl;
+    std::cout << "║ Queue wait p99:  " << std::left << std::setw(29)
+              << (std::to_string(limiterStats.wait.p99Ms) + " ms (" +
+                  std::to_string(limiterStats.deferred) + " deferred)") << "║" << std::endl;
+    
+    FailureStats failures;
+    size_t breakersOpen = 0;
+    unsigned long long hedgesSent = 0;
+    unsigned long long hedgesWon = 0;
+    for (const auto& info : monitors) {
+        failures += info->monitor->GetFailurePolicy().GetStats();
+        if (info->monitor->GetFailurePolicy().GetBreakerState() != BreakerState::CLOSED) {
+            breakersOpen++;
+        }
+        hedgesSent += info->monitor->GetHedgesSent();
+        hedgesWon += info->monitor->GetHedgesWon();
+    }
+    std::cout << "║ Failures T/Th/P: " << std::left << std::setw(29)
+              << (std::to_string(failures.transient) + " / " + std::to_string(failures.throttled) + " / " +
+                  std::to_string(failures.permanent) + " (" + std::to_string(failures.fastRetries) +
+                  " retried)") << "║" << std::endl;
+    std::cout << "║ Backoff/breaker: " << std::left << std::setw(29)
+              << (std::to_string(hostBackoff->GetBackedOffHosts()) + " host(s), " +
+                  std::to_string(breakersOpen) + " open, " +
+                  std::to_string(failures.skipped) + " skipped") << "║" << std::endl;
+    std::cout << "║ Hedges:          " << std::left << std::setw(29)
+              << (std::to_string(hedgesSent) + " sent, " + std::to_string(hedgesWon) + " won") << "║" << std::endl;
+    
+    std::ostringstream budget;
+    budget << std::fixed << std::setprecision(1) << pollBudget->GetRequestsPerMinute() << " req/min";
+    std::cout << "║ Poll budget:     " << std::left << std::setw(29)
+              << budget.str() << "║" << std::endl;
+    
+    ExecutorStats executorStats = executor->GetStats();
+    size_t executorDepth = 0;
+    for (const auto& worker : executorStats.workers) {
+        executorDepth += worker.queueDepth;
+    }
+    std::cout << "║ Executor:        " << std::left << std::setw(29)
+              << (std::to_string(executorStats.executed) + " tasks, " +
+                  std::to_string(executorStats.steals) + " stolen, " +
+                  std::to_string(executorDepth) + " queued") << "║" << std::endl;
+    
     std::cout << "╠════════════════════════════════════════════════╣" << std::endl;
     
     if (monitors.empty()) {
         std::cout << "║ No streamers configured                        ║" << std::endl;
     } else {
         for (const auto& info : monitors) {
-            std::cout << "║ • " << std::left << std::setw(30) << info.streamerName;
+            std::cout << "║ • " << std::left << std::setw(30) << info->streamerName;
+            BreakerState breaker = info->monitor->GetFailurePolicy().GetBreakerState();
+            std::string state = !info->isRunning.load() ? "[STOPPED]"
+                              : breaker == BreakerState::CLOSED ? "[RUNNING]"
+                              : "[" + std::string(FailurePolicy::BreakerStateName(breaker)) + "]";
             std::cout << std::right << std::setw(15) 
-                     << (info.isRunning ? "[RUNNING]" : "[STOPPED]") 
+                     << state 
                      << " ║" << std::endl;
         }
     }
@@ -249,43 +743,199 @@ void MultiStreamMonitor::PrintStatus() const {
 bool MultiStreamMonitor::LoadStreamersFromFile(const std::string& filePath) {
     logger->Info("Loading streamers from file: " + filePath, "MultiStreamMonitor");
     
-    std::ifstream file(filePath);
+    StreamerListFile file(filePath);
     
-    if (!file.is_open()) {
+    if (!file.IsOpen()) {
         logger->Error("Cannot open streamers file: " + filePath, "MultiStreamMonitor");
         std::cerr << "Cannot open streamers file: " << filePath << std::endl;
         return false;
     }
     
-    std::string line;
-    int lineNumber = 0;
-    int loadedCount = 0;
+    // Разбор, проверка имен и повторы - целиком по файлу, до создания мониторов
+    ParsedStreamerList list = StreamerList::Parse(file.GetText());
     
-    while (std::getline(file, line)) {
-        lineNumber++;
-        
-        // Убираем пробелы
-        line = StringUtils::Trim(line);
-        
-        // Пропускаем комментарии и пустые строки
-        if (line.empty() || line[0] == '#') {
+    for (const auto& reject : list.rejected) {
+        logger->Warning("Failed to add streamer from line " + std::to_string(reject.line) + 
+                       ": " + std::string(reject.text) + (reject.duplicate ? " (duplicate)" : ""),
+                       "MultiStreamMonitor");
+    }
+    
+    // Имена и URL - одним пакетом; мониторы создаются по готовым номерам
+    std::vector<StreamerId> ids;
+    context->GetStreamerNames()->InternAll(list.names, ids);
+    
+    std::vector<std::shared_ptr<MonitorInfo>> created;
+    created.reserve(list.names.size());
+    auto snapshot = registry.GetSnapshot();
+    
+    for (size_t i = 0; i < list.names.size(); i++) {
+        std::string_view name = list.names[i];
+        if (snapshot->Find(name)) {
+            logger->Warning("Streamer " + std::string(name) + " already being monitored", "MultiStreamMonitor");
             continue;
         }
         
-        // Добавляем стримера
-        if (AddStreamer(line)) {
-            loadedCount++;
-        } else {
-            logger->Warning("Failed to add streamer from line " + std::to_string(lineNumber) + 
-                           ": " + line, "MultiStreamMonitor");
+        try {
+            created.push_back(CreateMonitor(ids[i]));
+        } catch (const std::exception& e) {
+            logger->Error("Failed to add streamer " + std::string(name) + ": " + e.what(), "MultiStreamMonitor");
         }
     }
     
-    file.close();
+    snapshot.reset();
+    streamersFilePath = filePath;
+    
+    // Весь файл - одной версией реестра, а не копией снапшота на каждую строку
+    size_t loadedCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        std::vector<std::shared_ptr<MonitorInfo>> removed;
+        std::vector<std::shared_ptr<MonitorInfo>> added;
+        registry.Apply({}, created, removed, added);
+        loadedCount = added.size();
+        
+        if (isRunning.load()) {
+            for (const auto& info : added) {
+                StartMonitor(*info, info->monitor->GetPacingDelayMs());
+            }
+        }
+    }
     
     logger->Success("Loaded " + std::to_string(loadedCount) + " streamer(s) from " + filePath, 
                    "MultiStreamMonitor");
     std::cout << "\nLoaded " << loadedCount << " streamer(s) from " << filePath << std::endl;
     
     return loadedCount > 0;
-}
\ No newline at end of file
+}
+
+
+bool MultiStreamMonitor::ApplyStreamerList(const std::vector<std::string>& streamerNames) {
+    std::lock_guard<std::mutex> reloadLock(reloadMutex);
+    
+    auto elapsedMs = [](std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - since).count() / 1000.0;
+    };
+    auto diffStart = std::chrono::steady_clock::now();
+    bool wasRunning = isRunning.load();
+    
+    // Diff по снапшоту - без блокировок
+    auto snapshot = registry.GetSnapshot();
+    std::unordered_set<std::string> wanted(streamerNames.begin(), streamerNames.end());
+    std::vector<std::string> toAdd;
+    std::vector<std::string> toRemove;
+    
+    for (const auto& name : wanted) {
+        if (!snapshot->Find(name)) {
+            toAdd.push_back(name);
+        }
+    }
+    for (const auto& info : snapshot->monitors) {
+        if (wanted.count(info->streamerName) == 0) {
+            toRemove.push_back(info->streamerName);
+        }
+    }
+    snapshot.reset();
+    double diffMs = elapsedMs(diffStart);
+    
+    if (toAdd.empty() && toRemove.empty()) {
+        return true;
+    }
+    
+    // Новые мониторы создаются без блокировок: проверки и команды остальных не ждут
+    auto createStart = std::chrono::steady_clock::now();
+    std::vector<std::string_view> addNames;
+    addNames.reserve(toAdd.size());
+    for (const auto& name : toAdd) {
+        if (!StringUtils::IsValidStreamerName(name)) {
+            logger->Warning("Skipping invalid streamer name: " + name, "MultiStreamMonitor");
+            continue;
+        }
+        addNames.push_back(name);
+    }
+    
+    // Все новые имена - одним пакетом в таблицу имен, как при загрузке файла
+    std::vector<StreamerId> addIds;
+    context->GetStreamerNames()->InternAll(addNames, addIds);
+    
+    std::vector<std::shared_ptr<MonitorInfo>> created;
+    created.reserve(addIds.size());
+    
+    for (size_t i = 0; i < addIds.size(); i++) {
+        if (wasRunning && !isRunning.load()) {
+            return false;
+        }
+        
+        try {
+            created.push_back(CreateMonitor(addIds[i]));
+        } catch (const std::exception& e) {
+            logger->Error("Failed to add streamer " + std::string(addNames[i]) + ": " + e.what(), "MultiStreamMonitor");
+        }
+    }
+    double createMs = elapsedMs(createStart);
+    
+    // Одна новая версия реестра на весь diff; читатели продолжают со старой
+    auto applyStart = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<MonitorInfo>> removed;
+    std::vector<std::shared_ptr<MonitorInfo>> added;
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        if (wasRunning && !isRunning.load()) {
+            return false;
+        }
+        
+        registry.Apply(toRemove, created, removed, added);
+        
+        for (const auto& info : removed) {
+            StopMonitor(*info);
+        }
+        
+        // Новые каналы, как и при старте, разносятся по окну прогрева
+        if (isRunning.load()) {
+            int warmupMs = std::max(0, config->GetInt("startup_warmup_ms", Constants::STARTUP_WARMUP_MS));
+            for (size_t i = 0; i < added.size(); i++) {
+                int offsetMs = static_cast<int>(static_cast<long long>(warmupMs) * i / added.size());
+                StartMonitor(*added[i], offsetMs + added[i]->monitor->GetPacingDelayMs());
+            }
+        }
+    }
+    double applyMs = elapsedMs(applyStart);
+    
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2) << "Streamers list applied: +" << added.size() << " -" << removed.size()
+            << " (diff " << diffMs << " ms, create " << createMs << " ms, locked " << applyMs << " ms)";
+    logger->System(summary.str(), "MultiStreamMonitor");
+    std::cout << summary.str() << std::endl;
+    
+    // Статистику удаленных пишет этот поток, а не executor: он разбирает ответы остальных каналов
+    for (const auto& info : removed) {
+        info->monitor->SaveStatistics();
+    }
+    return true;
+}
+
+
+bool MultiStreamMonitor::ReloadStreamersFromFile() {
+    StreamerListFile file(streamersFilePath);
+    if (!file.IsOpen()) {
+        // Файл мог быть на миг удален при сохранении через rename - ждем следующего события
+        logger->Warning("Cannot reopen streamers file: " + streamersFilePath, "MultiStreamMonitor");
+        return false;
+    }
+    
+    ParsedStreamerList list = StreamerList::Parse(file.GetText());
+    for (const auto& reject : list.rejected) {
+        if (!reject.duplicate) {
+            logger->Warning("Skipping invalid streamer name: " + std::string(reject.text), "MultiStreamMonitor");
+        }
+    }
+    std::vector<std::string> names(list.names.begin(), list.names.end());
+    
+    // Пустой список - скорее недописанный файл, чем желание остановить всех
+    if (names.empty()) {
+        logger->Warning("Streamers file is empty, keeping current list", "MultiStreamMonitor");
+        return false;
+    }
+    
+    return ApplyStreamerList(names);
+}
@@ -0,0 +1,204 @@
+#include "PollPredictor.h"
+#include "Constants.h"
+#include <algorithm>
+#include <cmath>
+
+
+PollBudget::PollBudget(double requestsPerMinute, int defaultIntervalSeconds)
+    : requestsPerSecond(std::max(0.0, requestsPerMinute) / 60.0),
+      defaultIntervalSec(std::max(1, defaultIntervalSeconds)), weightSum(0.0), channels(0) {
+}
+
+
+void PollBudget::Join(double weight) {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+    weightSum += weight;
+    channels++;
+}
+
+
+void PollBudget::Leave(double weight) {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+    weightSum = std::max(0.0, weightSum - weight);
+    if (channels > 0) {
+        channels--;
+    }
+}
+
+
+void PollBudget::Update(double oldWeight, double newWeight) {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+    weightSum = std::max(0.0, weightSum - oldWeight + newWeight);
+}
+
+
+double PollBudget::Scale() const {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+
+    double rate = requestsPerSecond > 0.0
+        ? requestsPerSecond
+        : static_cast<double>(std::max<size_t>(1, channels)) / defaultIntervalSec;
+    return weightSum / rate;
+}
+
+
+double PollBudget::GetRequestsPerMinute() const {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+
+    if (requestsPerSecond > 0.0) {
+        return requestsPerSecond * 60.0;
+    }
+    return static_cast<double>(channels) * 60.0 / defaultIntervalSec;
+}
+
+
+PollPredictor::PollPredictor(std::shared_ptr<PollBudget> sharedBudget, int minIntervalSeconds,
+                             int maxIntervalSeconds, long long observedSinceTime)
+    : observedSince(observedSinceTime), minIntervalSec(std::max(1, minIntervalSeconds)),
+      maxIntervalSec(std::max(minIntervalSec, maxIntervalSeconds)), budget(sharedBudget),
+      meanWeight(0.0), meanWeightHour(-1), channelScale(0.0), channelScaleFor(-1.0) {
+
+    std::fill(starts, starts + HOURS_PER_WEEK, 0.0f);
+    std::fill(hourWeights, hourWeights + HOURS_PER_WEEK, 0.0f);
+
+    // Пока истории нет, все часы равны: вес одинаков у всех каналов
+    meanWeight = std::sqrt(RateAt(0, 0.0));
+    budget->Join(meanWeight);
+}
+
+
+PollPredictor::~PollPredictor() {
+    budget->Leave(meanWeight);
+}
+
+
+void PollPredictor::SetBudget(std::shared_ptr<PollBudget> sharedBudget) {
+    std::lock_guard<std::mutex> lock(predictorMutex);
+
+    if (!sharedBudget || sharedBudget == budget) {
+        return;
+    }
+    budget->Leave(meanWeight);
+    budget = sharedBudget;
+    budget->Join(meanWeight);
+}
+
+
+int PollPredictor::HourOfWeek(long long unixTime) {
+    // 1970-01-01 - четверг; сдвиг на 72 ч делает час 0 понедельником
+    long long hours = unixTime / 3600 + 72;
+    return static_cast<int>(((hours % HOURS_PER_WEEK) + HOURS_PER_WEEK) % HOURS_PER_WEEK);
+}
+
+
+double PollPredictor::WeeksObserved(long long unixTime) const {
+    return std::max(0.0, static_cast<double>(unixTime - observedSince) / (HOURS_PER_WEEK * 3600.0));
+}
+
+
+double PollPredictor::RateAt(int hour, double weeks) const {
+    // Старт в 18:55 и в 19:05 - одно и то же расписание: сглаживаем по соседним часам.
+    // Априорные старты (одна "неделя") не дают часам без истории обнулиться
+    double smoothed = 0.25 * starts[(hour + HOURS_PER_WEEK - 1) % HOURS_PER_WEEK] +
+                      0.5 * starts[hour] +
+                      0.25 * starts[(hour + 1) % HOURS_PER_WEEK];
+    double prior = Constants::POLL_PRIOR_STARTS_PER_WEEK / HOURS_PER_WEEK;
+    return (smoothed + prior) / (std::max(1.0, weeks) + 1.0);
+}
+
+
+void PollPredictor::RefreshMeanWeight(long long unixTime) {
+    long long hour = unixTime / 3600;
+    if (hour == meanWeightHour) {
+        return;
+    }
+    meanWeightHour = hour;
+
+    double weeks = WeeksObserved(unixTime);
+    double sum = 0.0;
+    for (int h = 0; h < HOURS_PER_WEEK; ++h) {
+        double weight = std::sqrt(RateAt(h, weeks));
+        hourWeights[h] = static_cast<float>(weight);
+        sum += weight;
+    }
+
+    double updated = sum / HOURS_PER_WEEK;
+    budget->Update(meanWeight, updated);
+    meanWeight = updated;
+    channelScaleFor = -1.0;
+}
+
+
+double PollPredictor::ClampInterval(double intervalSec) const {
+    return std::min(static_cast<double>(maxIntervalSec),
+                    std::max(static_cast<double>(minIntervalSec), intervalSec));
+}
+
+
+void PollPredictor::SolveChannelScale(double sharedScale) {
+    channelScaleFor = sharedScale;
+    channelScale = sharedScale;
+    if (sharedScale <= 0.0 || meanWeight <= 0.0) {
+        return;
+    }
+
+    // Доля бюджета канала - meanWeight / sharedScale запросов в секунду. В "горячие" часы
+    // интервал упирается в minIntervalSec, и сэкономленное отдаем остальным часам
+    // этого же канала: подбираем коэффициент так, чтобы с границами доля сохранилась
+    double share = meanWeight / sharedScale;
+    double low = sharedScale / 100.0;
+    double high = sharedScale * 100.0;
+
+    for (int iteration = 0; iteration < 40; ++iteration) {
+        double middle = std::sqrt(low * high);
+        double rate = 0.0;
+        for (int h = 0; h < HOURS_PER_WEEK; ++h) {
+            rate += 1.0 / ClampInterval(middle / hourWeights[h]);
+        }
+        rate /= HOURS_PER_WEEK;
+
+        if (rate > share) {
+            low = middle;   // Запросов больше доли - интервалы длиннее
+        } else {
+            high = middle;
+        }
+    }
+
+    channelScale = std::sqrt(low * high);
+}
+
+
+void PollPredictor::RecordStart(long long unixTime) {
+    std::lock_guard<std::mutex> lock(predictorMutex);
+
+    starts[HourOfWeek(unixTime)] += 1.0f;
+    if (unixTime < observedSince) {
+        observedSince = unixTime;
+    }
+
+    meanWeightHour = -1;
+    RefreshMeanWeight(unixTime);
+}
+
+
+int PollPredictor::NextIntervalSec(long long unixTime) {
+    std::lock_guard<std::mutex> lock(predictorMutex);
+
+    RefreshMeanWeight(unixTime);
+
+    // Scale() чуть меняется при каждом обновлении любого канала - пересчитываем
+    // коэффициент, только когда сдвиг заметен
+    double sharedScale = budget->Scale();
+    if (channelScaleFor <= 0.0 || std::fabs(sharedScale - channelScaleFor) > 0.01 * channelScaleFor) {
+        SolveChannelScale(sharedScale);
+    }
+
+    double interval = ClampInterval(channelScale / hourWeights[HourOfWeek(unixTime)]);
+    return static_cast<int>(std::lround(interval));
+}
+
+
+double PollPredictor::GetStartRate(long long unixTime) const {
+    std::lock_guard<std::mutex> lock(predictorMutex);
+    return RateAt(HourOfWeek(unixTime), WeeksObserved(unixTime));
+}
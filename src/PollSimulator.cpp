@@ -0,0 +1,188 @@
+#include "PollSimulator.h"
+#include "PollPredictor.h"
+#include "Constants.h"
+#include <algorithm>
+#include <queue>
+#include <memory>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+#include <utility>
+
+
+PollSimulator::PollSimulator(const Config& config)
+    : checkInterval(std::max(1, config.GetInt("check_interval", Constants::DEFAULT_CHECK_INTERVAL))),
+      checkIntervalFast(std::max(1, config.GetInt("check_interval_fast", Constants::FAST_CHECK_INTERVAL))),
+      fastModeDuration(config.GetInt("fast_mode_duration", Constants::FAST_MODE_DURATION)),
+      maxInterval(config.GetInt("poll_max_interval", Constants::POLL_MAX_INTERVAL)) {
+}
+
+
+void PollSimulator::AddChannel(const std::string& name, std::vector<StreamSession> sessions) {
+    std::sort(sessions.begin(), sessions.end(),
+        [](const StreamSession& a, const StreamSession& b) {
+            return a.startTime < b.startTime;
+        });
+
+    Channel channel;
+    channel.name = name;
+    channel.sessions = std::move(sessions);
+    channels.push_back(std::move(channel));
+}
+
+
+PollSimulationResult PollSimulator::Run(bool predictive, double budgetFactor) const {
+    PollSimulationResult result;
+    result.policy = predictive ? "predictive" : "fixed";
+    result.budgetFactor = budgetFactor;
+
+    long long begin = 0;
+    long long end = 0;
+    for (const auto& channel : channels) {
+        if (channel.sessions.empty()) {
+            continue;
+        }
+        long long first = channel.sessions.front().startTime;
+        begin = (begin == 0) ? first : std::min(begin, first);
+        for (const auto& session : channel.sessions) {
+            end = std::max(end, session.endTime);
+        }
+    }
+    if (begin == 0 || end <= begin || budgetFactor <= 0.0) {
+        return result;
+    }
+
+    // Первая половина истории - разгон для predictive, метрики по второй
+    long long evalStart = begin + (end - begin) / 2;
+
+    int fixedInterval = std::max(1, static_cast<int>(checkInterval / budgetFactor + 0.5));
+    auto budget = std::make_shared<PollBudget>(
+        static_cast<double>(channels.size()) * 60.0 / checkInterval * budgetFactor, checkInterval);
+
+    struct ChannelState {
+        size_t session;
+        bool sessionSeen;
+        bool believedOnline;
+        long long lastOnline;
+        std::unique_ptr<PollPredictor> predictor;
+    };
+
+    std::vector<ChannelState> states(channels.size());
+    using PollEvent = std::pair<long long, size_t>;
+    std::priority_queue<PollEvent, std::vector<PollEvent>, std::greater<PollEvent>> polls;
+
+    for (size_t i = 0; i < channels.size(); ++i) {
+        ChannelState& state = states[i];
+        state.session = 0;
+        state.sessionSeen = false;
+        state.believedOnline = false;
+        state.lastOnline = 0;
+        state.predictor = std::make_unique<PollPredictor>(budget, checkIntervalFast, maxInterval, begin);
+        polls.push(PollEvent(begin + static_cast<long long>(i % fixedInterval), i));
+    }
+
+    std::vector<long long> delays;
+
+    while (!polls.empty()) {
+        PollEvent poll = polls.top();
+        polls.pop();
+
+        long long now = poll.first;
+        if (now > end) {
+            continue;
+        }
+
+        ChannelState& state = states[poll.second];
+        const std::vector<StreamSession>& sessions = channels[poll.second].sessions;
+
+        // Сессии, закончившиеся до этой проверки
+        while (state.session < sessions.size() && sessions[state.session].endTime <= now) {
+            if (!state.sessionSeen && sessions[state.session].startTime >= evalStart) {
+                result.missed++;
+            }
+            state.session++;
+            state.sessionSeen = false;
+        }
+
+        bool online = state.session < sessions.size() && sessions[state.session].startTime <= now;
+        if (now >= evalStart) {
+            result.requests++;
+        }
+
+        if (online && !state.sessionSeen) {
+            state.sessionSeen = true;
+            if (sessions[state.session].startTime >= evalStart) {
+                delays.push_back(now - sessions[state.session].startTime);
+            }
+        }
+
+        // Та же логика, что в StreamMonitor::ProcessCheckResult/GetCurrentCheckInterval
+        if (online && !state.believedOnline) {
+            state.believedOnline = true;
+            state.predictor->RecordStart(now);
+            state.lastOnline = now;
+        } else if (!online && state.believedOnline) {
+            state.believedOnline = false;
+            state.lastOnline = now;
+        } else if (online) {
+            state.lastOnline = now;
+        }
+
+        int interval = checkInterval;
+        if (state.lastOnline > 0 && now - state.lastOnline < fastModeDuration) {
+            interval = checkIntervalFast;
+        } else if (!state.believedOnline) {
+            interval = predictive ? state.predictor->NextIntervalSec(now) : fixedInterval;
+        }
+
+        polls.push(PollEvent(now + interval, poll.second));
+    }
+
+    result.detections = static_cast<int>(delays.size());
+    result.requestsPerMinute = static_cast<double>(result.requests) * 60.0 / (end - evalStart);
+
+    if (!delays.empty()) {
+        long long total = 0;
+        for (long long delay : delays) {
+            total += delay;
+        }
+        result.meanDelaySec = static_cast<double>(total) / delays.size();
+
+        size_t p90 = (delays.size() * 90) / 100;
+        std::nth_element(delays.begin(), delays.begin() + p90, delays.end());
+        result.p90DelaySec = delays[std::min(p90, delays.size() - 1)];
+    }
+
+    return result;
+}
+
+
+std::string PollSimulator::RunComparison() const {
+    static const double BUDGET_FACTORS[] = { 0.5, 1.0, 2.0 };
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(12) << "policy"
+       << std::right << std::setw(8) << "budget"
+       << std::setw(12) << "requests"
+       << std::setw(10) << "req/min"
+       << std::setw(10) << "starts"
+       << std::setw(8) << "missed"
+       << std::setw(12) << "mean, s"
+       << std::setw(10) << "p90, s" << "\n";
+
+    for (double factor : BUDGET_FACTORS) {
+        for (bool predictive : { false, true }) {
+            PollSimulationResult result = Run(predictive, factor);
+            ss << std::left << std::setw(12) << result.policy
+               << std::right << std::fixed << std::setprecision(2) << std::setw(8) << result.budgetFactor
+               << std::setw(12) << result.requests
+               << std::setprecision(1) << std::setw(10) << result.requestsPerMinute
+               << std::setw(10) << result.detections
+               << std::setw(8) << result.missed
+               << std::setw(12) << result.meanDelaySec
+               << std::setw(10) << result.p90DelaySec << "\n";
+        }
+    }
+
+    return ss.str();
+}
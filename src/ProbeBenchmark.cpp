@@ -0,0 +1,146 @@
+#include "ProbeBenchmark.h"
+#include "StandInServer.h"
+#include "MonitorContext.h"
+#include "WebScraper.h"
+#include "Logger.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_probe.log";
+const size_t PAGE_BYTES = 96 * 1024;  // Live-маркер на 80% - в пределах max_html_size
+const int PROBE_RANGE_BYTES = 4096;
+const int LIVE_RUN_ROUNDS = 4;  // Состояние канала держится столько раундов подряд
+const int LIVE_PERIOD = 4;      // Каждый LIVE_PERIOD-й отрезок - live
+
+
+std::string ChannelName(size_t index) {
+    return "probe_" + std::to_string(index);
+}
+
+
+// Каналы сдвинуты друг относительно друга: в каждом раунде кто-то меняет состояние
+bool IsLiveAt(size_t channel, int round) {
+    return ((channel + static_cast<size_t>(round)) / LIVE_RUN_ROUNDS) % LIVE_PERIOD == 0;
+}
+
+
+std::string FormatSaved(double value, double baseline) {
+    if (baseline <= 0.0) {
+        return "-";
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << (1.0 - value / baseline) * 100.0 << "%";
+    return ss.str();
+}
+
+}
+
+
+ProbeBenchmark::ProbeBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, int roundCount)
+    : config(configInstance), channels(std::max<size_t>(1, channelCount)), rounds(std::max(1, roundCount)) {
+    config->Set("hedge_requests", "false");
+    config->Set("log_file", BENCH_LOG_FILE);
+}
+
+
+ProbeBenchmarkResult ProbeBenchmark::Run(StandInServer& server, const std::string& mode, bool useHeadRequest,
+                                         int probeRangeBytes) const {
+    config->Set("use_head_request", useHeadRequest ? "true" : "false");
+    config->Set("probe_range_bytes", std::to_string(probeRangeBytes));
+
+    auto logger = std::make_shared<Logger>(BENCH_LOG_FILE);
+    auto context = std::make_shared<MonitorContext>(config, logger);
+
+    // Свой скрапер на канал: offline-отпечаток у каждого монитора свой
+    std::vector<StreamerId> ids;
+    std::vector<std::unique_ptr<WebScraper>> scrapers;
+    for (size_t i = 0; i < channels; i++) {
+        ids.push_back(context->GetStreamerNames()->Intern(ChannelName(i)));
+        scrapers.push_back(std::make_unique<WebScraper>(context));
+    }
+
+    ProbeBenchmarkResult result;
+    result.mode = mode;
+    result.verdicts.reserve(channels * static_cast<size_t>(rounds));
+    server.ResetStats();
+
+    size_t receivedBytes = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < channels; i++) {
+            server.SetLive(ChannelName(i), IsLiveAt(i, round));
+        }
+        for (size_t i = 0; i < channels; i++) {
+            bool isOnline = scrapers[i]->CheckStreamStatus(ids[i]);
+            receivedBytes += scrapers[i]->GetLastTransferStats().bytesReceived;
+            if (scrapers[i]->GetLastFailure() != FailureClass::NONE) {
+                result.failedChecks++;
+            }
+            if (isOnline != IsLiveAt(i, round)) {
+                result.wrongVerdicts++;
+            }
+            result.verdicts.push_back(isOnline);
+        }
+    }
+
+    StandInStats stats = server.GetStats();
+    result.checks = result.verdicts.size();
+    result.pageRequests = stats.requests - stats.mainPageRequests;
+    result.fullFetches = stats.requests - stats.mainPageRequests - stats.headRequests - stats.rangeRequests;
+    result.receivedKb = receivedBytes / 1024.0;
+    return result;
+}
+
+
+std::string ProbeBenchmark::RunComparison(bool& verdictsMatch) const {
+    verdictsMatch = false;
+
+    StandInServer server(PAGE_BYTES);
+    if (!server.Start()) {
+        return "stand-in server did not start on 127.0.0.1";
+    }
+    config->Set("twitch_base_url", server.GetBaseUrl());
+
+    std::vector<ProbeBenchmarkResult> results;
+    results.push_back(Run(server, "full fetch", false, 0));
+    results.push_back(Run(server, "HEAD probe", true, 0));
+    results.push_back(Run(server, "range probe", true, PROBE_RANGE_BYTES));
+    server.Stop();
+
+    const ProbeBenchmarkResult& baseline = results.front();
+
+    std::ostringstream ss;
+    ss << channels << " channel(s) x " << rounds << " round(s), " << PAGE_BYTES / 1024 << " KB pages, "
+       << server.GetBaseUrl() << "\n\n";
+    ss << std::left << std::setw(14) << "mode"
+       << std::right << std::setw(10) << "requests"
+       << std::setw(10) << "saved"
+       << std::setw(13) << "full GETs"
+       << std::setw(14) << "KB received"
+       << std::setw(10) << "saved"
+       << std::setw(8) << "wrong"
+       << std::setw(9) << "failed"
+       << std::setw(13) << "= full fetch" << "\n";
+
+    verdictsMatch = true;
+    for (const auto& result : results) {
+        bool sameAsFull = result.verdicts == baseline.verdicts;
+        verdictsMatch = verdictsMatch && sameAsFull && result.wrongVerdicts == 0 && result.failedChecks == 0;
+
+        ss << std::left << std::setw(14) << result.mode
+           << std::right << std::setw(10) << result.pageRequests
+           << std::setw(10) << FormatSaved(static_cast<double>(result.pageRequests),
+                                           static_cast<double>(baseline.pageRequests))
+           << std::setw(13) << result.fullFetches
+           << std::fixed << std::setprecision(0) << std::setw(14) << result.receivedKb
+           << std::setw(10) << FormatSaved(result.receivedKb, baseline.receivedKb)
+           << std::setw(8) << result.wrongVerdicts
+           << std::setw(9) << result.failedChecks
+           << std::setw(13) << (sameAsFull ? "yes" : "NO") << "\n";
+    }
+
+    return ss.str();
+}
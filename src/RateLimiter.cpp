@@ -0,0 +1,350 @@
+#include "RateLimiter.h"
+#include <sstream>
+#include <algorithm>
+
+
+RateLimiter::RateLimiter(std::shared_ptr<Logger> loggerInstance, double requestsPerSecond, int burstSize,
+                         int maxInFlightPerHost, int maxQueueWaitMs)
+    : logger(loggerInstance), ratePerSecond(std::max(0.0, requestsPerSecond)),
+      burst(std::max(1, burstSize)), maxPerHost(std::max(0, maxInFlightPerHost)),
+      maxWaitMs(std::max(0, maxQueueWaitMs)), tokens(burst),
+      lastRefill(std::chrono::steady_clock::now()), nextTicket(1),
+      waitWindow(WAIT_WINDOW), running(false) {
+}
+
+
+RateLimiter::~RateLimiter() {
+    Stop();
+}
+
+
+bool RateLimiter::Start() {
+    if (running.exchange(true)) {
+        return true;
+    }
+
+    try {
+        dispatcherThread = std::thread(&RateLimiter::DispatcherThreadFunction, this);
+    } catch (const std::exception& e) {
+        logger->Critical("Failed to start rate limiter: " + std::string(e.what()), "RateLimiter");
+        running = false;
+        return false;
+    }
+
+    std::ostringstream ss;
+    ss << "Rate limiter started (" << ratePerSecond << " req/s, burst " << burst
+       << ", " << maxPerHost << " in flight per host, max wait " << maxWaitMs << " ms)";
+    logger->System(ss.str(), "RateLimiter");
+    return true;
+}
+
+
+void RateLimiter::Stop() {
+    std::vector<std::pair<RateLimitCallback, bool>> ready;
+    {
+        std::lock_guard<std::mutex> lock(limiterMutex);
+        if (!running.exchange(false) && !dispatcherThread.joinable()) {
+            return;
+        }
+
+        for (auto& waiter : queue) {
+            ready.emplace_back(std::move(waiter.onReady), false);
+            stats.rejected++;
+        }
+        queue.clear();
+        waiterByTicket.clear();
+    }
+    wakeup.notify_all();
+
+    if (dispatcherThread.joinable()) {
+        dispatcherThread.join();
+    }
+
+    // Ждущие проверки узнают об остановке и снимаются без ошибки
+    RunCallbacks(ready);
+    logger->System("Rate limiter stopped", "RateLimiter");
+}
+
+
+void RateLimiter::Refill(std::chrono::steady_clock::time_point now) {
+    if (ratePerSecond <= 0.0) {
+        return;
+    }
+
+    double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+    if (elapsed > 0.0) {
+        tokens = std::min(burst, tokens + elapsed * ratePerSecond);
+        lastRefill = now;
+    }
+}
+
+
+bool RateLimiter::CanGrant(const std::string& host) const {
+    if (maxPerHost <= 0) {
+        return true;
+    }
+
+    auto it = inFlightByHost.find(host);
+    return it == inFlightByHost.end() || it->second < maxPerHost;
+}
+
+
+void RateLimiter::Grant(const std::string& host) {
+    if (ratePerSecond > 0.0) {
+        tokens -= 1.0;
+    }
+    int hostInFlight = ++inFlightByHost[host];
+    stats.peakInFlightPerHost = std::max(stats.peakInFlightPerHost, hostInFlight);
+    stats.inFlight++;
+    stats.granted++;
+}
+
+
+void RateLimiter::DispatchQueue(std::chrono::steady_clock::time_point now,
+                                std::vector<std::pair<RateLimitCallback, bool>>& ready) {
+    Refill(now);
+
+    auto it = queue.begin();
+    while (it != queue.end()) {
+        long long waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->enqueued).count();
+
+        // Проверка, простоявшая дольше max_wait, устарела: пусть монитор поставит следующую
+        if (maxWaitMs > 0 && waitedMs >= maxWaitMs) {
+            ready.emplace_back(std::move(it->onReady), false);
+            stats.rejected++;
+            waiterByTicket.erase(it->ticket);
+            it = queue.erase(it);
+            continue;
+        }
+
+        // Токенов нет - дальше по очереди только более новые запросы
+        if (ratePerSecond > 0.0 && tokens < 1.0) {
+            break;
+        }
+
+        // Хост упирается в предел - пропускаем вперед запросы к другим хостам
+        if (!CanGrant(it->host)) {
+            ++it;
+            continue;
+        }
+
+        Grant(it->host);
+        stats.deferred++;
+        waitWindow.Add(waitedMs);
+        ready.emplace_back(std::move(it->onReady), true);
+        waiterByTicket.erase(it->ticket);
+        it = queue.erase(it);
+    }
+
+    stats.queued = queue.size();
+}
+
+
+std::chrono::steady_clock::time_point RateLimiter::NextEventTime() const {
+    auto next = std::chrono::steady_clock::time_point::max();
+    if (queue.empty()) {
+        return next;
+    }
+
+    if (ratePerSecond > 0.0 && tokens < 1.0) {
+        auto untilToken = std::chrono::duration<double>((1.0 - tokens) / ratePerSecond);
+        next = lastRefill + std::chrono::duration_cast<std::chrono::steady_clock::duration>(untilToken);
+    }
+
+    if (maxWaitMs > 0) {
+        next = std::min(next, queue.front().enqueued + std::chrono::milliseconds(maxWaitMs));
+    }
+
+    // Иначе ждем Release: очередь держит только предел на хост
+    return next;
+}
+
+
+void RateLimiter::RunCallbacks(std::vector<std::pair<RateLimitCallback, bool>>& ready) {
+    for (auto& entry : ready) {
+        if (entry.first) {
+            entry.first(entry.second);
+        }
+    }
+    ready.clear();
+}
+
+
+void RateLimiter::DispatcherThreadFunction() {
+    std::vector<std::pair<RateLimitCallback, bool>> ready;
+    std::unique_lock<std::mutex> lock(limiterMutex);
+
+    while (running.load()) {
+        DispatchQueue(std::chrono::steady_clock::now(), ready);
+
+        if (!ready.empty()) {
+            lock.unlock();
+            RunCallbacks(ready);
+            lock.lock();
+            continue;
+        }
+
+        auto next = NextEventTime();
+        if (next == std::chrono::steady_clock::time_point::max()) {
+            wakeup.wait(lock);
+        } else {
+            wakeup.wait_until(lock, next);
+        }
+    }
+}
+
+
+uint64_t RateLimiter::Submit(const std::string& host, RateLimitCallback onReady) {
+    uint64_t ticket = 0;
+    bool grantedNow = false;
+    bool rejectedNow = false;
+    {
+        std::lock_guard<std::mutex> lock(limiterMutex);
+        ticket = nextTicket++;
+
+        if (running.load()) {
+            auto now = std::chrono::steady_clock::now();
+            Refill(now);
+
+            // Сразу - только если никто не ждет раньше (FIFO)
+            if (queue.empty() && (ratePerSecond <= 0.0 || tokens >= 1.0) && CanGrant(host)) {
+                Grant(host);
+                waitWindow.Add(0);
+                grantedNow = true;
+            } else {
+                queue.push_back(Waiter{ticket, host, std::move(onReady), now});
+                waiterByTicket[ticket] = std::prev(queue.end());
+                stats.queued = queue.size();
+                stats.peakQueued = std::max(stats.peakQueued, queue.size());
+            }
+        } else {
+            stats.rejected++;
+            rejectedNow = true;
+        }
+    }
+
+    if (grantedNow || rejectedNow) {
+        onReady(grantedNow);
+    } else {
+        wakeup.notify_one();
+    }
+    return ticket;
+}
+
+
+bool RateLimiter::Acquire(const std::string& host, std::atomic<uint64_t>& ticket) {
+    // Состояние в shared_ptr: callback может отработать уже после выхода из wait
+    struct AcquireState {
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+        bool granted = false;
+    };
+    auto state = std::make_shared<AcquireState>();
+
+    ticket = Submit(host, [state](bool granted) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished = true;
+        state->granted = granted;
+        state->done.notify_all();
+    });
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]() { return state->finished; });
+    ticket = 0;
+    return state->granted;
+}
+
+
+bool RateLimiter::TryAcquire(const std::string& host) {
+    std::lock_guard<std::mutex> lock(limiterMutex);
+    if (!running.load()) {
+        return false;
+    }
+
+    Refill(std::chrono::steady_clock::now());
+
+    // Очередь впереди - необязательный запрос не отнимает у нее токен
+    if (!queue.empty() || (ratePerSecond > 0.0 && tokens < 1.0) || !CanGrant(host)) {
+        return false;
+    }
+
+    Grant(host);
+    return true;
+}
+
+
+bool RateLimiter::Cancel(uint64_t ticket) {
+    RateLimitCallback onReady;
+    {
+        std::lock_guard<std::mutex> lock(limiterMutex);
+        auto it = waiterByTicket.find(ticket);
+        if (it == waiterByTicket.end()) {
+            return false;
+        }
+
+        onReady = std::move(it->second->onReady);
+        queue.erase(it->second);
+        waiterByTicket.erase(it);
+        stats.queued = queue.size();
+        stats.cancelled++;
+    }
+
+    if (onReady) {
+        onReady(false);
+    }
+    return true;
+}
+
+
+void RateLimiter::Release(const std::string& host) {
+    {
+        std::lock_guard<std::mutex> lock(limiterMutex);
+        auto it = inFlightByHost.find(host);
+        if (it == inFlightByHost.end()) {
+            return;
+        }
+        if (--it->second <= 0) {
+            inFlightByHost.erase(it);
+        }
+        if (stats.inFlight > 0) {
+            stats.inFlight--;
+        }
+    }
+    wakeup.notify_one();
+}
+
+
+RateLimiterStats RateLimiter::GetStats() const {
+    std::lock_guard<std::mutex> lock(limiterMutex);
+
+    RateLimiterStats snapshot = stats;
+    snapshot.wait = waitWindow.Summarize();
+    return snapshot;
+}
+
+
+std::string RateLimiter::GetStatsSummary() const {
+    RateLimiterStats snapshot = GetStats();
+    std::ostringstream ss;
+
+    ss << "granted=" << snapshot.granted
+       << ", deferred=" << snapshot.deferred
+       << ", rejected=" << snapshot.rejected
+       << ", cancelled=" << snapshot.cancelled
+       << ", queued=" << snapshot.queued << " (peak " << snapshot.peakQueued << ")"
+       << ", in flight=" << snapshot.inFlight << " (peak " << snapshot.peakInFlightPerHost << " per host)"
+       << ", wait p50/p90/p99/max=" << snapshot.wait.p50Ms << "/" << snapshot.wait.p90Ms << "/"
+       << snapshot.wait.p99Ms << "/" << snapshot.wait.maxMs << " ms";
+
+    return ss.str();
+}
+
+
+std::string RateLimiter::HostOf(const std::string& url) {
+    size_t begin = url.find("://");
+    begin = (begin == std::string::npos) ? 0 : begin + 3;
+
+    size_t end = url.find_first_of(":/?#", begin);
+    return url.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+}
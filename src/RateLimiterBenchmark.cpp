@@ -0,0 +1,221 @@
+#include "RateLimiterBenchmark.h"
+#include "RateLimiter.h"
+#include "Logger.h"
+#include "Constants.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const size_t HOSTS = 2;
+const int FAST_LATENCY_MS = 20;
+const double MIN_RATE_SHARE = 0.9;  // Ниже - лимитер недодает разрешенную частоту
+const double RATE_SLACK = 1.05;
+
+typedef std::chrono::steady_clock Clock;
+
+
+// Хост под ограничением: общий token bucket (запас на 1 токен больше, чем у
+// лимитера - он разрешает раньше, чем запрос доходит сюда) и предел на хост
+class ThrottlingStandIn {
+private:
+    std::mutex mutex;
+    double rate;
+    double capacity;
+    int maxPerHost;
+    double tokens;
+    Clock::time_point lastRefill;
+    std::vector<int> active;
+    int peakActive;
+    unsigned long long accepted;
+    unsigned long long throttled;
+
+public:
+    ThrottlingStandIn(int requestsPerSecond, int burst, int maxInFlightPerHost)
+        : rate(requestsPerSecond), capacity(burst + 1.0), maxPerHost(maxInFlightPerHost),
+          tokens(burst + 1.0), lastRefill(Clock::now()), active(HOSTS, 0),
+          peakActive(0), accepted(0), throttled(0) {}
+
+    void Begin(size_t host) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto now = Clock::now();
+        tokens = std::min(capacity, tokens + std::chrono::duration<double>(now - lastRefill).count() * rate);
+        lastRefill = now;
+
+        accepted++;
+        peakActive = std::max(peakActive, ++active[host]);
+        if (tokens < 1.0 || active[host] > maxPerHost) {
+            throttled++;
+        } else {
+            tokens -= 1.0;
+        }
+    }
+
+    void End(size_t host) {
+        std::lock_guard<std::mutex> lock(mutex);
+        active[host]--;
+    }
+
+    void Snapshot(unsigned long long& acceptedCount, unsigned long long& throttledCount, int& peak) {
+        std::lock_guard<std::mutex> lock(mutex);
+        acceptedCount = accepted;
+        throttledCount = throttled;
+        peak = peakActive;
+    }
+};
+
+
+// Разрешенные запросы до конца ответа подставки. Задержка у всех одна - FIFO
+struct PendingRequests {
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<std::pair<Clock::time_point, size_t>> queue;
+    bool stopping = false;
+};
+
+}
+
+
+RateLimiterBenchmark::RateLimiterBenchmark(int requestsPerSecond, int burstSize, int maxInFlightPerHost,
+                                           int durationSeconds)
+    : rps(requestsPerSecond > 0 ? requestsPerSecond : Constants::RATE_LIMIT_RPS),
+      burst(burstSize > 0 ? burstSize : Constants::RATE_LIMIT_BURST),
+      maxInFlight(maxInFlightPerHost > 0 ? maxInFlightPerHost : Constants::MAX_INFLIGHT_PER_HOST),
+      seconds(std::max(1, durationSeconds)) {
+}
+
+
+RateLimiterBenchmarkResult RateLimiterBenchmark::Run(const std::string& mode, bool limited,
+                                                     size_t clients, int latencyMs) const {
+    ThrottlingStandIn standIn(rps, burst, maxInFlight);
+    PendingRequests pending;
+
+    std::vector<std::string> hosts;
+    for (size_t i = 0; i < HOSTS; i++) {
+        hosts.push_back("stand-in-" + std::to_string(i) + ".local");
+    }
+
+    // Без лимитера - тот же путь с пропуском всего сразу
+    auto logger = std::make_shared<Logger>("logs/bench_rate_limiter.log");
+    RateLimiter limiter(logger, limited ? rps : 0, burst, limited ? maxInFlight : 0,
+                        Constants::RATE_LIMIT_MAX_WAIT_MS);
+    limiter.Start();
+
+    // onReady короткий: только ставит ответ в очередь
+    auto submit = [&](size_t host) {
+        limiter.Submit(hosts[host], [&pending, &standIn, host, latencyMs](bool granted) {
+            if (!granted) {
+                return;
+            }
+            standIn.Begin(host);
+            std::lock_guard<std::mutex> lock(pending.mutex);
+            pending.queue.emplace_back(Clock::now() + std::chrono::milliseconds(latencyMs), host);
+            pending.wakeup.notify_one();
+        });
+    };
+
+    // Ответ пришел - клиент сразу шлет следующий запрос к тому же хосту
+    std::thread responder([&]() {
+        std::unique_lock<std::mutex> lock(pending.mutex);
+        while (!pending.stopping) {
+            if (pending.queue.empty()) {
+                pending.wakeup.wait(lock);
+                continue;
+            }
+            auto due = pending.queue.front().first;
+            if (Clock::now() < due) {
+                pending.wakeup.wait_until(lock, due);
+                continue;
+            }
+
+            size_t host = pending.queue.front().second;
+            pending.queue.pop_front();
+            lock.unlock();
+            standIn.End(host);
+            limiter.Release(hosts[host]);
+            submit(host);
+            lock.lock();
+        }
+    });
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < clients; i++) {
+        submit(i % HOSTS);
+    }
+    std::this_thread::sleep_until(start + std::chrono::seconds(seconds));
+
+    RateLimiterBenchmarkResult result;
+    result.mode = mode;
+    unsigned long long accepted = 0;
+    standIn.Snapshot(accepted, result.throttled, result.peakInFlightPerHost);
+    result.requestsPerSec = accepted / std::chrono::duration<double>(Clock::now() - start).count();
+    result.limiterPeakInFlightPerHost = limiter.GetStats().peakInFlightPerHost;
+
+    // Ждущие в лимитере отклоняются, новые Submit после Stop - тоже
+    limiter.Stop();
+    {
+        std::lock_guard<std::mutex> lock(pending.mutex);
+        pending.stopping = true;
+    }
+    pending.wakeup.notify_one();
+    responder.join();
+
+    return result;
+}
+
+
+std::string RateLimiterBenchmark::RunComparison(bool& limitsHeld) const {
+    // Короткие ответы: клиентов ровно на предел хостов, упор только в частоту.
+    // Долгие: ответ дольше, чем хосты пропустят на rps, упор в предел на хост
+    size_t rateClients = HOSTS * static_cast<size_t>(maxInFlight);
+    int slowLatencyMs = static_cast<int>(2000LL * HOSTS * maxInFlight / rps);
+
+    std::vector<std::pair<RateLimiterBenchmarkResult, bool>> results;
+    results.emplace_back(Run("rate, limiter", true, rateClients, FAST_LATENCY_MS), true);
+    results.emplace_back(Run("rate, none", false, rateClients, FAST_LATENCY_MS), false);
+    results.emplace_back(Run("in-flight, limiter", true, rateClients * 4, slowLatencyMs), true);
+    results.emplace_back(Run("in-flight, none", false, rateClients * 4, slowLatencyMs), false);
+
+    // Запас burst сверху - токены, накопленные до начала прогона
+    double maxRate = rps * RATE_SLACK + static_cast<double>(burst) / seconds;
+
+    std::ostringstream ss;
+    ss << "limits: " << rps << " req/s (burst " << burst << "), " << maxInFlight << " in flight per host, "
+       << HOSTS << " host(s), " << seconds << " s per run; slow responses " << slowLatencyMs << " ms\n\n";
+    ss << std::left << std::setw(20) << "mode"
+       << std::right << std::setw(10) << "req/s"
+       << std::setw(14) << "peak/host"
+       << std::setw(16) << "limiter peak"
+       << std::setw(12) << "throttled" << "\n";
+
+    limitsHeld = true;
+    for (size_t i = 0; i < results.size(); i++) {
+        const RateLimiterBenchmarkResult& result = results[i].first;
+        if (results[i].second) {
+            limitsHeld = limitsHeld && result.throttled == 0 && result.requestsPerSec <= maxRate &&
+                         result.peakInFlightPerHost <= maxInFlight;
+            // На коротких ответах лимитер должен выдавать почти всю разрешенную частоту
+            if (i == 0) {
+                limitsHeld = limitsHeld && result.requestsPerSec >= rps * MIN_RATE_SHARE;
+            }
+        }
+
+        ss << std::left << std::setw(20) << result.mode
+           << std::right << std::fixed << std::setprecision(1) << std::setw(10) << result.requestsPerSec
+           << std::setw(14) << result.peakInFlightPerHost
+           << std::setw(16) << (results[i].second ? std::to_string(result.limiterPeakInFlightPerHost) : "-")
+           << std::setw(12) << result.throttled << "\n";
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,277 @@
+#include "RegistryBenchmark.h"
+#include "MonitorRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace {
+
+const int SCAN_EVERY = 256;    // Каждая N-я операция читателя - полный обход
+const int SAMPLE_EVERY = 8;    // Задержку пишем для каждого N-го поиска
+const size_t CHURN_BATCH = 100; // Каналов на одно изменение списка (-N +N)
+const double STALL_US = 100.0;     // Чтение дольше - читатель ждал (блокировку или CPU)
+const int LIFECYCLE_WORK_US = 5;   // Stop/StartMonitor одного канала внутри пакета
+
+
+// Работа писателя над каждым измененным каналом (отмена/постановка проверки)
+void LifecycleWork() {
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(LIFECYCLE_WORK_US);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+
+// Прежняя схема MultiStreamMonitor: список и индекс под одним mutex
+class LockedStore {
+private:
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<MonitorInfo>> monitors;
+    std::unordered_map<std::string, size_t> index;
+
+public:
+    bool Contains(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index.count(name) != 0;
+    }
+
+    size_t Scan() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t running = 0;
+        for (const auto& info : monitors) {
+            running += info->isRunning.load(std::memory_order_relaxed) ? 1 : 0;
+        }
+        return running;
+    }
+
+    void Add(std::shared_ptr<MonitorInfo> info) {
+        std::lock_guard<std::mutex> lock(mutex);
+        index.emplace(info->streamerName, monitors.size());
+        monitors.push_back(std::move(info));
+    }
+
+    // Как прежний ApplyStreamerList: пакет и Stop/Start каналов под тем же mutex, что у читателей
+    void Apply(const std::vector<std::string>& removeNames, const std::vector<std::shared_ptr<MonitorInfo>>& addInfos) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& name : removeNames) {
+            Erase(name);
+            LifecycleWork();
+        }
+        for (const auto& info : addInfos) {
+            index.emplace(info->streamerName, monitors.size());
+            monitors.push_back(info);
+            LifecycleWork();
+        }
+    }
+
+private:
+    void Erase(const std::string& name) {
+        auto it = index.find(name);
+        if (it == index.end()) {
+            return;
+        }
+
+        size_t position = it->second;
+        index.erase(it);
+        if (position + 1 != monitors.size()) {
+            monitors[position] = std::move(monitors.back());
+            index[monitors[position]->streamerName] = position;
+        }
+        monitors.pop_back();
+    }
+};
+
+
+// Как MultiStreamMonitor: Stop/Start под lifecycleMutex, который читатели не берут
+class SnapshotStore {
+private:
+    MonitorRegistry registry;
+    std::mutex lifecycleMutex;
+
+public:
+    bool Contains(const std::string& name) const {
+        return registry.Find(name) != nullptr;
+    }
+
+    size_t Scan() const {
+        auto snapshot = registry.GetSnapshot();
+        size_t running = 0;
+        for (const auto& info : snapshot->monitors) {
+            running += info->isRunning.load(std::memory_order_relaxed) ? 1 : 0;
+        }
+        return running;
+    }
+
+    void Add(std::shared_ptr<MonitorInfo> info) {
+        registry.Add(std::move(info));
+    }
+
+    void Apply(const std::vector<std::string>& removeNames, const std::vector<std::shared_ptr<MonitorInfo>>& addInfos) {
+        std::vector<std::shared_ptr<MonitorInfo>> removed;
+        std::vector<std::shared_ptr<MonitorInfo>> added;
+
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        registry.Apply(removeNames, addInfos, removed, added);
+        for (size_t i = 0; i < removed.size() + added.size(); i++) {
+            LifecycleWork();
+        }
+    }
+};
+
+
+template <typename Store>
+RegistryBenchmarkResult RunWith(const char* registryName, int readers, int durationSeconds, size_t size) {
+    std::vector<std::string> names;
+    names.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        names.push_back("channel_" + std::to_string(i));
+    }
+
+    Store store;
+    for (const auto& name : names) {
+        store.Add(std::make_shared<MonitorInfo>(name, nullptr));
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned long long> totalReads(0);
+    std::atomic<unsigned long long> totalWrites(0);
+    std::atomic<size_t> scanSink(0);
+    std::vector<std::vector<double>> samples(readers);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r]() {
+            std::mt19937 rng(static_cast<unsigned>(r + 1));
+            std::uniform_int_distribution<size_t> pick(0, names.size() - 1);
+            unsigned long long reads = 0;
+            size_t sink = 0;
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                reads++;
+                if (reads % SCAN_EVERY == 0) {
+                    sink += store.Scan();
+                    continue;
+                }
+
+                const std::string& name = names[pick(rng)];
+                if (reads % SAMPLE_EVERY != 0) {
+                    sink += store.Contains(name) ? 1 : 0;
+                    continue;
+                }
+
+                auto begin = std::chrono::steady_clock::now();
+                sink += store.Contains(name) ? 1 : 0;
+                samples[r].push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - begin).count());
+            }
+
+            totalReads += reads;
+            scanSink += sink;
+        });
+    }
+
+    // Писатель: изменения списка пакетами - убирает CHURN_BATCH каналов и возвращает
+    // их новыми MonitorInfo следующим пакетом
+    threads.emplace_back([&]() {
+        unsigned long long writes = 0;
+        size_t batch = std::min(CHURN_BATCH, names.size());
+        std::vector<std::string> removeNames;
+        std::vector<std::shared_ptr<MonitorInfo>> addInfos;
+
+        for (size_t next = 0; !stop.load(std::memory_order_relaxed); next = (next + batch) % names.size()) {
+            for (size_t i = 0; i < batch; i++) {
+                removeNames.push_back(names[(next + i) % names.size()]);
+            }
+            store.Apply(removeNames, addInfos);
+            writes += removeNames.size() + addInfos.size();
+
+            addInfos.clear();
+            for (const auto& name : removeNames) {
+                addInfos.push_back(std::make_shared<MonitorInfo>(name, nullptr));
+            }
+            removeNames.clear();
+        }
+        totalWrites += writes;
+    });
+
+    std::this_thread::sleep_for(std::chrono::seconds(durationSeconds));
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<double> latencies;
+    for (const auto& readerSamples : samples) {
+        latencies.insert(latencies.end(), readerSamples.begin(), readerSamples.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&latencies](double p) {
+        if (latencies.empty()) {
+            return 0.0;
+        }
+        size_t position = static_cast<size_t>(p * (latencies.size() - 1));
+        return latencies[position];
+    };
+
+    RegistryBenchmarkResult result;
+    result.registry = registryName;
+    result.readsPerSec = static_cast<double>(totalReads.load()) / durationSeconds;
+    result.writesPerSec = static_cast<double>(totalWrites.load()) / durationSeconds;
+    result.p50ReadUs = percentile(0.50);
+    result.p99ReadUs = percentile(0.99);
+    result.p999ReadUs = percentile(0.999);
+    result.maxReadUs = latencies.empty() ? 0.0 : latencies.back();
+    result.stalledReads = static_cast<unsigned long long>(
+        latencies.end() - std::lower_bound(latencies.begin(), latencies.end(), STALL_US));
+    return result;
+}
+
+}
+
+
+RegistryBenchmark::RegistryBenchmark(int readerThreads, int seconds, size_t registrySize)
+    : readers(std::max(1, readerThreads)), durationSeconds(std::max(1, seconds)),
+      size(std::max<size_t>(1, registrySize)) {
+}
+
+
+RegistryBenchmarkResult RegistryBenchmark::Run(bool snapshot) const {
+    return snapshot ? RunWith<SnapshotStore>("snapshot", readers, durationSeconds, size)
+                    : RunWith<LockedStore>("mutex", readers, durationSeconds, size);
+}
+
+
+std::string RegistryBenchmark::RunComparison() const {
+    std::ostringstream ss;
+    ss << std::left << std::setw(10) << "registry"
+       << std::right << std::setw(14) << "reads/s"
+       << std::setw(12) << "p50, us"
+       << std::setw(12) << "p99, us"
+       << std::setw(12) << "p99.9, us"
+       << std::setw(12) << "max, us"
+       << std::setw(10) << ">100us"
+       << std::setw(12) << "writes/s" << "\n";
+
+    for (bool snapshot : { false, true }) {
+        RegistryBenchmarkResult result = Run(snapshot);
+        ss << std::left << std::setw(10) << result.registry
+           << std::right << std::fixed << std::setprecision(0) << std::setw(14) << result.readsPerSec
+           << std::setprecision(2) << std::setw(12) << result.p50ReadUs
+           << std::setw(12) << result.p99ReadUs
+           << std::setw(12) << result.p999ReadUs
+           << std::setw(12) << result.maxReadUs
+           << std::setw(10) << result.stalledReads
+           << std::setprecision(0) << std::setw(12) << result.writesPerSec << "\n";
+    }
+
+    return ss.str();
+}
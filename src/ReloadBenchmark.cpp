@@ -0,0 +1,118 @@
+#include "ReloadBenchmark.h"
+#include "BenchmarkSupport.h"
+#include "MultiStreamMonitor.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_reload.log";
+const char* BENCH_CHECK_INTERVAL = "300";  // Верхняя граница check_interval в Config::ValidateSettings
+const char* BENCH_WARMUP_MS = "300000";    // Первые проверки - по всему интервалу
+const int SETTLE_MS = 3000;                // StartAll и первые таймеры
+const int LAG_WINDOW_MS = 2000;
+
+typedef std::chrono::steady_clock Clock;
+
+
+std::vector<std::string> ChannelNames(size_t first, size_t count) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = first; i < first + count; i++) {
+        names.push_back("reload_" + std::to_string(i));
+    }
+    return names;
+}
+
+
+std::string FormatLag(const LatencySummary& lag) {
+    return std::to_string(lag.p50Ms) + "/" + std::to_string(lag.p99Ms) + "/" + std::to_string(lag.maxMs);
+}
+
+}
+
+
+ReloadBenchmark::ReloadBenchmark(std::shared_ptr<Config> configInstance, size_t channelCount, size_t changedCount)
+    : config(configInstance), channels(std::max<size_t>(2, channelCount)),
+      changed(std::min(std::max<size_t>(2, changedCount), std::max<size_t>(2, channelCount))) {
+    BenchmarkSupport::PrepareMonitorConfig(*config, BENCH_LOG_FILE);
+    config->Set("check_interval", BENCH_CHECK_INTERVAL);
+    config->Set("check_interval_fast", BENCH_CHECK_INTERVAL);
+    config->Set("startup_warmup_ms", BENCH_WARMUP_MS);
+}
+
+
+ReloadBenchmarkResult ReloadBenchmark::Run(bool running) const {
+    // Старый список: 0..channels-1. Новый: без первых removed, плюс added имен после конца
+    size_t removed = changed / 2;
+    size_t added = changed - removed;
+    std::vector<std::string> before = ChannelNames(0, channels);
+    std::vector<std::string> after = ChannelNames(removed, channels - removed + added);
+
+    ReloadBenchmarkResult result;
+    result.mode = running ? "running" : "stopped";
+    result.running = running;
+
+    MultiStreamMonitor monitor(config);
+    monitor.ApplyStreamerList(before);
+
+    if (running) {
+        monitor.StartAll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(SETTLE_MS));
+        monitor.ResetSchedulingLag();
+        std::this_thread::sleep_for(std::chrono::milliseconds(LAG_WINDOW_MS));
+        result.lagBefore = monitor.GetSchedulingLag();
+        monitor.ResetSchedulingLag();
+    }
+
+    auto start = Clock::now();
+    monitor.ApplyStreamerList(after);
+    result.applyMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(LAG_WINDOW_MS));
+        result.lagDuring = monitor.GetSchedulingLag();
+    }
+
+    std::vector<std::string> registered = monitor.GetStreamers();
+    std::sort(registered.begin(), registered.end());
+    std::sort(after.begin(), after.end());
+    result.listMatches = registered == after;
+
+    if (running) {
+        monitor.StopAll();
+    }
+    return result;
+}
+
+
+std::string ReloadBenchmark::RunComparison(bool& listsMatch) const {
+    std::vector<ReloadBenchmarkResult> results;
+    results.push_back(Run(false));
+    results.push_back(Run(true));
+
+    std::ostringstream ss;
+    ss << channels << " channel(s), " << changed / 2 << " removed + " << changed - changed / 2 << " added\n\n";
+    ss << std::left << std::setw(10) << "monitors"
+       << std::right << std::setw(12) << "apply, ms"
+       << std::setw(26) << "lag before p50/p99/max"
+       << std::setw(26) << "lag during p50/p99/max"
+       << std::setw(12) << "list ok" << "\n";
+
+    listsMatch = true;
+    for (const auto& result : results) {
+        listsMatch = listsMatch && result.listMatches;
+        ss << std::left << std::setw(10) << result.mode
+           << std::right << std::fixed << std::setprecision(1) << std::setw(12) << result.applyMs
+           << std::setw(26) << (result.running ? FormatLag(result.lagBefore) + " ms" : "-")
+           << std::setw(26) << (result.running ? FormatLag(result.lagDuring) + " ms" : "-")
+           << std::setw(12) << (result.listMatches ? "yes" : "NO") << "\n";
+    }
+
+    return ss.str();
+}
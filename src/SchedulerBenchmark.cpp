@@ -0,0 +1,114 @@
+#include "SchedulerBenchmark.h"
+#include "DeadlineQueue.h"
+#include "TimingWheel.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+const int64_t CHECK_INTERVAL_MS = Constants::DEFAULT_CHECK_INTERVAL * 1000;
+const int64_t JITTER_MS = Constants::REQUEST_INTERVAL_JITTER_MS;
+
+
+SchedulerBenchmarkResult Run(DeadlineQueue& queue, size_t channels, int64_t durationMs) {
+    SchedulerBenchmarkResult result;
+    result.backend = queue.Name();
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> jitter(-JITTER_MS, JITTER_MS);
+    std::uniform_int_distribution<int64_t> moveDelay(0, CHECK_INTERVAL_MS);
+    std::uniform_int_distribution<uint64_t> pickChannel(0, channels - 1);
+
+    std::vector<ExpiredDeadline> expired;
+    expired.reserve(channels);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Первые проверки - равномерно по одному интервалу, как окно прогрева
+    for (uint64_t id = 0; id < channels; id++) {
+        queue.Schedule(id, static_cast<int64_t>(id * CHECK_INTERVAL_MS / channels));
+    }
+
+    int64_t now = 0;
+    while (now <= durationMs) {
+        expired.clear();
+        queue.PopExpired(now, expired);
+        result.wakeups++;
+
+        // Backend отдают дедлайны тика в разном порядке - случайные числа берутся в одном
+        std::sort(expired.begin(), expired.end(), [](const ExpiredDeadline& a, const ExpiredDeadline& b) {
+            return a.deadlineMs != b.deadlineMs ? a.deadlineMs < b.deadlineMs : a.taskId < b.taskId;
+        });
+
+        for (const auto& deadline : expired) {
+            result.fired++;
+            result.maxLateMs = std::max(result.maxLateMs, now - deadline.deadlineMs);
+            result.checksum = result.checksum * 1000003u + deadline.taskId * 31u + static_cast<uint64_t>(deadline.deadlineMs);
+
+            queue.Schedule(deadline.taskId, now + CHECK_INTERVAL_MS + jitter(rng));
+
+            queue.Schedule(pickChannel(rng), now + 1 + moveDelay(rng));
+            result.moved++;
+        }
+
+        int64_t next = queue.NextWakeupMs();
+        now = (next < 0) ? durationMs + 1 : std::max(now + 1, next);
+    }
+
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    uint64_t operations = channels + result.fired * 2 + result.wakeups;
+    result.nsPerOperation = result.elapsedMs * 1e6 / static_cast<double>(operations);
+    return result;
+}
+
+}
+
+
+SchedulerBenchmark::SchedulerBenchmark(size_t channelCount, int seconds)
+    : channels(std::max<size_t>(1, channelCount)), simulatedSeconds(std::max(1, seconds)) {
+}
+
+
+std::string SchedulerBenchmark::RunComparison(bool& backendsAgree) const {
+    int64_t durationMs = static_cast<int64_t>(simulatedSeconds) * 1000;
+
+    std::vector<SchedulerBenchmarkResult> results;
+    {
+        TimingWheel wheel(0);
+        results.push_back(Run(wheel, channels, durationMs));
+    }
+    {
+        HeapDeadlineQueue heap;
+        results.push_back(Run(heap, channels, durationMs));
+    }
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(8) << "backend"
+       << std::right << std::setw(12) << "total, ms"
+       << std::setw(12) << "fired"
+       << std::setw(12) << "moved"
+       << std::setw(12) << "wakeups"
+       << std::setw(10) << "ns/op"
+       << std::setw(12) << "max late" << "\n";
+
+    backendsAgree = true;
+    for (const auto& result : results) {
+        backendsAgree = backendsAgree && result.checksum == results.front().checksum && result.maxLateMs == 0;
+        ss << std::left << std::setw(8) << result.backend
+           << std::right << std::fixed << std::setprecision(1) << std::setw(12) << result.elapsedMs
+           << std::setw(12) << result.fired
+           << std::setw(12) << result.moved
+           << std::setw(12) << result.wakeups
+           << std::setw(10) << result.nsPerOperation
+           << std::setw(12) << result.maxLateMs << "\n";
+    }
+
+    return ss.str();
+}
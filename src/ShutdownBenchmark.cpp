@@ -0,0 +1,139 @@
+#include "ShutdownBenchmark.h"
+#include "BenchmarkSupport.h"
+#include "StandInServer.h"
+#include "StreamerNames.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_shutdown.log";
+const char* BENCH_WARMUP_MS = "1000";  // Первые проверки всех мониторов - за секунду
+const int SETTLE_MS = 4000;            // Сверх окна прогрева: проверки успевают уйти в передачу
+const int STALL_MS = 120000;           // Дольше timeout: ответа не дождется ни одна проверка
+const size_t PAGE_BYTES = 96 * 1024;
+const size_t LIST_SIZES[] = {100, 1000, 10000};
+const char* ENGINES[] = {"event_loop", "threads"};
+
+typedef std::chrono::steady_clock Clock;
+
+
+std::vector<std::string> ChannelNames(size_t count) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        names.push_back("shutdown_" + std::to_string(i));
+    }
+    return names;
+}
+
+}
+
+
+ShutdownBenchmark::ShutdownBenchmark(std::shared_ptr<Config> configInstance, size_t channelLimit)
+    : config(configInstance), maxChannels(std::max<size_t>(1, channelLimit)) {
+    BenchmarkSupport::PrepareMonitorConfig(*config, BENCH_LOG_FILE);
+    config->Set("enable_statistics", "true");  // Запись статистики - часть остановки
+    config->Set("startup_warmup_ms", BENCH_WARMUP_MS);
+}
+
+
+ShutdownBenchmarkResult ShutdownBenchmark::Run(size_t channels, const std::string& engine) const {
+    ShutdownBenchmarkResult result;
+    result.channels = channels;
+    result.engine = engine == "threads" ? "worker pool" : "event loop";
+
+    StandInServer server(PAGE_BYTES);
+    if (!server.Start()) {
+        return result;
+    }
+    result.standInStarted = true;
+    server.SetStall(1.0, STALL_MS);
+    config->Set("twitch_base_url", server.GetBaseUrl());
+    config->Set("multi_engine", engine);
+
+    std::vector<std::string> names = ChannelNames(channels);
+    {
+        MultiStreamMonitor monitor(config);
+        monitor.ApplyStreamerList(names);
+        monitor.StartAll();
+
+        // В пуле в передаче не больше worker_threads проверок - ждем до срока, а не всех
+        auto deadline = Clock::now() + std::chrono::milliseconds(
+            config->GetInt("startup_warmup_ms", Constants::STARTUP_WARMUP_MS) + SETTLE_MS);
+        while (Clock::now() < deadline && monitor.GetCheckedMonitorCount() < channels) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        result.checksInFlight = monitor.GetCheckedMonitorCount();
+
+        auto start = Clock::now();
+        monitor.StopAll();
+        result.stopAllMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        result.timings = monitor.GetLastShutdownTimings();
+    }
+    server.Stop();
+
+    for (const auto& name : names) {
+        std::remove(StreamerNameTable::StatsPathFor(name).c_str());
+    }
+    return result;
+}
+
+
+std::string ShutdownBenchmark::RunComparison(bool& stoppedInTime) const {
+    std::vector<size_t> sizes;
+    for (size_t size : LIST_SIZES) {
+        if (size < maxChannels) {
+            sizes.push_back(size);
+        }
+    }
+    sizes.push_back(maxChannels);
+
+    std::vector<ShutdownBenchmarkResult> results;
+    for (size_t channels : sizes) {
+        for (const char* engine : ENGINES) {
+            results.push_back(Run(channels, engine));
+        }
+    }
+
+    std::ostringstream ss;
+    ss << "every response stalls " << STALL_MS / 1000 << " s, shutdown_timeout_ms "
+       << config->GetInt("shutdown_timeout_ms", Constants::SHUTDOWN_TIMEOUT_MS) << "\n\n";
+    ss << std::left << std::setw(10) << "channels"
+       << std::setw(14) << "engine"
+       << std::right << std::setw(12) << "in flight"
+       << std::setw(18) << "checks stopped"
+       << std::setw(16) << "stats flushed"
+       << std::setw(14) << "StopAll, ms"
+       << std::setw(12) << "not saved" << "\n";
+
+    stoppedInTime = true;
+    for (const auto& result : results) {
+        if (!result.standInStarted) {
+            stoppedInTime = false;
+            ss << std::left << std::setw(10) << result.channels
+               << std::setw(14) << result.engine << "stand-in server did not start on 127.0.0.1\n";
+            continue;
+        }
+        stoppedInTime = stoppedInTime && result.timings.statisticsNotSaved == 0;
+
+        ss << std::left << std::setw(10) << result.channels
+           << std::setw(14) << result.engine
+           << std::right << std::setw(12) << result.checksInFlight
+           << std::fixed << std::setprecision(1)
+           << std::setw(18) << result.timings.checksStoppedMs
+           << std::setw(16) << result.timings.statisticsFlushedMs
+           << std::setw(14) << result.stopAllMs
+           << std::setw(12) << result.timings.statisticsNotSaved << "\n";
+    }
+    ss << "\nchecks stopped / stats flushed - ms from the StopAll call\n";
+
+    return ss.str();
+}
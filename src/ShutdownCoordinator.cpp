@@ -0,0 +1,170 @@
+#include "ShutdownCoordinator.h"
+#include <iostream>
+#include <csignal>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif
+
+
+namespace {
+    // Для signal handler: только async-signal-safe доступ
+    int g_signalWriteFd = -1;
+
+    const char SIGNAL_BYTE = 's';
+    const char QUIT_BYTE = 'q';
+}
+
+
+ShutdownCoordinator::ShutdownCoordinator() : shutdownRequested(false) {
+#ifndef _WIN32
+    signalPipe[0] = -1;
+    signalPipe[1] = -1;
+#endif
+}
+
+
+ShutdownCoordinator::~ShutdownCoordinator() {
+#ifndef _WIN32
+    if (signalThread.joinable()) {
+        char byte = QUIT_BYTE;
+        ssize_t written = write(signalPipe[1], &byte, 1);
+        (void)written;
+        signalThread.join();
+    }
+
+    g_signalWriteFd = -1;
+    for (int fd : signalPipe) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+
+ShutdownCoordinator& ShutdownCoordinator::Instance() {
+    static ShutdownCoordinator instance;
+    return instance;
+}
+
+
+#ifndef _WIN32
+
+void ShutdownCoordinator::OnSignal(int) {
+    int savedErrno = errno;
+    if (g_signalWriteFd >= 0) {
+        char byte = SIGNAL_BYTE;
+        ssize_t written = write(g_signalWriteFd, &byte, 1);
+        (void)written;
+    }
+    errno = savedErrno;
+}
+
+
+void ShutdownCoordinator::SignalThreadFunction() {
+    char byte = 0;
+
+    while (true) {
+        ssize_t got = read(signalPipe[0], &byte, 1);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0 || byte == QUIT_BYTE) {
+            return;
+        }
+
+        if (shutdownRequested.load()) {
+            std::cout << "\n[SIGNAL] Second signal received, exiting immediately" << std::endl;
+            std::_Exit(EXIT_FAILURE);
+        }
+
+        std::cout << "\n\n[SIGNAL] Shutdown signal received. Stopping gracefully..." << std::endl;
+        RequestShutdown();
+    }
+}
+
+
+bool ShutdownCoordinator::InstallSignalHandlers() {
+    if (signalThread.joinable()) {
+        return true;
+    }
+
+    if (pipe(signalPipe) != 0) {
+        std::cerr << "Failed to create signal pipe" << std::endl;
+        return false;
+    }
+
+    // Запись из handler не должна блокироваться, даже если поток не успевает читать
+    fcntl(signalPipe[1], F_SETFL, fcntl(signalPipe[1], F_GETFL) | O_NONBLOCK);
+    fcntl(signalPipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(signalPipe[1], F_SETFD, FD_CLOEXEC);
+    g_signalWriteFd = signalPipe[1];
+
+    signalThread = std::thread(&ShutdownCoordinator::SignalThreadFunction, this);
+
+    struct sigaction action = {};
+    action.sa_handler = OnSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    return true;
+}
+
+#else
+
+void ShutdownCoordinator::OnSignal(int signal) {
+    // Windows вызывает обработчик Ctrl+C в отдельном потоке - можно звать напрямую
+    std::signal(signal, OnSignal);
+
+    ShutdownCoordinator& coordinator = Instance();
+    if (coordinator.IsShutdownRequested()) {
+        std::_Exit(EXIT_FAILURE);
+    }
+
+    std::cout << "\n\n[SIGNAL] Shutdown signal received. Stopping gracefully..." << std::endl;
+    coordinator.RequestShutdown();
+}
+
+
+bool ShutdownCoordinator::InstallSignalHandlers() {
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+    return true;
+}
+
+#endif
+
+
+void ShutdownCoordinator::AddShutdownHandler(std::function<void()> handler) {
+    std::lock_guard<std::mutex> lock(shutdownMutex);
+    handlers.push_back(std::move(handler));
+}
+
+
+void ShutdownCoordinator::RequestShutdown() {
+    std::vector<std::function<void()>> toRun;
+    {
+        std::lock_guard<std::mutex> lock(shutdownMutex);
+        if (shutdownRequested.exchange(true)) {
+            return;
+        }
+        toRun.swap(handlers);
+    }
+    shutdownCondition.notify_all();
+
+    for (auto& handler : toRun) {
+        handler();
+    }
+}
+
+
+void ShutdownCoordinator::WaitForShutdown() {
+    std::unique_lock<std::mutex> lock(shutdownMutex);
+    shutdownCondition.wait(lock, [this]() { return shutdownRequested.load(); });
+}
+
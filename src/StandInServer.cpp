@@ -0,0 +1,358 @@
+#include "StandInServer.h"
+#include "MarkerBenchmark.h"
+#include "StringUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+    #define MSG_NOSIGNAL 0
+#endif
+
+
+namespace {
+
+const int ACCEPT_POLL_MS = 100;       // Как часто цикл accept смотрит на stopping
+const size_t MAX_REQUEST_BYTES = 16 * 1024;
+const int LISTEN_BACKLOG = 1024;
+
+#ifdef _WIN32
+const StandInSocket INVALID_STAND_IN_SOCKET = INVALID_SOCKET;
+#else
+const StandInSocket INVALID_STAND_IN_SOCKET = -1;
+#endif
+
+
+// Значение заголовка без учета регистра имени, "" - заголовка нет
+std::string HeaderValue(const std::string& request, const std::string& name) {
+    std::string lower = StringUtils::ToLower(request);
+    size_t pos = lower.find("\r\n" + name + ":");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    size_t begin = pos + 2 + name.size() + 1;
+    size_t end = request.find("\r\n", begin);
+    return StringUtils::Trim(request.substr(begin, end - begin));
+}
+
+
+// Сколько байт ушло в сокет; меньше size - клиент закрыл соединение
+size_t SendAll(StandInSocket socket, const char* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        int chunk = static_cast<int>(std::min<size_t>(size - total, 1 << 20));
+        int sent = send(socket, data + total, chunk, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(sent);
+    }
+    return total;
+}
+
+}
+
+
+StandInServer::StandInServer(size_t pageBytes)
+    : livePage(MarkerBenchmark::MakePage(true, pageBytes)),
+      offlinePage(MarkerBenchmark::MakePage(false, pageBytes)),
+      listenSocket(INVALID_STAND_IN_SOCKET), port(0), stopping(false),
+      stallFraction(0.0), stallMs(0), requestIndex(0),
+      requests(0), mainPageRequests(0), headRequests(0), rangeRequests(0), stalled(0), bodyBytes(0),
+      connections(0) {
+}
+
+
+StandInServer::~StandInServer() {
+    Stop();
+}
+
+
+bool StandInServer::Start() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+#endif
+
+    listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenSocket == INVALID_STAND_IN_SOCKET) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;  // Свободный порт - подставки разных замеров не мешают друг другу
+
+    socklen_t length = sizeof(address);
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenSocket, LISTEN_BACKLOG) != 0 ||
+        getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        CloseSocket(listenSocket);
+        listenSocket = INVALID_STAND_IN_SOCKET;
+        return false;
+    }
+
+    port = ntohs(address.sin_port);
+    stopping = false;
+    acceptThread = std::thread(&StandInServer::AcceptLoop, this);
+    return true;
+}
+
+
+void StandInServer::Stop() {
+    if (!acceptThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    stallWakeup.notify_all();
+    acceptThread.join();
+    CloseSocket(listenSocket);
+    listenSocket = INVALID_STAND_IN_SOCKET;
+
+    // recv в потоках соединений просыпается по shutdown
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (StandInSocket client : openSockets) {
+#ifdef _WIN32
+            shutdown(client, SD_BOTH);
+#else
+            shutdown(client, SHUT_RDWR);
+#endif
+        }
+        threads.swap(connectionThreads);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+
+std::string StandInServer::GetBaseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(port) + "/";
+}
+
+
+void StandInServer::SetLive(const std::string& channel, bool isLive) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    live[channel] = isLive;
+}
+
+
+void StandInServer::SetStall(double fraction, int delayMs) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    stallFraction = std::min(1.0, std::max(0.0, fraction));
+    stallMs = std::max(0, delayMs);
+    requestIndex = 0;
+}
+
+
+StandInStats StandInServer::GetStats() const {
+    StandInStats stats;
+    stats.requests = requests.load();
+    stats.mainPageRequests = mainPageRequests.load();
+    stats.headRequests = headRequests.load();
+    stats.rangeRequests = rangeRequests.load();
+    stats.stalled = stalled.load();
+    stats.bodyBytes = bodyBytes.load();
+    stats.connections = connections.load();
+    return stats;
+}
+
+
+void StandInServer::ResetStats() {
+    requests = 0;
+    mainPageRequests = 0;
+    headRequests = 0;
+    rangeRequests = 0;
+    stalled = 0;
+    bodyBytes = 0;
+    connections = 0;
+}
+
+
+void StandInServer::AcceptLoop() {
+    while (!stopping.load()) {
+#ifdef _WIN32
+        WSAPOLLFD pollFd = {listenSocket, POLLRDNORM, 0};
+        int ready = WSAPoll(&pollFd, 1, ACCEPT_POLL_MS);
+#else
+        pollfd pollFd = {listenSocket, POLLIN, 0};
+        int ready = poll(&pollFd, 1, ACCEPT_POLL_MS);
+#endif
+        if (ready <= 0) {
+            continue;
+        }
+
+        StandInSocket client = accept(listenSocket, nullptr, nullptr);
+        if (client == INVALID_STAND_IN_SOCKET) {
+            continue;
+        }
+
+        int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        connections++;
+
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        openSockets.push_back(client);
+        connectionThreads.emplace_back(&StandInServer::Serve, this, client);
+    }
+}
+
+
+void StandInServer::Serve(StandInSocket client) {
+    std::string buffer;
+    char chunk[4096];
+    bool keepAlive = true;
+
+    while (keepAlive && !stopping.load()) {
+        size_t headerEnd = buffer.find("\r\n\r\n");
+        if (headerEnd == std::string::npos) {
+            if (buffer.size() > MAX_REQUEST_BYTES) {
+                break;
+            }
+            int received = recv(client, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(received));
+            continue;
+        }
+
+        // GET и HEAD без тела: запрос кончается на пустой строке
+        std::string request = buffer.substr(0, headerEnd + 2);
+        buffer.erase(0, headerEnd + 4);
+        if (!Respond(client, request, keepAlive)) {
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        openSockets.erase(std::remove(openSockets.begin(), openSockets.end(), client), openSockets.end());
+    }
+    CloseSocket(client);
+}
+
+
+bool StandInServer::Respond(StandInSocket client, const std::string& request, bool& keepAlive) {
+    size_t methodEnd = request.find(' ');
+    size_t pathEnd = request.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || pathEnd == std::string::npos || pathEnd == methodEnd + 1) {
+        return false;
+    }
+    std::string method = request.substr(0, methodEnd);
+    std::string path = request.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    std::string channel = path.substr(1, path.find('?') - 1);
+    bool head = method == "HEAD";
+
+    keepAlive = StringUtils::ToLower(HeaderValue(request, "connection")) != "close";
+    requests++;
+    if (channel.empty()) {
+        mainPageRequests++;
+    } else if (head) {
+        headRequests++;
+    }
+
+    if (ShouldStall()) {
+        stalled++;
+        std::unique_lock<std::mutex> lock(stateMutex);
+        stallWakeup.wait_for(lock, std::chrono::milliseconds(stallMs), [this]() { return stopping.load(); });
+        if (stopping.load()) {
+            return false;
+        }
+    }
+
+    bool isLive = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        auto it = live.find(channel);
+        isLive = it != live.end() && it->second;
+    }
+    const std::string& page = isLive ? livePage : offlinePage;
+
+    // Range: только "bytes=0-N", как шлет probe
+    size_t bodySize = page.size();
+    std::string status = "200 OK";
+    std::string contentRange;
+    std::string range = HeaderValue(request, "range");
+    if (range.compare(0, 8, "bytes=0-") == 0 && range.size() > 8) {
+        size_t last = static_cast<size_t>(std::strtoull(range.c_str() + 8, nullptr, 10));
+        bodySize = std::min(page.size(), last + 1);
+        status = "206 Partial Content";
+        contentRange = "Content-Range: bytes 0-" + std::to_string(bodySize - 1) + "/" +
+                       std::to_string(page.size()) + "\r\n";
+        if (!channel.empty()) {
+            rangeRequests++;
+        }
+    }
+
+    std::string headers = "HTTP/1.1 " + status + "\r\n"
+                          "Content-Type: text/html; charset=utf-8\r\n"
+                          "Content-Length: " + std::to_string(bodySize) + "\r\n" +
+                          contentRange +
+                          "ETag: \"" + (isLive ? "live" : "offline") + "\"\r\n" +
+                          (keepAlive ? "" : "Connection: close\r\n") +
+                          "\r\n";
+    if (SendAll(client, headers.data(), headers.size()) < headers.size()) {
+        return false;
+    }
+    if (head) {
+        return true;
+    }
+
+    // Клиент рвет соединение, как только знает вердикт - это не ошибка подставки
+    size_t sent = SendAll(client, page.data(), bodySize);
+    bodyBytes += sent;
+    return sent == bodySize;
+}
+
+
+bool StandInServer::ShouldStall() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (stallFraction <= 0.0 || stallMs <= 0) {
+        return false;
+    }
+    // Доля равномерно по порядку: запрос n зависает, когда floor(n * fraction) растет
+    unsigned long long index = requestIndex++;
+    return std::floor((index + 1) * stallFraction) > std::floor(index * stallFraction);
+}
+
+
+void StandInServer::CloseSocket(StandInSocket socket) {
+    if (socket == INVALID_STAND_IN_SOCKET) {
+        return;
+    }
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
@@ -0,0 +1,118 @@
+#include "StartupBenchmark.h"
+#include "BenchmarkSupport.h"
+#include "MultiStreamMonitor.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+const char* BENCH_LOG_FILE = "logs/bench_startup.log";
+const int LEGACY_STAGGER_MS = 500;               // Прежний THREAD_START_DELAY_MS
+const long long MAX_MEASURED_STAGGER_MS = 60000;
+const int SETTLE_GRACE_MS = 30000;               // Сверх окна: пауза HumanBehavior и сама проверка
+const size_t LIST_SIZES[] = {100, 1000, 10000};
+
+typedef std::chrono::steady_clock Clock;
+
+}
+
+
+StartupBenchmark::StartupBenchmark(std::shared_ptr<Config> configInstance, size_t channelLimit)
+    : config(configInstance), maxChannels(std::max<size_t>(1, channelLimit)) {
+    BenchmarkSupport::PrepareMonitorConfig(*config, BENCH_LOG_FILE);
+}
+
+
+double StartupBenchmark::MeasureLastFirstCheck(size_t channels, int warmupMs, double& startAllMs,
+                                               bool& allChecked) const {
+    config->Set("startup_warmup_ms", std::to_string(warmupMs));
+
+    std::vector<std::string> names;
+    names.reserve(channels);
+    for (size_t i = 0; i < channels; i++) {
+        names.push_back("bench_" + std::to_string(i));
+    }
+
+    MultiStreamMonitor monitor(config);
+    monitor.ApplyStreamerList(names);
+
+    auto start = Clock::now();
+    monitor.StartAll();
+    startAllMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    auto deadline = start + std::chrono::milliseconds(warmupMs + SETTLE_GRACE_MS);
+    allChecked = false;
+    while (Clock::now() < deadline) {
+        if (monitor.GetCheckedMonitorCount() >= channels) {
+            allChecked = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    double lastMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    monitor.StopAll();
+    return lastMs;
+}
+
+
+std::string StartupBenchmark::RunComparison() const {
+    int warmupMs = std::max(0, config->GetInt("startup_warmup_ms", Constants::STARTUP_WARMUP_MS));
+
+    std::vector<size_t> sizes;
+    for (size_t size : LIST_SIZES) {
+        if (size < maxChannels) {
+            sizes.push_back(size);
+        }
+    }
+    sizes.push_back(maxChannels);
+
+    std::vector<StartupBenchmarkResult> results;
+    for (size_t channels : sizes) {
+        StartupBenchmarkResult result;
+        result.channels = channels;
+
+        bool checked = false;
+        result.warmupLastMs = MeasureLastFirstCheck(channels, warmupMs, result.startAllMs, checked);
+        result.allChecked = checked;
+
+        long long staggerMs = static_cast<long long>(channels) * LEGACY_STAGGER_MS;
+        if (staggerMs <= MAX_MEASURED_STAGGER_MS) {
+            double unused = 0.0;
+            result.staggerLastMs = MeasureLastFirstCheck(channels, static_cast<int>(staggerMs), unused, checked);
+            result.staggerMeasured = true;
+            result.allChecked = result.allChecked && checked;
+        } else {
+            result.staggerLastMs = static_cast<double>((channels - 1) * LEGACY_STAGGER_MS);
+        }
+        results.push_back(result);
+    }
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(10) << "channels"
+       << std::right << std::setw(14) << "StartAll, ms"
+       << std::setw(18) << "warm-up last, s"
+       << std::setw(18) << "stagger last, s"
+       << std::setw(12) << "all seen" << "\n";
+
+    for (const auto& result : results) {
+        std::ostringstream stagger;
+        stagger << std::fixed << std::setprecision(1) << (result.staggerMeasured ? "" : "~")
+                << result.staggerLastMs / 1000.0;
+
+        ss << std::left << std::setw(10) << result.channels
+           << std::right << std::fixed << std::setprecision(1) << std::setw(14) << result.startAllMs
+           << std::setw(18) << result.warmupLastMs / 1000.0
+           << std::setw(18) << stagger.str()
+           << std::setw(12) << (result.allChecked ? "yes" : "NO") << "\n";
+    }
+    ss << "\n~ - by construction: (N - 1) * " << LEGACY_STAGGER_MS << " ms, not run\n";
+
+    return ss.str();
+}
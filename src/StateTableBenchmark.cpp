@@ -0,0 +1,188 @@
+#include "StateTableBenchmark.h"
+#include "ChannelStateTable.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+const long long NOW = 1700000000;
+const int CHECK_INTERVAL = 60;
+const int CHECK_INTERVAL_FAST = 10;
+const int FAST_MODE_DURATION = 600;
+const double ONLINE_SHARE = 0.05;     // Доля каналов в эфире
+const double RECENT_SHARE = 0.10;     // Доля недавно закончивших эфир
+const size_t SCATTER_BYTES = 256;     // Чужие аллокации между объектами, как у мониторов в --multi
+
+
+// Горячие поля в окружении холодных, примерно как в StreamMonitor (~400 B на объект)
+struct MonitorLike {
+    char name[32];
+    std::atomic<bool> wasOnlineBefore;
+    std::atomic<bool> shouldStop;
+    char synchronization[88];         // stopMutex, stopCondition
+    long long lastOnlineTimestamp;
+    int checkCount;
+    void* subsystems[12];             // logger, scraper, statistics, predictor и т. д.
+    int checkInterval;
+    int checkIntervalFast;
+    int fastModeDuration;
+    char settings[164];
+
+    MonitorLike() : name(), wasOnlineBefore(false), shouldStop(false), synchronization(),
+                    lastOnlineTimestamp(0), checkCount(0), subsystems(), checkInterval(0),
+                    checkIntervalFast(0), fastModeDuration(0), settings() {}
+};
+
+
+struct ChannelSeed {
+    bool online;
+    long long lastOnline;
+};
+
+
+std::vector<ChannelSeed> MakeSeeds(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> share(0.0, 1.0);
+    std::uniform_int_distribution<int> age(0, 2 * FAST_MODE_DURATION);
+
+    std::vector<ChannelSeed> seeds(count);
+    for (auto& seed : seeds) {
+        double roll = share(rng);
+        seed.online = roll < ONLINE_SHARE;
+        seed.lastOnline = (roll < ONLINE_SHARE + RECENT_SHARE) ? NOW - age(rng) : 0;
+    }
+    return seeds;
+}
+
+
+void Fill(MonitorLike& monitor, const ChannelSeed& seed) {
+    monitor.wasOnlineBefore.store(seed.online, std::memory_order_relaxed);
+    monitor.lastOnlineTimestamp = seed.lastOnline;
+    monitor.checkInterval = CHECK_INTERVAL;
+    monitor.checkIntervalFast = CHECK_INTERVAL_FAST;
+    monitor.fastModeDuration = FAST_MODE_DURATION;
+}
+
+
+// Тот же подсчет, что в ChannelStateTable::Summarize
+template <typename Monitor>
+void Count(const Monitor& monitor, StateTableBenchmarkResult& result) {
+    long long lastOnline = monitor.lastOnlineTimestamp;
+    bool fast = lastOnline > 0 && NOW - lastOnline < monitor.fastModeDuration;
+    result.online += monitor.wasOnlineBefore.load(std::memory_order_relaxed) ? 1 : 0;
+    result.fastMode += fast ? 1 : 0;
+}
+
+
+// rounds проходов sweep(result), время - на запись
+template <typename Sweep>
+StateTableBenchmarkResult Measure(const std::string& layout, size_t entries, int rounds, Sweep sweep) {
+    StateTableBenchmarkResult result;
+    result.layout = layout;
+
+    double best = 0.0;
+    double total = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        StateTableBenchmarkResult pass;
+        auto start = std::chrono::steady_clock::now();
+        sweep(pass);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        best = (round == 0) ? ns : std::min(best, ns);
+        total += ns;
+        result.online = pass.online;
+        result.fastMode = pass.fastMode;
+    }
+
+    double count = static_cast<double>(entries);
+    result.bestNsPerEntry = best / count;
+    result.meanNsPerEntry = total / rounds / count;
+    return result;
+}
+
+}
+
+
+StateTableBenchmark::StateTableBenchmark(size_t entryCount, int roundCount)
+    : entries(std::max<size_t>(1, entryCount)), rounds(std::max(1, roundCount)) {
+}
+
+
+std::string StateTableBenchmark::RunComparison() const {
+    std::vector<ChannelSeed> seeds = MakeSeeds(entries);
+    std::vector<StateTableBenchmarkResult> results;
+
+    // Как реестр: указатели на отдельно выделенные объекты, порядок списка не совпадает с порядком в куче
+    {
+        std::vector<std::unique_ptr<MonitorLike>> monitors;
+        std::vector<std::unique_ptr<char[]>> scatter;
+        monitors.reserve(entries);
+        scatter.reserve(entries);
+        for (size_t i = 0; i < entries; i++) {
+            monitors.push_back(std::make_unique<MonitorLike>());
+            Fill(*monitors.back(), seeds[i]);
+            scatter.push_back(std::make_unique<char[]>(SCATTER_BYTES));
+        }
+        std::shuffle(monitors.begin(), monitors.end(), std::mt19937(7));
+
+        results.push_back(Measure("pointers", entries, rounds, [&monitors](StateTableBenchmarkResult& pass) {
+            for (const auto& monitor : monitors) {
+                Count(*monitor, pass);
+            }
+        }));
+    }
+
+    {
+        std::vector<MonitorLike> monitors(entries);
+        for (size_t i = 0; i < entries; i++) {
+            Fill(monitors[i], seeds[i]);
+        }
+
+        results.push_back(Measure("aos", entries, rounds, [&monitors](StateTableBenchmarkResult& pass) {
+            for (const auto& monitor : monitors) {
+                Count(monitor, pass);
+            }
+        }));
+    }
+
+    {
+        ChannelStateTable table;
+        for (size_t i = 0; i < entries; i++) {
+            uint32_t slot = table.Allocate(CHECK_INTERVAL, CHECK_INTERVAL_FAST, FAST_MODE_DURATION);
+            table.SetFlag(slot, ChannelStateTable::ONLINE, seeds[i].online);
+            table.SetLastOnline(slot, seeds[i].lastOnline);
+        }
+
+        results.push_back(Measure("soa", entries, rounds, [&table](StateTableBenchmarkResult& pass) {
+            ChannelStateSummary summary = table.Summarize(NOW);
+            pass.online = summary.online;
+            pass.fastMode = summary.fastMode;
+        }));
+    }
+
+    std::ostringstream ss;
+    ss << "sizeof(MonitorLike) = " << sizeof(MonitorLike) << " B, hot state in the table = "
+       << (sizeof(uint8_t) + sizeof(long long) + 3 * sizeof(int32_t)) << " B per channel\n\n";
+    ss << std::left << std::setw(10) << "layout"
+       << std::right << std::setw(14) << "best, ns/ch"
+       << std::setw(14) << "mean, ns/ch"
+       << std::setw(12) << "online"
+       << std::setw(12) << "fast" << "\n";
+
+    for (const auto& result : results) {
+        ss << std::left << std::setw(10) << result.layout
+           << std::right << std::fixed << std::setprecision(2) << std::setw(14) << result.bestNsPerEntry
+           << std::setw(14) << result.meanNsPerEntry
+           << std::setw(12) << result.online
+           << std::setw(12) << result.fastMode << "\n";
+    }
+
+    return ss.str();
+}
@@ -6,36 +6,47 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <filesystem>
 
 
 Statistics::Statistics(const std::string& streamer, const std::string& statsFile)
     : streamerName(streamer), statsFilePath(statsFile),
       totalChecks(0), onlineDetections(0), offlineDetections(0),
       totalCheckTime(0), fastestCheck(999999), slowestCheck(0),
-      currentSessionStart(0) {
+      totalBytesReceived(0), totalBytesNeeded(0), earlyAborts(0),
+      probeChecks(0), fullFetchesSkipped(0), sessionsLoaded(true), sessionsSaved(true),
+      currentSessionStart(0), firstSeen(0), dirty(false) {
     
-    // Извлекаем путь к папке
+    // Извлекаем путь к папке. Без shell: в --multi конструктор вызывается на каждый канал
     size_t lastSlash = statsFile.find_last_of("/\\");
     if (lastSlash != std::string::npos) {
         std::string directory = statsFile.substr(0, lastSlash);
         
-        #ifdef _WIN32
-            std::string command = "if not exist \"" + directory + "\" mkdir \"" + directory + "\" >nul 2>&1";
-            system(command.c_str());
-        #else
-            std::string command = "mkdir -p \"" + directory + "\" 2>/dev/null";
-            system(command.c_str());
-        #endif
-        
-        std::cout << "[Statistics] Created directory: " << directory << std::endl;
+        std::error_code error;
+        if (std::filesystem::create_directories(directory, error)) {
+            std::cout << "[Statistics] Created directory: " << directory << std::endl;
+        }
     }
     
     LoadFromFile();
+    
+    // Старые файлы без first_seen: история начинается с первой сессии
+    if (firstSeen == 0) {
+        firstSeen = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        for (const auto& session : sessions) {
+            firstSeen = std::min(firstSeen, session.startTime);
+        }
+    }
 }
 
 
 Statistics::~Statistics() {
-    SaveToFile();
+    // После Save() при остановке повторно файл не переписываем
+    if (dirty) {
+        SaveToFile();
+    }
 }
 
 
@@ -52,6 +63,7 @@ void Statistics::TrimOldSessions() {
 void Statistics::RecordCheck(long long checkTimeMs) {
     std::lock_guard<std::mutex> lock(statsMutex);
     
+    dirty = true;
     totalChecks++;
     totalCheckTime += checkTimeMs;
     
@@ -64,9 +76,33 @@ void Statistics::RecordCheck(long long checkTimeMs) {
 }
 
 
+void Statistics::RecordTransfer(long long bytesReceived, long long bytesNeeded, bool abortedEarly) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    
+    dirty = true;
+    totalBytesReceived += bytesReceived;
+    totalBytesNeeded += bytesNeeded;
+    if (abortedEarly) {
+        earlyAborts++;
+    }
+}
+
+
+void Statistics::RecordProbe(bool fullFetchSkipped) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    
+    dirty = true;
+    probeChecks++;
+    if (fullFetchSkipped) {
+        fullFetchesSkipped++;
+    }
+}
+
+
 void Statistics::RecordStreamOnline() {
     std::lock_guard<std::mutex> lock(statsMutex);
     
+    dirty = true;
     onlineDetections++;
     
     if (currentSessionStart == 0) {
@@ -80,6 +116,7 @@ void Statistics::RecordStreamOnline() {
 void Statistics::RecordStreamOffline() {
     std::lock_guard<std::mutex> lock(statsMutex);
     
+    dirty = true;
     offlineDetections++;
     
     if (currentSessionStart > 0) {
@@ -93,7 +130,9 @@ void Statistics::RecordStreamOffline() {
             static_cast<int>(endTime - currentSessionStart)
         );
         
+        LoadSessions();
         sessions.push_back(session);
+        sessionsSaved = false;
         currentSessionStart = 0;
         
         TrimOldSessions();
@@ -140,14 +179,46 @@ long long Statistics::GetSlowestCheck() const {
 }
 
 
+long long Statistics::GetTotalBytesReceived() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return totalBytesReceived;
+}
+
+
+long long Statistics::GetTotalBytesNeeded() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return totalBytesNeeded;
+}
+
+
+int Statistics::GetEarlyAborts() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return earlyAborts;
+}
+
+
+int Statistics::GetProbeChecks() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return probeChecks;
+}
+
+
+int Statistics::GetFullFetchesSkipped() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return fullFetchesSkipped;
+}
+
+
 int Statistics::GetTotalStreams() const {
     std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
     return static_cast<int>(sessions.size());
 }
 
 
 long long Statistics::GetTotalStreamTime() const {
     std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
     
     long long total = 0;
     for (const auto& session : sessions) {
@@ -159,6 +230,7 @@ long long Statistics::GetTotalStreamTime() const {
 
 long long Statistics::GetAverageStreamDuration() const {
     std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
     
     if (sessions.empty()) return 0;
     return GetTotalStreamTime() / static_cast<long long>(sessions.size());
@@ -167,6 +239,7 @@ long long Statistics::GetAverageStreamDuration() const {
 
 long long Statistics::GetLongestStream() const {
     std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
     
     if (sessions.empty()) return 0;
     
@@ -181,6 +254,7 @@ long long Statistics::GetLongestStream() const {
 
 long long Statistics::GetShortestStream() const {
     std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
     
     if (sessions.empty()) return 0;
     
@@ -193,8 +267,22 @@ long long Statistics::GetShortestStream() const {
 }
 
 
+std::vector<StreamSession> Statistics::GetSessions() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
+    return sessions;
+}
+
+
+long long Statistics::GetFirstSeen() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return firstSeen;
+}
+
+
 std::string Statistics::GetSummaryString() const {
     std::lock_guard<std::mutex> lock(statsMutex);
+    LoadSessions();
     
     std::stringstream ss;
     
@@ -214,6 +302,14 @@ std::string Statistics::GetSummaryString() const {
     ss << "║   Slowest check:               " << std::right << std::setw(23) << slowestCheck << " ms ║\n";
     ss << "║                                                               ║\n";
     
+    ss << "║ Traffic:                                                      ║\n";
+    ss << "║   Bytes received:              " << std::right << std::setw(23) << totalBytesReceived << " B  ║\n";
+    ss << "║   Bytes needed for verdict:    " << std::right << std::setw(23) << totalBytesNeeded << " B  ║\n";
+    ss << "║   Transfers aborted early:     " << std::right << std::setw(28) << earlyAborts << " ║\n";
+    ss << "║   Probe checks:                " << std::right << std::setw(28) << probeChecks << " ║\n";
+    ss << "║   Full fetches skipped:        " << std::right << std::setw(28) << fullFetchesSkipped << " ║\n";
+    ss << "║                                                               ║\n";
+    
     ss << "║ Stream Sessions:                                              ║\n";
     ss << "║   Total streams recorded:      " << std::right << std::setw(28) << sessions.size() << " ║\n";
     
@@ -277,7 +373,14 @@ void Statistics::Reset() {
     totalCheckTime = 0;
     fastestCheck = 999999;
     slowestCheck = 0;
+    totalBytesReceived = 0;
+    totalBytesNeeded = 0;
+    earlyAborts = 0;
+    probeChecks = 0;
+    fullFetchesSkipped = 0;
     sessions.clear();
+    sessionsLoaded = true;
+    sessionsSaved = false;
     currentSessionStart = 0;
     
     SaveToFile();
@@ -285,11 +388,13 @@ void Statistics::Reset() {
 
 
 void Statistics::Save() {
+    std::lock_guard<std::mutex> lock(statsMutex);
     SaveToFile();
 }
 
 
 bool Statistics::SaveToFile() {
+    LoadSessions();  // Файл переписывается целиком: выгруженная история не должна пропасть
     std::ofstream file(statsFilePath);
     
     if (!file.is_open()) {
@@ -309,6 +414,12 @@ bool Statistics::SaveToFile() {
     file << "  \"total_check_time\": " << totalCheckTime << ",\n";
     file << "  \"fastest_check\": " << (fastestCheck == 999999 ? 0 : fastestCheck) << ",\n";
     file << "  \"slowest_check\": " << slowestCheck << ",\n";
+    file << "  \"total_bytes_received\": " << totalBytesReceived << ",\n";
+    file << "  \"total_bytes_needed\": " << totalBytesNeeded << ",\n";
+    file << "  \"early_aborts\": " << earlyAborts << ",\n";
+    file << "  \"probe_checks\": " << probeChecks << ",\n";
+    file << "  \"full_fetches_skipped\": " << fullFetchesSkipped << ",\n";
+    file << "  \"first_seen\": " << firstSeen << ",\n";
     file << "  \"sessions\": [\n";
     
     for (size_t i = 0; i < sessions.size(); i++) {
@@ -327,6 +438,8 @@ bool Statistics::SaveToFile() {
     file << "}\n";
     
     file.close();
+    dirty = false;
+    sessionsSaved = true;
     
     std::cout << "[Statistics] File saved successfully" << std::endl;
     return true;
@@ -342,6 +455,7 @@ bool Statistics::LoadFromFile() {
     }
     
     std::string line;
+    StreamSession session;
     while (std::getline(file, line)) {
         // Парсим основные поля (упрощенный парсинг)
         try {
@@ -381,11 +495,111 @@ bool Statistics::LoadFromFile() {
                     slowestCheck = StringUtils::SafeStoll(line.substr(pos + 1), 0);
                 }
             }
+            else if (line.find("\"total_bytes_received\":") != std::string::npos) {
+                size_t pos = line.find(":");
+                if (pos != std::string::npos) {
+                    totalBytesReceived = StringUtils::SafeStoll(line.substr(pos + 1), 0);
+                }
+            }
+            else if (line.find("\"total_bytes_needed\":") != std::string::npos) {
+                size_t pos = line.find(":");
+                if (pos != std::string::npos) {
+                    totalBytesNeeded = StringUtils::SafeStoll(line.substr(pos + 1), 0);
+                }
+            }
+            else if (line.find("\"early_aborts\":") != std::string::npos) {
+                size_t pos = line.find(":");
+                if (pos != std::string::npos) {
+                    earlyAborts = StringUtils::SafeStoi(line.substr(pos + 1), 0);
+                }
+            }
+            else if (line.find("\"probe_checks\":") != std::string::npos) {
+                size_t pos = line.find(":");
+                if (pos != std::string::npos) {
+                    probeChecks = StringUtils::SafeStoi(line.substr(pos + 1), 0);
+                }
+            }
+            else if (line.find("\"full_fetches_skipped\":") != std::string::npos) {
+                size_t pos = line.find(":");
+                if (pos != std::string::npos) {
+                    fullFetchesSkipped = StringUtils::SafeStoi(line.substr(pos + 1), 0);
+                }
+            }
+            else if (line.find("\"first_seen\":") != std::string::npos) {
+                size_t pos = line.find(":");
+                if (pos != std::string::npos) {
+                    firstSeen = StringUtils::SafeStoll(line.substr(pos + 1), 0);
+                }
+            }
+            else {
+                ParseSessionLine(line, session, sessions);
+            }
         } catch (const std::exception& e) {
             std::cerr << "Warning: Error parsing statistics file: " << e.what() << std::endl;
         }
     }
     
     file.close();
+    TrimOldSessions();
     return true;
+}
+
+
+void Statistics::ParseSessionLine(const std::string& line, StreamSession& session,
+                                  std::vector<StreamSession>& out) {
+    // Сессии: duration - последнее поле объекта
+    if (line.find("\"start_time\":") != std::string::npos) {
+        size_t pos = line.find(":");
+        if (pos != std::string::npos) {
+            session.startTime = StringUtils::SafeStoll(line.substr(pos + 1), 0);
+        }
+    }
+    else if (line.find("\"end_time\":") != std::string::npos) {
+        size_t pos = line.find(":");
+        if (pos != std::string::npos) {
+            session.endTime = StringUtils::SafeStoll(line.substr(pos + 1), 0);
+        }
+    }
+    else if (line.find("\"duration\":") != std::string::npos) {
+        size_t pos = line.find(":");
+        if (pos != std::string::npos) {
+            session.duration = StringUtils::SafeStoi(line.substr(pos + 1), 0);
+            if (session.startTime > 0) {
+                out.push_back(session);
+            }
+            session = StreamSession();
+        }
+    }
+}
+
+
+void Statistics::LoadSessions() const {
+    if (sessionsLoaded) {
+        return;
+    }
+    sessionsLoaded = true;
+    
+    // Счетчики в памяти новее файла - читаем только сессии
+    std::ifstream file(statsFilePath);
+    std::string line;
+    StreamSession session;
+    while (std::getline(file, line)) {
+        try {
+            ParseSessionLine(line, session, sessions);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Error parsing statistics file: " << e.what() << std::endl;
+        }
+    }
+}
+
+
+void Statistics::ReleaseSessions() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    
+    // Несохраненную сессию держим до записи файла
+    if (!sessionsLoaded || !sessionsSaved) {
+        return;
+    }
+    std::vector<StreamSession>().swap(sessions);
+    sessionsLoaded = false;
 }
\ No newline at end of file
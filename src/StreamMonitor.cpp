@@ -2,95 +2,105 @@
 #include "StringUtils.h"
 #include "Constants.h"
 #include <iostream>
-#include <thread>
 #include <chrono>
+#include <algorithm>
+
+
+namespace {
+
+// Имя проверяется до интернирования: в таблицу имен не попадает мусор
+StreamerId InternValidName(const std::string& name, const MonitorContext& context) {
+    if (!StringUtils::IsValidStreamerName(name)) {
+        throw std::invalid_argument("Invalid streamer name: " + name);
+    }
+    return context.GetStreamerNames()->Intern(name);
+}
+
+}
 
 
 StreamMonitor::StreamMonitor(const std::string& streamer, const std::string& configPath)
-    : streamerName(streamer), wasOnlineBefore(false), shouldStop(false), 
-      lastOnlineTimestamp(0) {
-    
-    std::cout << "[DEBUG] StreamMonitor constructor START" << std::endl;
+    : StreamMonitor(streamer, MonitorContext::CreateStandalone(configPath)) {
+}
+
+
+StreamMonitor::StreamMonitor(const std::string& streamer, std::shared_ptr<MonitorContext> contextInstance)
+    : StreamMonitor(InternValidName(streamer, *contextInstance), contextInstance) {
+}
+
+
+StreamMonitor::StreamMonitor(StreamerId streamer, std::shared_ptr<MonitorContext> contextInstance)
+    : streamerId(streamer),
+      streamerRecord(contextInstance->GetStreamerNames()->Get(streamerId)), streamerName(streamerRecord.name),
+      stateTable(contextInstance->GetStateTable()), stateSlot(0),
+      checkCount(0), logger(contextInstance->GetLogger()),
+      context(contextInstance), eventDrainQueued(false) {
+    
+    // Трасса и баннеры - только у одиночного монитора: в --multi их были бы тысячи
+    bool trace = context->IsStandalone();
+    const Config& config = context->GetConfig();
+    
+    if (trace) std::cout << "[DEBUG] StreamMonitor constructor START" << std::endl;
+    
+    int checkInterval = config.GetInt("check_interval", Constants::DEFAULT_CHECK_INTERVAL);
+    int checkIntervalFast = config.GetInt("check_interval_fast", Constants::FAST_CHECK_INTERVAL);
+    int fastModeDuration = config.GetInt("fast_mode_duration", Constants::FAST_MODE_DURATION);
+    enableNotifications = config.GetBool("enable_notifications", true);
+    enableStatistics = config.GetBool("enable_statistics", true);
+    predictivePolling = StringUtils::ToLower(config.GetString("poll_strategy", "predictive")) == "predictive";
     
-    if (!StringUtils::IsValidStreamerName(streamerName)) {
-        throw std::invalid_argument("Invalid streamer name: " + streamerName);
+    notification = std::make_unique<Notification>(enableNotifications);
+    statistics = std::make_unique<Statistics>(streamerName, StreamerNameTable::StatsPathFor(streamerName));
+    
+    // Профиль стартов строится по сохраненным сессиям и дальше дополняется по одной
+    pollPredictor = std::make_unique<PollPredictor>(
+        context->GetPollBudget(),
+        checkIntervalFast, config.GetInt("poll_max_interval", Constants::POLL_MAX_INTERVAL),
+        statistics->GetFirstSeen());
+    for (const auto& session : statistics->GetSessions()) {
+        pollPredictor->RecordStart(session.startTime);
     }
-    std::cout << "[DEBUG] Streamer name validated: " << streamerName << std::endl;
-    
-    // Создаем папки
-    #ifdef _WIN32
-        system("if not exist logs mkdir logs >nul 2>&1");
-        system("if not exist stats mkdir stats >nul 2>&1");
-    #else
-        system("mkdir -p logs 2>/dev/null");
-        system("mkdir -p stats 2>/dev/null");
-    #endif
-    std::cout << "[DEBUG] Folders created" << std::endl;
-    
-    std::cout << "[DEBUG] Creating logger..." << std::endl;
-    logger = std::make_shared<Logger>("logs/stream_monitor.log");
-    std::cout << "[DEBUG] Logger created" << std::endl;
-    
-    std::cout << "[DEBUG] Creating config..." << std::endl;
-    config = std::make_unique<Config>(configPath);
-    std::cout << "[DEBUG] Config created" << std::endl;
-    
-    std::cout << "[DEBUG] Loading config..." << std::endl;
-    if (!config->Load()) {
-        logger->Warning("Failed to load config, using defaults", "StreamMonitor");
-        std::cout << "[DEBUG] Config load failed, using defaults" << std::endl;
-    } else {
-        std::cout << "[DEBUG] Config loaded successfully" << std::endl;
+    if (context->IsMemoryBudget()) {
+        statistics->ReleaseSessions();  // Профиль уже построен; история - в stats/
     }
     
-    logger->SetVerbose(config->GetBool("verbose_logging", false));
-    std::cout << "[DEBUG] Verbose logging set" << std::endl;
-    
-    checkInterval = config->GetInt("check_interval", Constants::DEFAULT_CHECK_INTERVAL);
-    checkIntervalFast = config->GetInt("check_interval_fast", Constants::FAST_CHECK_INTERVAL);
-    fastModeDuration = config->GetInt("fast_mode_duration", Constants::FAST_MODE_DURATION);
-    enableNotifications = config->GetBool("enable_notifications", true);
-    enableStatistics = config->GetBool("enable_statistics", true);
-    std::cout << "[DEBUG] Config values loaded" << std::endl;
-    
-    std::cout << "[DEBUG] Creating notification..." << std::endl;
-    notification = std::make_unique<Notification>(enableNotifications);
-    std::cout << "[DEBUG] Notification created" << std::endl;
-    
-    std::cout << "[DEBUG] Creating statistics..." << std::endl;
-    statistics = std::make_unique<Statistics>(streamerName, "stats/stats_" + streamerName + ".json");
-    std::cout << "[DEBUG] Statistics created" << std::endl;
+    if (trace) std::cout << "[DEBUG] Creating webScraper (initializing cURL)..." << std::endl;
+    webScraper = std::make_unique<WebScraper>(context);
     
-    std::cout << "[DEBUG] Creating webScraper..." << std::endl;
-    std::cout << "[DEBUG] This might take a moment (initializing cURL)..." << std::endl;
-    webScraper = std::make_unique<WebScraper>(logger, *config);
-    std::cout << "[DEBUG] WebScraper created" << std::endl;
+    failurePolicy = std::make_unique<FailurePolicy>(
+        logger,
+        context->GetHostBackoff(),
+        config.GetInt("retry_fast_max", Constants::RETRY_FAST_MAX),
+        config.GetInt("breaker_threshold", Constants::BREAKER_THRESHOLD),
+        config.GetInt("breaker_cooldown", Constants::BREAKER_COOLDOWN_SECONDS),
+        context->NextSeed());
     
-    bool openBrowser = config->GetBool("open_browser", true);
-    std::cout << "[DEBUG] Creating browserController (enabled: " << (openBrowser ? "YES" : "NO") << ")..." << std::endl;
+    bool openBrowser = config.GetBool("open_browser", true);
     browserController = std::make_unique<BrowserController>(logger, openBrowser);
-    std::cout << "[DEBUG] BrowserController created" << std::endl;
-    
-    logger->System("=== Stream Monitor v2.3 initialized ===", "StreamMonitor");
-    logger->System("Monitoring streamer: " + streamerName, "StreamMonitor");
-    logger->Info("Configuration loaded from: " + configPath, "StreamMonitor");
-    logger->Info("Features: Notifications=" + std::string(enableNotifications ? "ON" : "OFF") +
-                ", Statistics=" + std::string(enableStatistics ? "ON" : "OFF"), "StreamMonitor");
     
-    std::cout << "[DEBUG] Checking if WebScraper initialized..." << std::endl;
     if (!webScraper->IsInitialized()) {
-        std::cout << "[DEBUG] ERROR: WebScraper NOT initialized!" << std::endl;
-        logger->Critical("Failed to initialize WebScraper", "StreamMonitor");
+        logger->Critical("Failed to initialize WebScraper for " + streamerName, "StreamMonitor");
         throw std::runtime_error("WebScraper initialization failed");
     }
-    std::cout << "[DEBUG] WebScraper is initialized" << std::endl;
     
-    std::cout << "[DEBUG] StreamMonitor constructor END" << std::endl;
-    std::cout << "[DEBUG] ============================================\n" << std::endl;
+    // Последним: конструктор дальше не бросает, номер освободит деструктор
+    stateSlot = stateTable->Allocate(checkInterval, checkIntervalFast, fastModeDuration);
+    
+    if (trace) {
+        logger->System("=== Stream Monitor v2.3 initialized ===", "StreamMonitor");
+        logger->System("Monitoring streamer: " + streamerName, "StreamMonitor");
+        logger->Info("Features: Notifications=" + std::string(enableNotifications ? "ON" : "OFF") +
+                    ", Statistics=" + std::string(enableStatistics ? "ON" : "OFF"), "StreamMonitor");
+        std::cout << "[DEBUG] StreamMonitor constructor END (browser: " << (openBrowser ? "YES" : "NO") << ")" << std::endl;
+        std::cout << "[DEBUG] ============================================\n" << std::endl;
+    }
 }
 
 StreamMonitor::~StreamMonitor() {
-    logger->System("=== Stream Monitor shutdown ===", "StreamMonitor");
+    if (context->IsStandalone()) {
+        logger->System("=== Stream Monitor shutdown ===", "StreamMonitor");
+    }
+    stateTable->Release(stateSlot);
 }
 
 
@@ -103,15 +113,22 @@ long long StreamMonitor::GetUnixTimestamp() const {
 
 int StreamMonitor::GetCurrentCheckInterval() {
     long long currentTime = GetUnixTimestamp();
+    long long lastOnlineTimestamp = stateTable->GetLastOnline(stateSlot);
     long long timeSinceLastOnline = currentTime - lastOnlineTimestamp;
+    int checkIntervalFast = stateTable->GetCheckIntervalFast(stateSlot);
     
-    if (lastOnlineTimestamp > 0 && timeSinceLastOnline < fastModeDuration) {
+    if (lastOnlineTimestamp > 0 && timeSinceLastOnline < stateTable->GetFastModeDuration(stateSlot)) {
         logger->Debug("Using FAST check interval (" + std::to_string(checkIntervalFast) + "s)", 
                      "StreamMonitor");
         return checkIntervalFast;
     }
     
-    return checkInterval;
+    // Пока стрим идет, интервал обычный: ждем его конца, а не начала
+    if (predictivePolling && !IsOnline()) {
+        return pollPredictor->NextIntervalSec(currentTime);
+    }
+    
+    return stateTable->GetCheckInterval(stateSlot);
 }
 
 
@@ -123,141 +140,370 @@ void StreamMonitor::HandleStreamOnline() {
     std::cout << "[ONLINE] " << streamerName << " started streaming!" << std::endl;
     logger->Event("Stream status changed: OFFLINE -> ONLINE", "StreamMonitor");
     
-    std::cout << "[StreamMonitor] Sending notification..." << std::endl;
-    if (enableNotifications && notification) {
-        notification->NotifyStreamOnline(streamerName);
+    long long now = GetUnixTimestamp();
+    stateTable->SetFlag(stateSlot, ChannelStateTable::ONLINE, true);
+    stateTable->SetLastOnline(stateSlot, now);
+    pollPredictor->RecordStart(now);
+    
+    // Уведомление и браузер могут блокировать - не держим ими проверку
+    DispatchEvent([this]() {
+        std::cout << "[StreamMonitor] Sending notification..." << std::endl;
+        if (enableNotifications && notification) {
+            notification->NotifyStreamOnline(streamerName);
+        }
+        
+        std::cout << "[StreamMonitor] Recording statistics..." << std::endl;
+        if (enableStatistics && statistics) {
+            statistics->RecordStreamOnline();
+        }
+        
+        std::cout << "[StreamMonitor] Opening browser..." << std::endl;
+        std::cout << "  browserController pointer: " << (browserController ? "VALID" : "NULL") << std::endl;
+        
+        if (browserController) {
+            std::cout << "  Calling browserController->OpenStream(\"" << streamerName << "\")..." << std::endl;
+            browserController->OpenStream(streamerName);
+            std::cout << "  browserController->OpenStream() returned" << std::endl;
+        } else {
+            std::cout << "  ERROR: browserController is NULL!" << std::endl;
+        }
+        
+        std::cout << "\n[StreamMonitor] HandleStreamOnline completed\n" << std::endl;
+    });
+}
+
+
+void StreamMonitor::HandleStreamOffline() {
+    std::cout << "[OFFLINE] " << streamerName << " ended stream" << std::endl;
+    logger->Event("Stream status changed: ONLINE -> OFFLINE", "StreamMonitor");
+    
+    stateTable->SetFlag(stateSlot, ChannelStateTable::ONLINE, false);
+    stateTable->SetLastOnline(stateSlot, GetUnixTimestamp());
+    
+    DispatchEvent([this]() {
+        if (enableNotifications && notification) {
+            notification->NotifyStreamOffline(streamerName);
+        }
+        
+        if (enableStatistics && statistics) {
+            statistics->RecordStreamOffline();
+            if (context->IsMemoryBudget()) {
+                statistics->ReleaseSessions();
+            }
+        }
+    });
+}
+
+
+void StreamMonitor::DispatchEvent(std::function<void()> event) {
+    if (!eventExecutor) {
+        event();
+        return;
     }
     
-    std::cout << "[StreamMonitor] Recording statistics..." << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        pendingEvents.push_back(std::move(event));
+        if (eventDrainQueued) {
+            return;  // Уже разбирается: сохраняем порядок ONLINE -> OFFLINE
+        }
+        eventDrainQueued = true;
+    }
+    
+    std::shared_ptr<StreamMonitor> self = shared_from_this();
+    if (!eventExecutor->Submit([self]() { self->DrainEvents(); })) {
+        DrainEvents();  // Пул остановлен
+    }
+}
+
+
+void StreamMonitor::DrainEvents() {
+    while (true) {
+        std::function<void()> event;
+        {
+            std::lock_guard<std::mutex> lock(eventMutex);
+            if (pendingEvents.empty()) {
+                eventDrainQueued = false;
+                return;
+            }
+            event = std::move(pendingEvents.front());
+            pendingEvents.pop_front();
+        }
+        
+        try {
+            event();
+        } catch (const std::exception& e) {
+            logger->Error("Exception in status event: " + std::string(e.what()), "StreamMonitor");
+        }
+    }
+}
+
+
+void StreamMonitor::ProcessCheckResult(bool isCurrentlyOnline, long long checkDuration) {
     if (enableStatistics && statistics) {
-        statistics->RecordStreamOnline();
+        statistics->RecordCheck(checkDuration);
+        
+        const TransferStats& transfer = webScraper->GetLastTransferStats();
+        statistics->RecordTransfer(static_cast<long long>(transfer.bytesReceived),
+                                   static_cast<long long>(transfer.bytesNeeded),
+                                   transfer.abortedEarly);
+        if (transfer.probed) {
+            statistics->RecordProbe(transfer.fullFetchSkipped);
+        }
     }
     
-    std::cout << "[StreamMonitor] Opening browser..." << std::endl;
-    std::cout << "  browserController pointer: " << (browserController ? "VALID" : "NULL") << std::endl;
+    bool wasPreviouslyOnline = IsOnline();
     
-    if (browserController) {
-        std::cout << "  Calling browserController->OpenStream(\"" << streamerName << "\")..." << std::endl;
-        browserController->OpenStream(streamerName);
-        std::cout << "  browserController->OpenStream() returned" << std::endl;
-    } else {
-        std::cout << "  ERROR: browserController is NULL!" << std::endl;
+    // Трасса на каждую проверку - только у одиночного монитора, как и в конструкторе;
+    // в --multi строки [OK]/[WAIT] уходят в отладочный лог
+    bool trace = context->IsStandalone();
+    if (trace) {
+        std::cout << "[DEBUG] wasOnlineBefore: " << (wasPreviouslyOnline ? "TRUE" : "FALSE") << std::endl;
+        std::cout << "[DEBUG] isCurrentlyOnline: " << (isCurrentlyOnline ? "TRUE" : "FALSE") << std::endl;
     }
     
-    wasOnlineBefore = true;
-    lastOnlineTimestamp = GetUnixTimestamp();
-    
-    std::cout << "\n[StreamMonitor] HandleStreamOnline completed\n" << std::endl;
+    // КРИТИЧЕСКАЯ ПРОВЕРКА
+    if (isCurrentlyOnline && !wasPreviouslyOnline) {
+        if (trace) {
+            std::cout << "\n[DEBUG] *** CONDITION MET: Stream went from OFFLINE to ONLINE ***" << std::endl;
+            std::cout << "[DEBUG] *** Calling HandleStreamOnline() ***\n" << std::endl;
+        }
+        HandleStreamOnline();
+    } 
+    else if (!isCurrentlyOnline && wasPreviouslyOnline) {
+        if (trace) {
+            std::cout << "\n[DEBUG] *** CONDITION MET: Stream went from ONLINE to OFFLINE ***" << std::endl;
+            std::cout << "[DEBUG] *** Calling HandleStreamOffline() ***\n" << std::endl;
+        }
+        HandleStreamOffline();
+    }
+    else if (isCurrentlyOnline) {
+        if (trace) {
+            std::cout << "[OK] " << streamerName << " still online (" << checkDuration << "ms)" << std::endl;
+        } else if (logger->IsEnabled(LogLevel::DEBUG)) {
+            logger->Debug(streamerName + " still online (" + std::to_string(checkDuration) + "ms)", "StreamMonitor");
+        }
+        stateTable->SetLastOnline(stateSlot, GetUnixTimestamp());
+    }
+    else {
+        int interval = GetCurrentCheckInterval();
+        if (trace) {
+            std::cout << "[WAIT] " << streamerName << " still offline (" 
+                     << checkDuration << "ms, next in " << interval << "s)" << std::endl;
+        } else if (logger->IsEnabled(LogLevel::DEBUG)) {
+            logger->Debug(streamerName + " still offline (" + std::to_string(checkDuration) + "ms, next in " +
+                          std::to_string(interval) + "s)", "StreamMonitor");
+        }
+    }
 }
 
 
-void StreamMonitor::HandleStreamOffline() {
-    std::cout << "[OFFLINE] " << streamerName << " ended stream" << std::endl;
-    logger->Event("Stream status changed: ONLINE -> OFFLINE", "StreamMonitor");
+bool StreamMonitor::AcceptVerdict() {
+    FailureClass failure = webScraper->GetLastFailure();
+    if (failure == FailureClass::NONE) {
+        failurePolicy->OnSuccess(webScraper->GetPageHost());
+        return true;
+    }
     
-    if (enableNotifications && notification) {
-        notification->NotifyStreamOffline(streamerName);
+    // Сбой - не повод считать канал offline: статус прежний, повтор по классу ошибки
+    failurePolicy->OnFailure(failure, webScraper->GetPageHost());
+    
+    int retryMs = failurePolicy->GetRetryDelayMs();
+    if (context->IsStandalone()) {
+        std::cout << "[RETRY] " << streamerName << " check failed (" << FailurePolicy::ClassName(failure)
+                  << "), next in " << (retryMs >= 0 ? std::to_string(retryMs) + "ms" : "regular interval")
+                  << std::endl;
+    } else if (logger->IsEnabled(LogLevel::DEBUG)) {
+        logger->Debug(streamerName + " check failed (" + FailurePolicy::ClassName(failure) + "), next in " +
+                      (retryMs >= 0 ? std::to_string(retryMs) + "ms" : "regular interval"), "StreamMonitor");
+    }
+    return false;
+}
+
+
+bool StreamMonitor::BeginAsyncCheck() {
+    // Хост в backoff или breaker открыт: запрос не отправляем, планировщик возьмет GetRetryDelayMs
+    if (!failurePolicy->BeforeCheck(webScraper->GetPageHost())) {
+        return false;
     }
     
-    if (enableStatistics && statistics) {
-        statistics->RecordStreamOffline();
+    checkCount++;
+    asyncCheckStart = std::chrono::steady_clock::now();
+    webScraper->BeginCheck(streamerId);
+    return true;
+}
+
+
+CURL* StreamMonitor::CompleteAsyncCheck(CURLcode result, bool fromHedge) {
+    try {
+        // Двухфазная проверка: после probe может понадобиться полная загрузка
+        CURL* nextTransfer = webScraper->ContinueCheck(result, fromHedge);
+        if (nextTransfer) {
+            return nextTransfer;
+        }
+        
+        bool isCurrentlyOnline = webScraper->GetCheckVerdict();
+        if (!AcceptVerdict()) {
+            return nullptr;
+        }
+        
+        auto checkDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - asyncCheckStart
+        ).count();
+        
+        ProcessCheckResult(isCurrentlyOnline, checkDuration);
+        
+    } catch (const std::exception& e) {
+        std::string errorMsg = "Exception in async check: " + std::string(e.what());
+        logger->Critical(errorMsg, "StreamMonitor");
+        std::cerr << "[ERROR] " << streamerName << ": " << errorMsg << std::endl;
     }
     
-    wasOnlineBefore = false;
-    lastOnlineTimestamp = GetUnixTimestamp();
+    return nullptr;
 }
 
 
-void StreamMonitor::StartMonitoring() {
-    logger->System("Starting monitoring loop (v2.3)", "StreamMonitor");
+void StreamMonitor::AbortAsyncCheck() {
+    webScraper->AbortCheck();
     
-    std::cout << "\n+=======================================+" << std::endl;
-    std::cout << "|   Twitch Stream Monitor v2.3          |" << std::endl;
-    std::cout << "|   Refactored | Thread-Safe | Stable  |" << std::endl;
-    std::cout << "+=======================================+" << std::endl;
-    std::cout << std::endl;
-    
-    std::cout << "Monitoring: " << streamerName << std::endl;
-    std::cout << "Features:" << std::endl;
-    std::cout << "  - Notifications: " << (enableNotifications ? "ON" : "OFF") << std::endl;
-    std::cout << "  - Statistics: " << (enableStatistics ? "ON" : "OFF") << std::endl;
-    std::cout << "  - Check intervals: " << checkInterval << "s / " << checkIntervalFast << "s" << std::endl;
-    std::cout << "  - Browser control: " << (browserController->IsEnabled() ? "ON" : "OFF") << std::endl;
-    std::cout << std::endl;
-    std::cout << "Press Ctrl+C to stop (graceful shutdown supported)" << std::endl;
-    std::cout << std::endl;
-    
-    int checkCount = 0;
-    
-    while (!shouldStop.load()) {
-        try {
-            checkCount++;
+    // Счетчики лимитера - в PrintStatus; здесь только отладочная строка
+    if (logger->IsEnabled(LogLevel::DEBUG)) {
+        logger->Debug(streamerName + " check skipped by rate limiter", "StreamMonitor");
+    }
+}
+
+
+void StreamMonitor::RunCheckOnce() {
+    try {
+        if (!failurePolicy->BeforeCheck(webScraper->GetPageHost())) {
+            return;
+        }
+        
+        checkCount++;
+        
+        // Трасса проверки - только у одиночного монитора: RunCheckOnce идет и из пула --multi
+        bool trace = context->IsStandalone();
+        if (trace) {
             std::cout << "\n========== CHECK #" << checkCount << " ==========" << std::endl;
-            
-            auto checkStartTime = std::chrono::steady_clock::now();
-            
+        }
+        
+        auto checkStartTime = std::chrono::steady_clock::now();
+        
+        if (trace) {
             std::cout << "[DEBUG] Calling webScraper->CheckStreamStatus(\"" << streamerName << "\")..." << std::endl;
-            bool isCurrentlyOnline = webScraper->CheckStreamStatus(streamerName);
-            
-            auto checkEndTime = std::chrono::steady_clock::now();
-            auto checkDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                checkEndTime - checkStartTime
-            ).count();
-            
+        }
+        bool isCurrentlyOnline = webScraper->CheckStreamStatus(streamerId);
+        
+        // Лимитер не дождался токена: вердикта нет, статус не трогаем
+        if (webScraper->WasCheckDeferred()) {
+            if (logger->IsEnabled(LogLevel::DEBUG)) {
+                logger->Debug(streamerName + " check skipped by rate limiter", "StreamMonitor");
+            }
+            return;
+        }
+        
+        if (!AcceptVerdict()) {
+            return;
+        }
+        
+        auto checkEndTime = std::chrono::steady_clock::now();
+        auto checkDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            checkEndTime - checkStartTime
+        ).count();
+        
+        if (trace) {
             std::cout << "[DEBUG] CheckStreamStatus returned: " << (isCurrentlyOnline ? "TRUE (ONLINE)" : "FALSE (OFFLINE)") << std::endl;
             std::cout << "[DEBUG] Check duration: " << checkDuration << "ms" << std::endl;
-            
-            if (enableStatistics && statistics) {
-                statistics->RecordCheck(checkDuration);
-            }
-            
-            bool wasPreviouslyOnline = wasOnlineBefore.load();
-            std::cout << "[DEBUG] wasOnlineBefore: " << (wasPreviouslyOnline ? "TRUE" : "FALSE") << std::endl;
-            std::cout << "[DEBUG] isCurrentlyOnline: " << (isCurrentlyOnline ? "TRUE" : "FALSE") << std::endl;
-            
-            // КРИТИЧЕСКАЯ ПРОВЕРКА
-            if (isCurrentlyOnline && !wasPreviouslyOnline) {
-                std::cout << "\n[DEBUG] *** CONDITION MET: Stream went from OFFLINE to ONLINE ***" << std::endl;
-                std::cout << "[DEBUG] *** Calling HandleStreamOnline() ***\n" << std::endl;
-                HandleStreamOnline();
-            } 
-            else if (!isCurrentlyOnline && wasPreviouslyOnline) {
-                std::cout << "\n[DEBUG] *** CONDITION MET: Stream went from ONLINE to OFFLINE ***" << std::endl;
-                std::cout << "[DEBUG] *** Calling HandleStreamOffline() ***\n" << std::endl;
-                HandleStreamOffline();
-            }
-            else if (isCurrentlyOnline) {
-                std::cout << "[OK] " << streamerName << " still online (" << checkDuration << "ms)" << std::endl;
-                lastOnlineTimestamp = GetUnixTimestamp();
-            }
-            else {
-                int interval = GetCurrentCheckInterval();
-                std::cout << "[WAIT] " << streamerName << " still offline (" 
-                         << checkDuration << "ms, next in " << interval << "s)" << std::endl;
-            }
-            
-        } catch (const std::exception& e) {
-            std::string errorMsg = "Exception in monitoring loop: " + std::string(e.what());
-            logger->Critical(errorMsg, "StreamMonitor");
-            std::cerr << "[ERROR] " << streamerName << ": " << errorMsg << std::endl;
         }
         
-        int sleepInterval = GetCurrentCheckInterval();
-        std::cout << "[DEBUG] Sleeping for " << sleepInterval << " seconds..." << std::endl;
+        ProcessCheckResult(isCurrentlyOnline, checkDuration);
         
-        for (int i = 0; i < sleepInterval && !shouldStop.load(); ++i) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+    } catch (const std::exception& e) {
+        std::string errorMsg = "Exception in monitoring loop: " + std::string(e.what());
+        logger->Critical(errorMsg, "StreamMonitor");
+        std::cerr << "[ERROR] " << streamerName << ": " << errorMsg << std::endl;
+    }
+}
+
+
+void StreamMonitor::StartMonitoring() {
+    logger->System("Starting monitoring loop (v2.3)", "StreamMonitor");
+    
+    // Баннер и трасса цикла - только у одиночного монитора (в замере движков их тысячи)
+    bool trace = context->IsStandalone();
+    if (trace) {
+        std::cout << "\n+=======================================+" << std::endl;
+        std::cout << "|   Twitch Stream Monitor v2.3          |" << std::endl;
+        std::cout << "|   Refactored | Thread-Safe | Stable  |" << std::endl;
+        std::cout << "+=======================================+" << std::endl;
+        std::cout << std::endl;
+        
+        std::cout << "Monitoring: " << streamerName << std::endl;
+        std::cout << "Features:" << std::endl;
+        std::cout << "  - Notifications: " << (enableNotifications ? "ON" : "OFF") << std::endl;
+        std::cout << "  - Statistics: " << (enableStatistics ? "ON" : "OFF") << std::endl;
+        std::cout << "  - Check intervals: " << stateTable->GetCheckInterval(stateSlot) << "s / "
+                  << stateTable->GetCheckIntervalFast(stateSlot) << "s" << std::endl;
+        std::cout << "  - Poll strategy: " << (predictivePolling ? "predictive" : "fixed") << std::endl;
+        std::cout << "  - Browser control: " << (browserController->IsEnabled() ? "ON" : "OFF") << std::endl;
+        std::cout << std::endl;
+        std::cout << "Press Ctrl+C to stop (graceful shutdown supported)" << std::endl;
+        std::cout << std::endl;
+    }
+    
+    while (!IsStopped()) {
+        // Паузы "как у человека" выдерживаем здесь, до начала проверки:
+        // длительность проверки включает только сеть и разбор
+        if (WaitForStop(GetPacingDelayMs())) {
+            break;
         }
+        
+        RunCheckOnce();
+        
+        int retryMs = GetRetryDelayMs();
+        if (retryMs >= 0) {
+            if (trace) std::cout << "[DEBUG] Retrying in " << retryMs << " ms..." << std::endl;
+            WaitForStop(retryMs);
+            continue;
+        }
+        
+        int sleepInterval = GetCurrentCheckInterval();
+        if (trace) std::cout << "[DEBUG] Sleeping for " << sleepInterval << " seconds..." << std::endl;
+        
+        WaitForStop(sleepInterval * 1000);
     }
     
     logger->System("Monitoring loop stopped gracefully", "StreamMonitor");
-    std::cout << "\n[STOPPED] Monitoring for " << streamerName << " stopped." << std::endl;
+    if (trace) std::cout << "\n[STOPPED] Monitoring for " << streamerName << " stopped." << std::endl;
+}
+
+
+bool StreamMonitor::WaitForStop(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    return stopCondition.wait_for(lock, std::chrono::milliseconds(std::max(0, timeoutMs)),
+                                  [this]() { return IsStopped(); });
 }
 
 
 void StreamMonitor::Stop() {
     logger->System("Stop requested", "StreamMonitor");
-    shouldStop = true;
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stateTable->SetFlag(stateSlot, ChannelStateTable::STOPPED, true);
+    }
+    stopCondition.notify_all();
+    
+    if (webScraper) {
+        webScraper->Cancel();
+    }
+}
+
+
+void StreamMonitor::SaveStatistics() {
+    // Без enable_statistics записывать нечего: Record* не вызывались
+    if (enableStatistics && statistics) {
+        statistics->Save();
+    }
 }
 
 
@@ -271,6 +517,9 @@ void StreamMonitor::EnableNotifications(bool enable) {
 
 
 void StreamMonitor::EnableStatistics(bool enable) {
+    if (!enable) {
+        SaveStatistics();  // Накопленное до выключения
+    }
     enableStatistics = enable;
     logger->Info("Statistics " + std::string(enable ? "enabled" : "disabled"), "StreamMonitor");
 }
@@ -0,0 +1,203 @@
+#include "StreamerList.h"
+#include "StringUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace {
+
+const size_t MIN_CHUNK_BYTES = 256 * 1024;  // Меньше - поток дороже работы
+
+
+// Кусок текста, разобранный одним потоком. Номера строк - от начала куска
+struct ChunkResult {
+    std::vector<std::string_view> names;
+    std::vector<uint64_t> hashes;  // Считаются здесь же, в потоке куска
+    std::vector<uint32_t> nameLines;
+    std::vector<StreamerListReject> invalid;
+    size_t lines;
+
+    ChunkResult() : lines(0) {}
+};
+
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+
+std::string_view TrimLine(const char* begin, const char* end) {
+    while (begin < end && IsSpace(*begin)) begin++;
+    while (end > begin && IsSpace(end[-1])) end--;
+    return std::string_view(begin, static_cast<size_t>(end - begin));
+}
+
+
+void ParseChunk(const char* begin, const char* end, ChunkResult& result) {
+    // Имя - не длиннее 25 символов: строк примерно столько же, сколько байт / 10
+    size_t expected = static_cast<size_t>(end - begin) / 10;
+    result.names.reserve(expected);
+    result.hashes.reserve(expected);
+    result.nameLines.reserve(expected);
+    std::hash<std::string_view> hasher;
+
+    const char* lineStart = begin;
+    while (lineStart < end) {
+        const char* newline = static_cast<const char*>(memchr(lineStart, '\n', static_cast<size_t>(end - lineStart)));
+        const char* lineEnd = newline ? newline : end;
+
+        std::string_view line = TrimLine(lineStart, lineEnd);
+        if (!line.empty() && line[0] != '#') {
+            if (StringUtils::IsValidStreamerName(line)) {
+                result.names.push_back(line);
+                result.hashes.push_back(hasher(line));
+                result.nameLines.push_back(static_cast<uint32_t>(result.lines));
+            } else {
+                result.invalid.push_back({result.lines, line, false});
+            }
+        }
+
+        result.lines++;
+        lineStart = lineEnd + 1;
+    }
+}
+
+}
+
+
+StreamerListFile::StreamerListFile(const std::string& path) : data(nullptr), size(0), mapped(false) {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+            size = static_cast<size_t>(info.st_size);
+            mapped = true;
+        }
+    }
+    close(fd);
+
+    if (mapped) {
+        return;
+    }
+#endif
+
+    // Без mmap (Windows, пустой или особый файл): одно чтение целиком
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+}
+
+
+StreamerListFile::~StreamerListFile() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+
+namespace StreamerList {
+
+ParsedStreamerList Parse(std::string_view text, unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threads, text.size() / MIN_CHUNK_BYTES));
+
+    // Границы кусков - сразу после перевода строки, строка целиком в одном куске
+    std::vector<const char*> bounds;
+    bounds.push_back(text.data());
+    const char* textEnd = text.data() + text.size();
+    for (size_t i = 1; i < chunkCount; i++) {
+        const char* cut = std::max(bounds.back(), text.data() + text.size() * i / chunkCount);
+        const char* newline = static_cast<const char*>(memchr(cut, '\n', static_cast<size_t>(textEnd - cut)));
+        bounds.push_back(newline ? newline + 1 : textEnd);
+    }
+    bounds.push_back(textEnd);
+
+    std::vector<ChunkResult> chunks(chunkCount);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunkCount; i++) {
+        workers.emplace_back(ParseChunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
+    }
+    ParseChunk(bounds[0], bounds[1], chunks[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Повторы - одним проходом в порядке файла, первое вхождение остается.
+    // Открытая адресация по готовым хэшам: ни одного узла в куче на имя.
+    // Ячейка: старшие 32 бита хэша и номер в result.names + 1 (0 - пусто)
+    ParsedStreamerList result;
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.names.size();
+    }
+    result.names.reserve(total);
+
+    size_t capacity = 16;
+    while (capacity < total * 2) {
+        capacity <<= 1;
+    }
+    std::vector<uint64_t> slots(capacity, 0);
+    size_t mask = capacity - 1;
+
+    for (const auto& chunk : chunks) {
+        for (size_t i = 0; i < chunk.names.size(); i++) {
+            std::string_view name = chunk.names[i];
+            uint64_t tag = chunk.hashes[i] >> 32;
+            size_t position = static_cast<size_t>(chunk.hashes[i]) & mask;
+            bool duplicate = false;
+
+            for (uint64_t slot = slots[position]; slot != 0; slot = slots[position]) {
+                if ((slot >> 32) == tag && result.names[static_cast<uint32_t>(slot) - 1] == name) {
+                    duplicate = true;
+                    break;
+                }
+                position = (position + 1) & mask;
+            }
+
+            if (!duplicate) {
+                result.names.push_back(name);
+                slots[position] = (tag << 32) | result.names.size();
+            } else {
+                result.rejected.push_back({result.lines + chunk.nameLines[i] + 1, chunk.names[i], true});
+            }
+        }
+        for (const auto& reject : chunk.invalid) {
+            result.rejected.push_back({result.lines + reject.line + 1, reject.text, false});
+        }
+        result.lines += chunk.lines;
+    }
+
+    std::sort(result.rejected.begin(), result.rejected.end(),
+              [](const StreamerListReject& a, const StreamerListReject& b) { return a.line < b.line; });
+    return result;
+}
+
+}
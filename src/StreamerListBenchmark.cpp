@@ -0,0 +1,202 @@
+#include "StreamerListBenchmark.h"
+#include "BenchmarkSupport.h"
+#include "MultiStreamMonitor.h"
+#include "StreamerList.h"
+#include "StreamerNames.h"
+#include "StringUtils.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+namespace {
+
+const int ROUNDS = 3;
+const double INVALID_SHARE = 0.02;
+const double DUPLICATE_SHARE = 0.05;
+const double COMMENT_SHARE = 0.01;
+const size_t FULL_LOAD_LINES = 100000;  // Монитор - ~10 KB: миллион не поместится в память
+const char* BENCH_LOG_FILE = "logs/bench_streamer_list.log";
+
+
+std::string GenerateList(const std::string& path, size_t lines) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> share(0.0, 1.0);
+    std::uniform_int_distribution<int> length(4, 14);
+    const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789_";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::vector<std::string> emitted;
+    emitted.reserve(lines);
+
+    for (size_t i = 0; i < lines; i++) {
+        double roll = share(rng);
+        std::string line;
+        if (roll < COMMENT_SHARE) {
+            line = "# comment";
+        } else if (roll < COMMENT_SHARE + INVALID_SHARE) {
+            line = "bad-name." + std::to_string(i);
+        } else if (roll < COMMENT_SHARE + INVALID_SHARE + DUPLICATE_SHARE && !emitted.empty()) {
+            line = emitted[rng() % emitted.size()];
+        } else {
+            // Номер в имени - все имена разные
+            int size = length(rng);
+            for (int c = 0; c < size; c++) {
+                line += alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+            line += "_" + std::to_string(i);
+            emitted.push_back(line);
+        }
+        file << line << ((i % 2) ? "\r\n" : "\n");
+    }
+    return path;
+}
+
+
+// Прежний LoadStreamersFromFile без создания мониторов
+StreamerListBenchmarkResult LoadLegacy(const std::string& path) {
+    StreamerListBenchmarkResult result;
+    std::ifstream file(path);
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> names;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        line = StringUtils::Trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!StringUtils::IsValidStreamerName(line) || !seen.insert(line).second) {
+            result.rejected++;
+            continue;
+        }
+        names.push_back(line);
+    }
+
+    result.names = names.size();
+    return result;
+}
+
+
+StreamerListBenchmarkResult LoadBulk(const std::string& path, unsigned threads) {
+    StreamerListBenchmarkResult result;
+    StreamerListFile file(path);
+    ParsedStreamerList list = StreamerList::Parse(file.GetText(), threads);
+    result.names = list.names.size();
+    result.rejected = list.rejected.size();
+    return result;
+}
+
+
+StreamerListBenchmarkResult LoadAndIntern(const std::string& path, unsigned threads) {
+    StreamerListBenchmarkResult result;
+    StreamerListFile file(path);
+    ParsedStreamerList list = StreamerList::Parse(file.GetText(), threads);
+
+    StreamerNameTable names(Constants::TWITCH_BASE_URL);
+    std::vector<StreamerId> ids;
+    names.InternAll(list.names, ids);
+
+    result.names = names.Size();
+    result.rejected = list.rejected.size();
+    return result;
+}
+
+
+// Весь LoadStreamersFromFile: разбор, предупреждения в лог, InternAll и мониторы.
+// Время - только вызова: создание и остановка MultiStreamMonitor не в счет
+StreamerListBenchmarkResult LoadIntoMonitor(const std::string& path) {
+    auto config = std::make_shared<Config>();
+    BenchmarkSupport::PrepareMonitorConfig(*config, BENCH_LOG_FILE);
+
+    StreamerListBenchmarkResult best;
+    best.method = "LoadStreamersFromFile";
+    for (int round = 0; round < ROUNDS; round++) {
+        MultiStreamMonitor monitor(config);
+        auto start = std::chrono::steady_clock::now();
+        monitor.LoadStreamersFromFile(path);
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (round == 0 || elapsedMs < best.bestMs) {
+            best.bestMs = elapsedMs;
+            best.names = monitor.GetStreamers().size();
+        }
+    }
+    return best;
+}
+
+
+template <typename Load>
+StreamerListBenchmarkResult Measure(const std::string& method, Load load) {
+    StreamerListBenchmarkResult best;
+    for (int round = 0; round < ROUNDS; round++) {
+        auto start = std::chrono::steady_clock::now();
+        StreamerListBenchmarkResult result = load();
+        result.bestMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (round == 0 || result.bestMs < best.bestMs) {
+            best = result;
+        }
+    }
+    best.method = method;
+    return best;
+}
+
+}
+
+
+StreamerListBenchmark::StreamerListBenchmark(size_t lineCount, unsigned threadCount)
+    : lines(std::max<size_t>(1, lineCount)),
+      threads(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {
+}
+
+
+std::string StreamerListBenchmark::RunComparison() const {
+    std::string path = (std::filesystem::temp_directory_path() / "stream_monitor_bench_list.txt").string();
+    GenerateList(path, lines);
+
+    std::vector<StreamerListBenchmarkResult> results;
+    results.push_back(Measure("getline", [&path]() { return LoadLegacy(path); }));
+    results.push_back(Measure("bulk x1", [&path]() { return LoadBulk(path, 1); }));
+    results.push_back(Measure("bulk x" + std::to_string(threads), [this, &path]() { return LoadBulk(path, threads); }));
+    results.push_back(Measure("bulk+intern", [this, &path]() { return LoadAndIntern(path, threads); }));
+
+    size_t fullLines = std::min(lines, FULL_LOAD_LINES);
+    std::string fullPath = (std::filesystem::temp_directory_path() / "stream_monitor_bench_full_list.txt").string();
+    GenerateList(fullPath, fullLines);
+    StreamerListBenchmarkResult full = LoadIntoMonitor(fullPath);
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    std::filesystem::remove(fullPath, error);
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(24) << "method"
+       << std::right << std::setw(12) << "best, ms"
+       << std::setw(12) << "names"
+       << std::setw(12) << "rejected" << "\n";
+
+    for (const auto& result : results) {
+        ss << std::left << std::setw(24) << result.method
+           << std::right << std::fixed << std::setprecision(1) << std::setw(12) << result.bestMs
+           << std::setw(12) << result.names
+           << std::setw(12) << result.rejected << "\n";
+    }
+
+    // Отклоненные строки LoadStreamersFromFile только пишет в лог
+    ss << "\n" << std::left << std::setw(24) << full.method
+       << std::right << std::fixed << std::setprecision(1) << std::setw(12) << full.bestMs
+       << std::setw(12) << full.names << "\n";
+    ss << "first " << fullLines << " line(s), monitors created: "
+       << std::setprecision(2) << full.bestMs * 1000.0 / std::max<size_t>(1, full.names) << " us per name end to end\n";
+
+    return ss.str();
+}
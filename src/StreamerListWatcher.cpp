@@ -0,0 +1,189 @@
+#include "StreamerListWatcher.h"
+#include "Constants.h"
+#include <algorithm>
+
+#ifdef __linux__
+    #include <sys/inotify.h>
+    #include <sys/eventfd.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+#else
+    #include <filesystem>
+    #include <chrono>
+#endif
+
+
+StreamerListWatcher::StreamerListWatcher(std::shared_ptr<Logger> loggerInstance, const std::string& path,
+                                         ListChangedCallback onListChanged, int debounceMilliseconds)
+    : logger(loggerInstance), filePath(path), onChange(std::move(onListChanged)),
+      debounceMs(std::max(0, debounceMilliseconds)), running(false) {
+
+    size_t slash = filePath.find_last_of("/\\");
+    directory = (slash == std::string::npos) ? "." : filePath.substr(0, slash);
+    fileName = (slash == std::string::npos) ? filePath : filePath.substr(slash + 1);
+    if (directory.empty()) {
+        directory = "/";
+    }
+
+#ifdef __linux__
+    inotifyFd = -1;
+    wakeupFd = -1;
+#endif
+}
+
+
+StreamerListWatcher::~StreamerListWatcher() {
+    Stop();
+
+#ifdef __linux__
+    if (wakeupFd >= 0) close(wakeupFd);
+    if (inotifyFd >= 0) close(inotifyFd);
+#endif
+}
+
+
+bool StreamerListWatcher::Start() {
+    if (running.exchange(true)) {
+        return true;
+    }
+
+#ifdef __linux__
+    if (inotifyFd < 0) {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+
+    // Запись на месте (IN_CLOSE_WRITE) и замена через rename (IN_MOVED_TO)
+    if (inotifyFd < 0 || wakeupFd < 0 ||
+        inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        logger->Error("Cannot watch " + filePath + ": " + std::string(strerror(errno)), "StreamerListWatcher");
+        running = false;
+        return false;
+    }
+#endif
+
+    try {
+        watchThread = std::thread(&StreamerListWatcher::WatchThreadFunction, this);
+    } catch (const std::exception& e) {
+        logger->Critical("Failed to start list watcher: " + std::string(e.what()), "StreamerListWatcher");
+        running = false;
+        return false;
+    }
+
+    logger->System("Watching streamers list: " + filePath, "StreamerListWatcher");
+    return true;
+}
+
+
+void StreamerListWatcher::Stop() {
+    if (!running.exchange(false) && !watchThread.joinable()) {
+        return;
+    }
+
+#ifdef __linux__
+    if (wakeupFd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeupFd, &one, sizeof(one));
+        (void)written;
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+    }
+    wakeup.notify_all();
+#endif
+
+    if (watchThread.joinable()) {
+        watchThread.join();
+    }
+}
+
+
+#ifdef __linux__
+
+void StreamerListWatcher::WatchThreadFunction() {
+    alignas(struct inotify_event) char buffer[4096];
+    bool changed = false;
+
+    while (running.load()) {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeupFd, POLLIN, 0}};
+
+        // После события ждем тишины debounceMs: одно сохранение - это несколько событий
+        int ready = poll(fds, 2, changed ? debounceMs : -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logger->Error("poll failed: " + std::string(strerror(errno)), "StreamerListWatcher");
+            break;
+        }
+
+        if (!running.load()) {
+            break;
+        }
+
+        if (ready == 0) {
+            changed = false;
+            onChange();
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ssize_t length = 0;
+            while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (char* ptr = buffer; ptr < buffer + length;) {
+                    auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                    if (event->len > 0 && fileName == event->name) {
+                        changed = true;
+                    }
+                    ptr += sizeof(struct inotify_event) + event->len;
+                }
+            }
+        }
+    }
+}
+
+#else
+
+void StreamerListWatcher::WatchThreadFunction() {
+    namespace fs = std::filesystem;
+
+    auto snapshot = [this]() {
+        std::error_code error;
+        auto modified = fs::last_write_time(filePath, error);
+        auto size = error ? 0 : fs::file_size(filePath, error);
+        return std::make_pair(modified, size);
+    };
+
+    auto last = snapshot();
+    std::unique_lock<std::mutex> lock(waitMutex);
+
+    while (running.load()) {
+        wakeup.wait_for(lock, std::chrono::milliseconds(Constants::STREAMERS_WATCH_POLL_MS),
+                        [this]() { return !running.load(); });
+        if (!running.load()) {
+            break;
+        }
+
+        auto current = snapshot();
+        if (current == last) {
+            continue;
+        }
+
+        // Файл могут еще дописывать - ждем, пока перестанет меняться
+        wakeup.wait_for(lock, std::chrono::milliseconds(debounceMs), [this]() { return !running.load(); });
+        auto settled = snapshot();
+        if (settled != current || !running.load()) {
+            continue;
+        }
+
+        last = settled;
+        lock.unlock();
+        onChange();
+        lock.lock();
+    }
+}
+
+#endif
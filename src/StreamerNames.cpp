@@ -0,0 +1,150 @@
+#include "StreamerNames.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+
+StreamerNameTable::StreamerNameTable(const std::string& pageBaseUrl)
+    : baseUrl(pageBaseUrl), count(0), urlCursor(nullptr), urlFree(0), slots(INITIAL_SLOTS, 0) {
+    for (auto& chunk : chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+
+StreamerNameTable::~StreamerNameTable() {
+    for (auto& chunk : chunks) {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+
+StreamerId StreamerNameTable::Intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    return InternLocked(name);
+}
+
+
+void StreamerNameTable::InternAll(const std::vector<std::string_view>& names, std::vector<StreamerId>& ids) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+
+    Reserve(count.load(std::memory_order_relaxed) + names.size());
+    ids.clear();
+    ids.reserve(names.size());
+    for (std::string_view name : names) {
+        ids.push_back(InternLocked(name));
+    }
+}
+
+
+bool StreamerNameTable::Find(std::string_view name, StreamerId& id) const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+
+    size_t position = 0;
+    if (!FindLocked(name, std::hash<std::string_view>()(name), position)) {
+        return false;
+    }
+    id = static_cast<StreamerId>(slots[position]) - 1;
+    return true;
+}
+
+
+bool StreamerNameTable::FindLocked(std::string_view name, uint64_t hash, size_t& position) const {
+    size_t mask = slots.size() - 1;
+    uint64_t tag = hash >> 32;
+
+    // Линейное пробирование до пустой ячейки: position - найденная или первая пустая
+    for (position = static_cast<size_t>(hash) & mask; slots[position] != 0; position = (position + 1) & mask) {
+        uint64_t slot = slots[position];
+        if ((slot >> 32) == tag && Get(static_cast<StreamerId>(slot) - 1).name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+StreamerId StreamerNameTable::InternLocked(std::string_view name) {
+    uint64_t hash = std::hash<std::string_view>()(name);
+    size_t position = 0;
+    if (FindLocked(name, hash, position)) {
+        return static_cast<StreamerId>(slots[position]) - 1;
+    }
+
+    size_t id = count.load(std::memory_order_relaxed);
+    if (id >= CHUNK_SIZE * MAX_CHUNKS) {
+        throw std::length_error("Streamer name table is full");
+    }
+    if ((id + 1) * 2 > slots.size()) {
+        Reserve(id + 1);
+        FindLocked(name, hash, position);
+    }
+
+    Chunk* chunk = chunks[id / CHUNK_SIZE].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Chunk();
+        chunks[id / CHUNK_SIZE].store(chunk, std::memory_order_release);
+    }
+
+    StreamerRecord& record = chunk->records[id % CHUNK_SIZE];
+    record.name.assign(name.data(), name.size());
+    record.pageUrl = StorePageUrl(name);
+
+    slots[position] = ((hash >> 32) << 32) | (id + 1);
+    count.store(id + 1, std::memory_order_release);
+    return static_cast<StreamerId>(id);
+}
+
+
+void StreamerNameTable::Reserve(size_t names) {
+    size_t capacity = std::max<size_t>(INITIAL_SLOTS, slots.size());
+    while (capacity < names * 2) {
+        capacity <<= 1;
+    }
+    if (capacity == slots.size()) {
+        return;
+    }
+
+    // Перестройка: хэши пересчитываются по записям, все имена в ней разные
+    slots.assign(capacity, 0);
+    size_t mask = capacity - 1;
+    size_t interned = count.load(std::memory_order_relaxed);
+    for (size_t id = 0; id < interned; id++) {
+        uint64_t hash = std::hash<std::string_view>()(Get(static_cast<StreamerId>(id)).name);
+        size_t position = static_cast<size_t>(hash) & mask;
+        while (slots[position] != 0) {
+            position = (position + 1) & mask;
+        }
+        slots[position] = ((hash >> 32) << 32) | (id + 1);
+    }
+}
+
+
+const char* StreamerNameTable::StorePageUrl(std::string_view name) {
+    size_t size = baseUrl.size() + name.size() + 1;
+    if (size > urlFree) {
+        // Остаток прежнего блока пропадает; длинный URL получает блок по размеру
+        size_t blockSize = std::max(URL_BLOCK_SIZE, size);
+        urlBlocks.push_back(std::make_unique<char[]>(blockSize));
+        urlCursor = urlBlocks.back().get();
+        urlFree = blockSize;
+    }
+
+    char* url = urlCursor;
+    std::memcpy(url, baseUrl.data(), baseUrl.size());
+    std::memcpy(url + baseUrl.size(), name.data(), name.size());
+    url[size - 1] = '\0';
+
+    urlCursor += size;
+    urlFree -= size;
+    return url;
+}
+
+
+std::string StreamerNameTable::StatsPathFor(std::string_view name) {
+    std::string path;
+    path.reserve(sizeof("stats/stats_.json") - 1 + name.size());
+    path.append("stats/stats_").append(name.data(), name.size()).append(".json");
+    return path;
+}
@@ -1,6 +1,26 @@
 #include "StringUtils.h"
+#include "Constants.h"
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstdint>
+
+
+namespace {
+
+// 1 - символ допустим в имени стримера ([a-zA-Z0-9_])
+constexpr std::array<uint8_t, 256> MakeNameCharTable() {
+    std::array<uint8_t, 256> table{};
+    for (int c = 'a'; c <= 'z'; c++) table[c] = 1;
+    for (int c = 'A'; c <= 'Z'; c++) table[c] = 1;
+    for (int c = '0'; c <= '9'; c++) table[c] = 1;
+    table['_'] = 1;
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> NAME_CHARS = MakeNameCharTable();
+
+}
 
 
 namespace StringUtils {
@@ -28,13 +48,18 @@ std::string ToLower(const std::string& str) {
 }
 
 
-bool IsValidStreamerName(const std::string& name) {
-    if (name.empty() || name.length() > 25) {
+bool IsValidStreamerName(std::string_view name) {
+    if (name.empty() || name.length() > Constants::MAX_STREAMER_NAME_LENGTH) {
         return false;
     }
     
-    std::regex pattern("^[a-zA-Z0-9_]+$");
-    return std::regex_match(name, pattern);
+    // То же, что VALID_STREAMER_NAME_PATTERN, без std::regex: таблица символов и
+    // без выхода из цикла по символу - имена короткие, ветвление дороже
+    unsigned valid = 1;
+    for (unsigned char c : name) {
+        valid &= NAME_CHARS[c];
+    }
+    return valid != 0;
 }
 
 
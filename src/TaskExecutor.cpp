@@ -0,0 +1,236 @@
+#include "TaskExecutor.h"
+#include <sstream>
+#include <algorithm>
+
+
+namespace {
+    // Пул и индекс worker текущего потока: Submit изнутри задачи кладет в свою очередь
+    thread_local const TaskExecutor* currentExecutor = nullptr;
+    thread_local size_t currentWorkerIndex = 0;
+}
+
+
+TaskExecutor::TaskExecutor(std::shared_ptr<Logger> loggerInstance, size_t threadCount)
+    : logger(loggerInstance), running(false), pendingTasks(0), nextWorker(0), submittedCount(0) {
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+}
+
+
+TaskExecutor::~TaskExecutor() {
+    Stop();
+}
+
+
+bool TaskExecutor::Start() {
+    if (running.exchange(true)) {
+        return true;
+    }
+
+    try {
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i]->thread = std::thread(&TaskExecutor::WorkerThreadFunction, this, i);
+        }
+    } catch (const std::exception& e) {
+        logger->Critical("Failed to start executor workers: " + std::string(e.what()), "TaskExecutor");
+        Stop();
+        return false;
+    }
+
+    logger->System("Executor started (" + std::to_string(workers.size()) + " worker(s))", "TaskExecutor");
+    return true;
+}
+
+
+void TaskExecutor::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        running = false;
+    }
+    idleCondition.notify_all();
+
+    bool joined = false;
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+            joined = true;
+        }
+    }
+
+    // Оставшееся дорабатываем здесь: в очередях могут быть события и запись статистики.
+    // Submit, прошедший проверку running до нас, уже учтен в pendingTasks, но мог
+    // еще не положить задачу - ждем, пока счетчик не дойдет до нуля
+    ExecutorTask task;
+    while (pendingTasks.load() > 0) {
+        bool found = false;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            while (PopLocal(i, task)) {
+                RunTask(*workers[i], task);
+                found = true;
+            }
+        }
+        if (!found) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (joined) {
+        logger->System("Executor stopped", "TaskExecutor");
+    }
+}
+
+
+bool TaskExecutor::Submit(ExecutorTask task) {
+    size_t index = currentExecutor == this ?
+                   currentWorkerIndex : nextWorker.fetch_add(1) % workers.size();
+
+    {
+        // До публикации задачи: иначе worker успеет ее снять и уменьшить
+        // pendingTasks раньше нас - счетчик уйдет ниже нуля (size_t - через
+        // переполнение), и простаивающие worker будут крутиться без сна.
+        // Под idleMutex: worker не уснет между проверкой pendingTasks и wait,
+        // а Stop не пропустит задачу, принятую до сброса running
+        std::lock_guard<std::mutex> lock(idleMutex);
+        if (!running.load()) {
+            return false;
+        }
+        pendingTasks++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->queueMutex);
+        workers[index]->queue.push_back(std::move(task));
+    }
+    submittedCount++;
+    idleCondition.notify_one();
+    return true;
+}
+
+
+bool TaskExecutor::PopLocal(size_t index, ExecutorTask& task) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.queueMutex);
+
+    if (worker.queue.empty()) {
+        return false;
+    }
+
+    task = std::move(worker.queue.back());
+    worker.queue.pop_back();
+    pendingTasks--;
+    return true;
+}
+
+
+bool TaskExecutor::Steal(size_t thief, std::mt19937& generator, ExecutorTask& task) {
+    size_t count = workers.size();
+    if (count < 2) {
+        return false;
+    }
+
+    // Обход всех жертв со случайной стартовой позиции
+    std::uniform_int_distribution<size_t> dist(0, count - 1);
+    size_t start = dist(generator);
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == thief) {
+            continue;
+        }
+
+        Worker& worker = *workers[victim];
+        std::lock_guard<std::mutex> lock(worker.queueMutex);
+        if (worker.queue.empty()) {
+            continue;
+        }
+
+        task = std::move(worker.queue.front());
+        worker.queue.pop_front();
+        pendingTasks--;
+        workers[thief]->steals++;
+        return true;
+    }
+
+    return false;
+}
+
+
+void TaskExecutor::RunTask(Worker& worker, ExecutorTask& task) {
+    try {
+        task();
+    } catch (const std::exception& e) {
+        logger->Error("Exception in executor task: " + std::string(e.what()), "TaskExecutor");
+    }
+    task = nullptr;  // Освобождаем захваченное до следующего ожидания
+    worker.executed++;
+}
+
+
+void TaskExecutor::WorkerThreadFunction(size_t index) {
+    currentExecutor = this;
+    currentWorkerIndex = index;
+
+    std::mt19937 generator(static_cast<unsigned int>(std::random_device()() + index));
+    Worker& self = *workers[index];
+    ExecutorTask task;
+
+    while (running.load()) {
+        if (PopLocal(index, task) || Steal(index, generator, task)) {
+            RunTask(self, task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idleMutex);
+        idleCondition.wait(lock, [this]() {
+            return !running.load() || pendingTasks.load() > 0;
+        });
+    }
+
+    currentExecutor = nullptr;
+}
+
+
+ExecutorStats TaskExecutor::GetStats() const {
+    ExecutorStats stats;
+    stats.submitted = submittedCount.load();
+    stats.workers.resize(workers.size());
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+        Worker& worker = *workers[i];
+        {
+            std::lock_guard<std::mutex> lock(worker.queueMutex);
+            stats.workers[i].queueDepth = worker.queue.size();
+        }
+        stats.workers[i].executed = worker.executed.load();
+        stats.workers[i].steals = worker.steals.load();
+
+        stats.executed += stats.workers[i].executed;
+        stats.steals += stats.workers[i].steals;
+    }
+
+    return stats;
+}
+
+
+std::string TaskExecutor::GetStatsSummary() const {
+    ExecutorStats stats = GetStats();
+    std::ostringstream ss;
+
+    ss << "workers=" << stats.workers.size()
+       << ", submitted=" << stats.submitted
+       << ", executed=" << stats.executed
+       << ", steals=" << stats.steals
+       << ", depth/steals per worker=";
+
+    for (size_t i = 0; i < stats.workers.size(); ++i) {
+        ss << (i > 0 ? " " : "") << stats.workers[i].queueDepth << "/" << stats.workers[i].steals;
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,209 @@
+#include "TimingWheel.h"
+#include <algorithm>
+
+
+TimingWheel::TimingWheel(int64_t startMs)
+    : overdue(NIL), currentTick(startMs), higherCount(0) {
+    std::fill(std::begin(nearSlots), std::end(nearSlots), NIL);
+    for (int level = 0; level < LEVELS; ++level) {
+        std::fill(std::begin(levelSlots[level]), std::end(levelSlots[level]), NIL);
+    }
+}
+
+
+void TimingWheel::Link(uint32_t index, uint32_t* head) {
+    Node& node = nodes[index];
+    node.head = head;
+    node.prev = NIL;
+    node.next = *head;
+    if (*head != NIL) {
+        nodes[*head].prev = index;
+    }
+    *head = index;
+
+    const uint32_t* levelBegin = &levelSlots[0][0];
+    if (head >= levelBegin && head < levelBegin + LEVELS * LEVEL_SIZE) {
+        higherCount++;
+    }
+}
+
+
+void TimingWheel::Unlink(uint32_t index) {
+    Node& node = nodes[index];
+    if (!node.head) {
+        return;
+    }
+
+    if (node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    } else {
+        *node.head = node.next;
+    }
+    if (node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    }
+
+    const uint32_t* levelBegin = &levelSlots[0][0];
+    if (node.head >= levelBegin && node.head < levelBegin + LEVELS * LEVEL_SIZE) {
+        higherCount--;
+    }
+
+    node.head = nullptr;
+    node.prev = NIL;
+    node.next = NIL;
+}
+
+
+void TimingWheel::Place(uint32_t index) {
+    int64_t deadline = nodes[index].deadlineMs;
+    int64_t delta = deadline - currentTick;
+
+    if (delta <= 0) {
+        Link(index, &overdue);
+        return;
+    }
+
+    if (delta < NEAR_SIZE) {
+        Link(index, &nearSlots[deadline & (NEAR_SIZE - 1)]);
+        return;
+    }
+
+    // Дальше горизонта колеса - в последний уровень, при спуске разместится заново
+    int64_t maxDelta = (int64_t(1) << (NEAR_BITS + LEVELS * LEVEL_BITS)) - 1;
+    if (delta > maxDelta) {
+        deadline = currentTick + maxDelta;
+        delta = maxDelta;
+    }
+
+    for (int level = 0; level < LEVELS; ++level) {
+        int shift = NEAR_BITS + level * LEVEL_BITS;
+        if (delta < (int64_t(1) << (shift + LEVEL_BITS)) || level == LEVELS - 1) {
+            Link(index, &levelSlots[level][(deadline >> shift) & (LEVEL_SIZE - 1)]);
+            return;
+        }
+    }
+}
+
+
+void TimingWheel::Cascade(int level, int slot) {
+    uint32_t index = levelSlots[level][slot];
+    levelSlots[level][slot] = NIL;
+
+    while (index != NIL) {
+        uint32_t next = nodes[index].next;
+        nodes[index].head = nullptr;
+        higherCount--;
+        Place(index);
+        index = next;
+    }
+}
+
+
+void TimingWheel::Release(uint32_t index) {
+    nodeByTask.erase(nodes[index].taskId);
+    freeNodes.push_back(index);
+}
+
+
+void TimingWheel::MoveExpired(uint32_t* head, std::vector<ExpiredDeadline>& out) {
+    uint32_t index = *head;
+    *head = NIL;
+
+    while (index != NIL) {
+        Node& node = nodes[index];
+        uint32_t next = node.next;
+        node.head = nullptr;
+        out.push_back({node.taskId, node.deadlineMs});
+        Release(index);
+        index = next;
+    }
+}
+
+
+void TimingWheel::Schedule(uint64_t taskId, int64_t deadlineMs) {
+    auto it = nodeByTask.find(taskId);
+    uint32_t index;
+
+    if (it != nodeByTask.end()) {
+        index = it->second;
+        Unlink(index);
+    } else {
+        if (!freeNodes.empty()) {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+        } else {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(Node());
+        }
+        nodes[index].head = nullptr;
+        nodeByTask[taskId] = index;
+    }
+
+    nodes[index].taskId = taskId;
+    nodes[index].deadlineMs = deadlineMs;
+    Place(index);
+}
+
+
+bool TimingWheel::Cancel(uint64_t taskId) {
+    auto it = nodeByTask.find(taskId);
+    if (it == nodeByTask.end()) {
+        return false;
+    }
+
+    uint32_t index = it->second;
+    Unlink(index);
+    Release(index);
+    return true;
+}
+
+
+void TimingWheel::PopExpired(int64_t nowMs, std::vector<ExpiredDeadline>& out) {
+    MoveExpired(&overdue, out);
+
+    while (currentTick < nowMs) {
+        // Пустое колесо нечего прокручивать по миллисекунде
+        if (nodeByTask.empty()) {
+            currentTick = nowMs;
+            break;
+        }
+
+        currentTick++;
+        int nearIndex = static_cast<int>(currentTick & (NEAR_SIZE - 1));
+
+        // Ближнее колесо сделало оборот - спускаем следующий слот уровня выше
+        for (int level = 0; nearIndex == 0 && level < LEVELS; ++level) {
+            int shift = NEAR_BITS + level * LEVEL_BITS;
+            int slot = static_cast<int>((currentTick >> shift) & (LEVEL_SIZE - 1));
+            Cascade(level, slot);
+            if (slot != 0) {
+                break;
+            }
+        }
+
+        MoveExpired(&nearSlots[nearIndex], out);
+        MoveExpired(&overdue, out);
+    }
+}
+
+
+int64_t TimingWheel::NextWakeupMs() {
+    if (nodeByTask.empty()) {
+        return -1;
+    }
+    if (overdue != NIL) {
+        return currentTick;
+    }
+
+    for (int64_t tick = currentTick + 1; tick <= currentTick + NEAR_SIZE; ++tick) {
+        int nearIndex = static_cast<int>(tick & (NEAR_SIZE - 1));
+        if (nearIndex == 0 && higherCount > 0) {
+            return tick;  // Нужен спуск с верхнего уровня
+        }
+        if (nearSlots[nearIndex] != NIL) {
+            return tick;
+        }
+    }
+
+    return currentTick + NEAR_SIZE;
+}
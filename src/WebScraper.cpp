@@ -1,7 +1,27 @@
 #include "WebScraper.h"
 #include "Constants.h"
+#include "StringUtils.h"
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+#include <cctype>
+
+
+namespace {
+    // Сравнение имени HTTP-заголовка без учета регистра и без копирования
+    bool HeaderNameIs(const char* name, size_t length, const char* expected) {
+        size_t expectedLength = std::strlen(expected);
+        if (length != expectedLength) {
+            return false;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            if (std::tolower(static_cast<unsigned char>(name[i])) != expected[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
 
 
 // ==================== CurlHandle Implementation ====================
@@ -13,6 +33,10 @@ CurlHandle::CurlHandle() : handle(curl_easy_init()) {
 }
 
 
+CurlHandle::CurlHandle(CURL* adopted) : handle(adopted) {
+}
+
+
 CurlHandle::~CurlHandle() {
     if (handle) {
         curl_easy_cleanup(handle);
@@ -38,48 +62,154 @@ CurlHandle& CurlHandle::operator=(CurlHandle&& other) noexcept {
 }
 
 
+// ==================== ResponseFingerprint Implementation ====================
+
+void ResponseFingerprint::Clear() {
+    httpCode = 0;
+    contentLength.clear();
+    etag.clear();
+    lastModified.clear();
+    bodyHash = 0;
+    bodyBytes = 0;
+}
+
+
+bool ResponseFingerprint::IsUsable() const {
+    bool okStatus = httpCode == Constants::HTTP_OK || httpCode == 206;
+    return okStatus && (!etag.empty() || !lastModified.empty() ||
+                        !contentLength.empty() || bodyBytes > 0);
+}
+
+
+bool ResponseFingerprint::Matches(const ResponseFingerprint& other) const {
+    return httpCode == other.httpCode &&
+           contentLength == other.contentLength &&
+           etag == other.etag &&
+           lastModified == other.lastModified &&
+           bodyHash == other.bodyHash &&
+           bodyBytes == other.bodyBytes;
+}
+
+
+std::string ResponseFingerprint::ToString() const {
+    return "HTTP " + std::to_string(httpCode) +
+           ", length=" + (contentLength.empty() ? "?" : contentLength) +
+           ", etag=" + (etag.empty() ? "?" : etag) +
+           ", modified=" + (lastModified.empty() ? "?" : lastModified) +
+           ", body=" + std::to_string(bodyBytes) + " B";
+}
+
+
 // ==================== WebScraper Implementation ====================
 
-WebScraper::WebScraper(std::shared_ptr<Logger> loggerInstance, const Config& config)
-    : logger(loggerInstance), requestCounter(0) {
+WebScraper::WebScraper(std::shared_ptr<MonitorContext> contextInstance)
+    : logger(contextInstance->GetLogger()), context(contextInstance),
+      curlHandle(contextInstance->IsMemoryBudget() ? nullptr : curl_easy_init()),
+      memoryBudget(contextInstance->IsMemoryBudget()), hasOfflineFingerprint(false), probeSkipsInRow(0),
+      lastVerdictOnline(false), requestCounter(0),
+      pageMatcher(MarkerAutomaton::GetWithOfflineEnd(contextInstance->GetConfig().GetString("offline_end_marker", "")),
+                  Constants::HTML_TAIL_WINDOW),
+      callbackData{&pageMatcher, 0, true, 0, false},
+      probeData{&probeFingerprint, 0, false}, tlsSessionResumed(false),
+      currentPhase(CheckPhase::FULL), checkVerdict(false),
+      pacingDelayMs(0), extraRequestDue(false), cancelRequested(false), blockingMulti(nullptr),
+      limiterTicket(0), checkDeferred(false), lastFailure(FailureClass::NONE),
+      pageLatency(Constants::HEDGE_LATENCY_WINDOW), hedgeDelayMs(-1), hedgeHandle(nullptr),
+      hedgeCallbackData{nullptr, 0, true, 0, false}, hedgeWon(false), hedgesSent(0), hedgesWon(0) {
+    
+    const Config& config = context->GetConfig();
+    bool trace = context->IsStandalone();  // Трасса - только у одиночного монитора
     
-    std::cout << "[WebScraper] Constructor START" << std::endl;
+    if (trace) std::cout << "[WebScraper] Constructor START" << std::endl;
     
     maxHtmlSize = static_cast<size_t>(config.GetInt("max_html_size", Constants::MAX_HTML_SIZE));
     timeout = config.GetInt("timeout", Constants::DEFAULT_TIMEOUT);
     connectTimeout = config.GetInt("connect_timeout", Constants::DEFAULT_CONNECT_TIMEOUT);
     useHttp2 = config.GetBool("use_http2", true);
+    http2Multiplex = useHttp2 && config.GetBool("http2_multiplex", true);
     dnsCacheTimeout = config.GetInt("dns_cache_timeout", Constants::DNS_CACHE_TIMEOUT_SECONDS);
     sslVerifyPeer = config.GetBool("ssl_verify_peer", false);
     sslVerifyHost = config.GetBool("ssl_verify_host", false);
+    abortOnVerdict = config.GetBool("abort_on_verdict", true);
+    shareConnections = config.GetBool("share_connections", true);
+    streamerNames = context->GetStreamerNames();
+    std::string baseUrl = config.GetString("twitch_base_url", Constants::TWITCH_BASE_URL);
+    pageHost = RateLimiter::HostOf(baseUrl);
+    
+    // Главная страница того же сервера, что и страницы каналов (у подставки - ее корень)
+    size_t schemeEnd = baseUrl.find("://");
+    size_t pathStart = baseUrl.find('/', schemeEnd == std::string::npos ? 0 : schemeEnd + 3);
+    mainPageUrl = (pathStart == std::string::npos) ? baseUrl + "/" : baseUrl.substr(0, pathStart + 1);
+    transferTimeoutMs = static_cast<long>(timeout) * 1000;
+    
+    hedgeRequests = config.GetBool("hedge_requests", false);
+    adaptiveTimeout = config.GetBool("adaptive_timeout", false);
+    if (hedgeRequests) {
+        hedgeMatcher = std::make_unique<MarkerMatcher>(
+            MarkerAutomaton::GetWithOfflineEnd(config.GetString("offline_end_marker", "")),
+            Constants::HTML_TAIL_WINDOW);
+    }
+    requestUrl = "";
+    currentUrl = "";
     
-    std::cout << "[WebScraper] Config loaded" << std::endl;
-    std::cout << "[WebScraper]   maxHtmlSize: " << maxHtmlSize << std::endl;
-    std::cout << "[WebScraper]   timeout: " << timeout << std::endl;
-    std::cout << "[WebScraper]   useHttp2: " << (useHttp2 ? "YES" : "NO") << std::endl;
+    // Двухфазная проверка: дешевый probe, полная страница только если она изменилась
+    useHeadRequest = config.GetBool("use_head_request", true);
+    probeRangeBytes = std::max(0, config.GetInt("probe_range_bytes", 0));
+    probeFullEvery = std::max(0, config.GetInt("probe_full_every", 10));
+    if (probeRangeBytes > 0) {
+        probeRange = "0-" + std::to_string(probeRangeBytes - 1);
+    }
+    
+    // Ядро префильтра маркеров: auto (по CPUID) | avx2 | sse2 | scalar
+    ScanKernel scanKernel;
+    std::string kernelName = config.GetString("marker_scan_kernel", "auto");
+    if (!MarkerScanner::ParseKernelName(kernelName, scanKernel) ||
+        !MarkerScanner::SetActiveKernel(scanKernel)) {
+        logger->Warning("Unsupported marker_scan_kernel '" + kernelName + "', using " +
+                       MarkerScanner::KernelName(MarkerScanner::GetActiveKernel()), "WebScraper");
+    }
+    
+    if (trace) {
+        std::cout << "[WebScraper] Config loaded" << std::endl;
+        std::cout << "[WebScraper]   maxHtmlSize: " << maxHtmlSize << std::endl;
+        std::cout << "[WebScraper]   timeout: " << timeout << std::endl;
+        std::cout << "[WebScraper]   useHttp2: " << (useHttp2 ? "YES" : "NO") << std::endl;
+        std::cout << "[WebScraper]   shareConnections: " << (shareConnections ? "YES" : "NO") << std::endl;
+        std::cout << "[WebScraper]   useHeadRequest: " << (useHeadRequest ? "YES" : "NO") << std::endl;
+        std::cout << "[WebScraper]   hedgeRequests: " << (hedgeRequests ? "YES" : "NO") << std::endl;
+        std::cout << "[WebScraper]   memoryBudget: " << (memoryBudget ? "YES" : "NO") << std::endl;
+        std::cout << "[WebScraper]   markerScanKernel: " << MarkerScanner::KernelName(MarkerScanner::GetActiveKernel()) << std::endl;
+    }
     
-    std::cout << "[WebScraper] Creating HumanBehavior..." << std::endl;
-    humanBehavior = std::make_unique<HumanBehavior>();
-    std::cout << "[WebScraper] HumanBehavior created" << std::endl;
+    humanBehavior = std::make_unique<HumanBehavior>(context->NextSeed());
+    pacingDelayMs = humanBehavior->NextThinkingDelayMs();  // Перед самым первым запросом
+    
+    if (memoryBudget) {
+        // Handle создаст AcquireHandle в начале первой проверки
+        if (trace) std::cout << "[WebScraper] Constructor END (handle per check)\n" << std::endl;
+        return;
+    }
     
-    std::cout << "[WebScraper] Checking cURL handle..." << std::endl;
     if (!curlHandle.IsValid()) {
         std::cout << "[WebScraper] ERROR: cURL handle is INVALID!" << std::endl;
         logger->Critical("Failed to initialize cURL handle", "WebScraper");
         return;
     }
-    std::cout << "[WebScraper] cURL handle is valid" << std::endl;
     
-    std::cout << "[WebScraper] Configuring cURL with human headers..." << std::endl;
     ConfigureCurlWithHumanHeaders();
-    std::cout << "[WebScraper] cURL configured" << std::endl;
     
-    logger->Success("WebScraper initialized (NO API, only HTML parsing)", "WebScraper");
-    std::cout << "[WebScraper] Constructor END\n" << std::endl;
+    if (trace) {
+        logger->Success("WebScraper initialized (NO API, only HTML parsing)", "WebScraper");
+        std::cout << "[WebScraper] Constructor END\n" << std::endl;
+    }
 }
 
 
 WebScraper::~WebScraper() {
+    if (blockingMulti) {
+        curl_multi_cleanup(blockingMulti);
+        blockingMulti = nullptr;
+    }
     logger->Debug("WebScraper destroyed", "WebScraper");
 }
 
@@ -108,171 +238,866 @@ void WebScraper::ConfigureCurlWithHumanHeaders() {
         logger->Debug("HTTP/2 enabled", "WebScraper");
     }
     
+    if (http2Multiplex) {
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+    }
+    
     if (dnsCacheTimeout > 0) {
         curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, static_cast<long>(dnsCacheTimeout));
     }
     
     curl_easy_setopt(handle, CURLOPT_COOKIEFILE, "");
+    
+    // DNS, TLS-сессии и соединения - общие для всех мониторов процесса
+    if (shareConnections) {
+        curlShare = CurlShare::Acquire();
+        if (curlShare->Attach(handle, &tlsSessionResumed)) {
+            logger->Debug("Attached to shared connection cache", "WebScraper");
+        } else {
+            logger->Warning("Shared connection cache unavailable, using private one", "WebScraper");
+            curlShare.reset();
+        }
+    }
 }
 
 
-size_t WebScraper::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-    size_t totalSize = size * nmemb;
-    CallbackData* data = static_cast<CallbackData*>(userp);
+bool WebScraper::AcquireHandle() {
+    if (curlHandle.IsValid()) {
+        return true;
+    }
     
-    if (*(data->foundMarker)) {
-        return totalSize;
+    // Соединения и TLS-сессии живут в CurlShare, так что новый handle их переиспользует.
+    // Cookie между проверками не сохраняются
+    curlHandle = CurlHandle();
+    if (!curlHandle.IsValid()) {
+        return false;
+    }
+    ConfigureCurlWithHumanHeaders();
+    curl_easy_setopt(curlHandle.Get(), CURLOPT_TIMEOUT_MS, transferTimeoutMs);
+    return true;
+}
+
+
+void WebScraper::ReleaseCheckResources() {
+    if (!memoryBudget) {
+        return;
     }
     
-    if (data->buffer->length() >= data->maxSize) {
-        return totalSize;
+    curlHandle = CurlHandle(nullptr);
+    hedgeHandle = CurlHandle(nullptr);
+    pageMatcher.ReleaseBuffers();
+    if (hedgeMatcher) {
+        hedgeMatcher->ReleaseBuffers();
+    }
+    
+    std::lock_guard<std::mutex> lock(blockingMultiMutex);
+    if (blockingMulti) {
+        curl_multi_cleanup(blockingMulti);
+        blockingMulti = nullptr;
+    }
+}
+
+
+CURLcode WebScraper::PerformBlocking(bool allowHedge) {
+    CURL* handle = curlHandle.Get();
+    CURLM* multi = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(blockingMultiMutex);
+        if (!blockingMulti) {
+            blockingMulti = curl_multi_init();
+        }
+        multi = blockingMulti;
     }
     
-    size_t remainingSpace = data->maxSize - data->buffer->length();
-    size_t sizeToAdd = std::min(totalSize, remainingSpace);
+    if (cancelRequested.load()) {
+        return CURLE_ABORTED_BY_CALLBACK;
+    }
     
-    data->buffer->append(static_cast<char*>(contents), sizeToAdd);
+    // Очередь за токеном вместо всплеска запросов ко всем каналам сразу
+    std::string host;
+    if (rateLimiter) {
+        host = RateLimiter::HostOf(currentUrl);
+        if (!rateLimiter->Acquire(host, limiterTicket)) {
+            checkDeferred = true;
+            return CURLE_OPERATION_TIMEDOUT;
+        }
+    }
     
-    if (data->buffer->find(Constants::TwitchMarkers::IS_LIVE_BROADCAST) != std::string::npos ||
-        data->buffer->find(Constants::TwitchMarkers::TYPE_LIVE) != std::string::npos ||
-        data->buffer->find(Constants::TwitchMarkers::BROADCAST_TYPE) != std::string::npos) {
-        *(data->foundMarker) = true;
+    if (!multi) {
+        CURLcode result = curl_easy_perform(handle);
+        if (rateLimiter) {
+            rateLimiter->Release(host);
+        }
+        return result;
     }
     
-    return totalSize;
+    curl_multi_add_handle(multi, handle);
+    
+    // Страница не пришла за hedgeDelayMs - второй запрос в тот же multi
+    bool hedgeArmed = allowHedge && hedgeDelayMs >= 0;
+    auto hedgeAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, hedgeDelayMs));
+    CURL* hedge = nullptr;
+    bool hedgePermit = false;
+    
+    CURLcode result = CURLE_ABORTED_BY_CALLBACK;
+    CURLcode hedgeResult = CURLE_ABORTED_BY_CALLBACK;
+    bool primaryDone = false;
+    bool hedgeDone = false;
+    bool hedgeWins = false;
+    
+    while (true) {
+        int stillRunning = 0;
+        if (curl_multi_perform(multi, &stillRunning) != CURLM_OK) {
+            result = CURLE_FAILED_INIT;
+            break;
+        }
+        
+        int messagesLeft = 0;
+        CURLMsg* message = nullptr;
+        while ((message = curl_multi_info_read(multi, &messagesLeft)) != nullptr) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+            if (message->easy_handle == handle) {
+                result = message->data.result;
+                primaryDone = true;
+            } else if (hedge && message->easy_handle == hedge) {
+                hedgeResult = message->data.result;
+                hedgeDone = true;
+            }
+        }
+        
+        // Побеждает первый ответ; ошибка одного запроса ждет второй, пока тот в полете
+        bool primaryWins = primaryDone && IsResponse(result);
+        hedgeWins = !primaryWins && hedgeDone && IsResponse(hedgeResult);
+        bool allFailed = primaryDone && (!hedge || hedgeDone);
+        
+        if (primaryWins || hedgeWins || allFailed || cancelRequested.load()) {
+            break;
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        if (hedgeArmed && !primaryDone && now >= hedgeAt) {
+            hedgeArmed = false;
+            // Hedge - необязательный запрос: только если лимитер пускает без очереди
+            hedgePermit = rateLimiter && rateLimiter->TryAcquire(host);
+            if (!rateLimiter || hedgePermit) {
+                hedge = PrepareHedge();
+                if (hedge) {
+                    curl_multi_add_handle(multi, hedge);
+                }
+            }
+        }
+        
+        int waitMs = 1000;
+        if (hedgeArmed) {
+            auto untilHedge = std::chrono::duration_cast<std::chrono::milliseconds>(hedgeAt - now).count();
+            waitMs = static_cast<int>(std::min<long long>(waitMs, std::max<long long>(0, untilHedge)));
+        }
+        curl_multi_poll(multi, nullptr, 0, waitMs, nullptr);
+    }
+    
+    curl_multi_remove_handle(multi, handle);
+    if (hedge) {
+        curl_multi_remove_handle(multi, hedge);
+    }
+    if (rateLimiter) {
+        rateLimiter->Release(host);
+        if (hedgePermit) {
+            rateLimiter->Release(host);
+        }
+    }
+    
+    if (hedgeWins) {
+        AdoptHedgeResult();
+        return hedgeResult;
+    }
+    return result;
 }
 
 
-void WebScraper::MaybePerformExtraRequest(const std::string& streamerName) {
-    if (humanBehavior->ShouldMakeExtraRequest() && requestCounter % 5 == 0) {
-        logger->Debug("Performing extra request to main page (anti-detection)", "WebScraper");
-        
-        CURL* handle = curlHandle.Get();
-        std::string mainPage = "https://www.twitch.tv/";
-        
-        curl_easy_setopt(handle, CURLOPT_URL, mainPage.c_str());
-        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+bool WebScraper::IsResponse(CURLcode result) {
+    // CURLE_WRITE_ERROR дает только WriteCallback, оборвавший передачу по вердикту
+    return result == CURLE_OK || result == CURLE_WRITE_ERROR;
+}
+
+
+void WebScraper::PlanTransferTimeouts() {
+    hedgeDelayMs = -1;
+    long timeoutMs = static_cast<long>(timeout) * 1000;
+    
+    if (hedgeRequests || adaptiveTimeout) {
+        LatencySummary latency = pageLatency.Summarize();
+        if (latency.samples >= Constants::HEDGE_MIN_SAMPLES) {
+            if (hedgeRequests) {
+                hedgeDelayMs = static_cast<int>(std::max<long long>(Constants::HEDGE_MIN_DELAY_MS, latency.p95Ms));
+            }
+            // Зависшее соединение обрываем по статистике канала, а не через фиксированные timeout секунд
+            if (adaptiveTimeout) {
+                timeoutMs = std::min(timeoutMs, std::max<long>(Constants::ADAPTIVE_TIMEOUT_MIN_MS,
+                    static_cast<long>(latency.p99Ms * Constants::ADAPTIVE_TIMEOUT_FACTOR)));
+            }
+        }
+    }
+    
+    if (timeoutMs != transferTimeoutMs) {
+        transferTimeoutMs = timeoutMs;
+        curl_easy_setopt(curlHandle.Get(), CURLOPT_TIMEOUT_MS, transferTimeoutMs);
+    }
+}
+
+
+int WebScraper::GetHedgeDelayMs() const {
+    return currentPhase == CheckPhase::FULL ? hedgeDelayMs : -1;
+}
+
+
+CURL* WebScraper::PrepareHedge() {
+    if (!hedgeMatcher || !curlHandle.IsValid()) {
+        return nullptr;
+    }
+    
+    // Копия настроек текущего запроса; открытые соединения копия не наследует
+    hedgeHandle = CurlHandle(curl_easy_duphandle(curlHandle.Get()));
+    if (!hedgeHandle.IsValid()) {
+        return nullptr;
+    }
+    
+    hedgeMatcher->Reset();
+    hedgeCallbackData = {hedgeMatcher.get(), maxHtmlSize, abortOnVerdict, 0, false};
+    
+    CURL* handle = hedgeHandle.Get();
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &hedgeCallbackData);
+    curl_easy_setopt(handle, CURLOPT_FRESH_CONNECT, 1L);  // Первое соединение могло зависнуть
+    
+    hedgesSent++;
+    logger->Debug("Hedging page request after " + std::to_string(hedgeDelayMs) + " ms", "WebScraper");
+    return handle;
+}
+
+
+void WebScraper::AdoptHedgeResult() {
+    std::swap(pageMatcher, *hedgeMatcher);
+    std::swap(callbackData, hedgeCallbackData);
+    callbackData.matcher = &pageMatcher;
+    hedgeCallbackData.matcher = hedgeMatcher.get();
+    
+    hedgeWon = true;
+    hedgesWon++;
+}
+
+
+void WebScraper::Cancel() {
+    cancelRequested = true;
+    
+    uint64_t ticket = limiterTicket.load();
+    if (ticket != 0 && rateLimiter) {
+        rateLimiter->Cancel(ticket);
+    }
+    
+    std::lock_guard<std::mutex> lock(blockingMultiMutex);
+    if (blockingMulti) {
+        curl_multi_wakeup(blockingMulti);
+    }
+}
+
+
+void WebScraper::RecordConnectionUse(CURL* handle) {
+    if (curlShare) {
+        curlShare->RecordTransfer(handle, tlsSessionResumed);
+    }
+    tlsSessionResumed = false;
+}
+
+
+size_t WebScraper::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t totalSize = size * nmemb;
+    CallbackData* data = static_cast<CallbackData*>(userp);
+    MarkerMatcher* matcher = data->matcher;
+    
+    data->bytesReceived += totalSize;
+    
+    if (!matcher->IsVerdictDecided() && matcher->GetBytesSeen() < data->maxSize) {
+        // Каждый байт проходит через автомат один раз, HTML целиком не храним
+        size_t remainingSpace = data->maxSize - matcher->GetBytesSeen();
+        size_t sizeToScan = std::min(totalSize, remainingSpace);
         
-        humanBehavior->RandomDelay(300, 800);
-        curl_easy_perform(handle);
-        curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
+        matcher->Feed(static_cast<const char*>(contents), sizeToScan);
     }
+    
+    // Вердикт известен (или лимит исчерпан) - остаток страницы не нужен.
+    // Возврат != totalSize обрывает передачу с CURLE_WRITE_ERROR
+    if (data->abortOnVerdict &&
+        (matcher->IsVerdictDecided() || matcher->GetBytesSeen() >= data->maxSize)) {
+        data->aborted = true;
+        return 0;
+    }
+    
+    return totalSize;
 }
 
 
-std::string WebScraper::DownloadPageHtml(const std::string& streamerName) {
-    if (!curlHandle.IsValid()) {
-        logger->Error("cURL handle not initialized", "WebScraper");
-        return "";
+size_t WebScraper::ProbeWriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t totalSize = size * nmemb;
+    ProbeCallbackData* data = static_cast<ProbeCallbackData*>(userp);
+    ResponseFingerprint* fingerprint = data->fingerprint;
+    
+    // FNV-1a по первым limit байтам тела
+    const unsigned char* bytes = static_cast<const unsigned char*>(contents);
+    size_t toHash = fingerprint->bodyBytes < data->limit ?
+                    std::min(totalSize, data->limit - fingerprint->bodyBytes) : 0;
+    
+    uint64_t hash = fingerprint->bodyBytes == 0 ? 14695981039346656037ULL : fingerprint->bodyHash;
+    for (size_t i = 0; i < toHash; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
     }
+    fingerprint->bodyHash = hash;
+    fingerprint->bodyBytes += toHash;
     
-    humanBehavior->SimulateThinking();
+    // Сервер проигнорировал Range и шлет всю страницу - дальше не читаем
+    if (fingerprint->bodyBytes >= data->limit) {
+        data->aborted = true;
+        return 0;
+    }
     
-    requestCounter++;
-    MaybePerformExtraRequest(streamerName);
+    return totalSize;
+}
+
+
+size_t WebScraper::HeaderCallback(char* buffer, size_t size, size_t nitems, void* userp) {
+    size_t totalSize = size * nitems;
+    ResponseFingerprint* fingerprint = static_cast<ResponseFingerprint*>(userp);
     
-    std::string readBuffer;
-    bool foundMarker = false;
+    // Новая строка статуса (редирект) - отпечаток снимаем с последнего ответа
+    if (totalSize >= 5 && std::memcmp(buffer, "HTTP/", 5) == 0) {
+        fingerprint->Clear();
+        return totalSize;
+    }
     
-    CallbackData callbackData = {&readBuffer, &foundMarker, maxHtmlSize};
+    // Разбираем строку на месте: заголовки приходят на каждую проверку
+    const char* end = buffer + totalSize;
+    const char* colon = static_cast<const char*>(std::memchr(buffer, ':', totalSize));
+    if (!colon) {
+        return totalSize;
+    }
+    
+    const char* valueBegin = colon + 1;
+    while (valueBegin < end && std::isspace(static_cast<unsigned char>(*valueBegin))) ++valueBegin;
+    const char* valueEnd = end;
+    while (valueEnd > valueBegin && std::isspace(static_cast<unsigned char>(valueEnd[-1]))) --valueEnd;
+    size_t valueLength = static_cast<size_t>(valueEnd - valueBegin);
+    
+    const char* name = buffer;
+    size_t nameLength = static_cast<size_t>(colon - buffer);
+    
+    if (HeaderNameIs(name, nameLength, "etag")) {
+        fingerprint->etag.assign(valueBegin, valueLength);
+    } else if (HeaderNameIs(name, nameLength, "last-modified")) {
+        fingerprint->lastModified.assign(valueBegin, valueLength);
+    } else if (HeaderNameIs(name, nameLength, "content-range")) {
+        // Для Range-ответа полный размер страницы есть только здесь
+        fingerprint->contentLength.assign(valueBegin, valueLength);
+    } else if (HeaderNameIs(name, nameLength, "content-length") &&
+               fingerprint->contentLength.compare(0, 6, "bytes ") != 0) {
+        fingerprint->contentLength.assign(valueBegin, valueLength);
+    }
+    
+    return totalSize;
+}
+
+
+void WebScraper::PrepareExtraRequest() {
+    logger->Debug("Performing extra request to main page (anti-detection)", "WebScraper");
     
-    std::string url = std::string(Constants::TWITCH_BASE_URL) + streamerName;
     CURL* handle = curlHandle.Get();
     
-    struct curl_slist* headers = nullptr;
-    auto humanHeaders = humanBehavior->GetHumanLikeHeaders();
+    ApplyRequestHeaders();
+    currentUrl = mainPageUrl.c_str();
+    curl_easy_setopt(handle, CURLOPT_URL, currentUrl);
+    curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+}
+
+
+void WebScraper::FinishExtraRequest() {
+    RecordConnectionUse(curlHandle.Get());
+    curl_easy_setopt(curlHandle.Get(), CURLOPT_HTTPGET, 1L);  // Сбрасывает NOBODY
+    extraRequestDue = false;
+}
+
+
+void WebScraper::PlanPacing() {
+    // Паузы "как у человека" не спим внутри проверки, а отдаем планировщику:
+    // загрузка страницы + раздумье перед следующим запросом
+    int delayMs = humanBehavior->NextPageLoadWaitMs() + humanBehavior->NextThinkingDelayMs();
     
-    for (const auto& header : humanHeaders) {
-        std::string headerStr = header.first + ": " + header.second;
-        headers = curl_slist_append(headers, headerStr.c_str());
+    extraRequestDue = humanBehavior->ShouldMakeExtraRequest() && (requestCounter + 1) % 5 == 0;
+    if (extraRequestDue) {
+        delayMs += humanBehavior->NextRandomDelayMs(Constants::EXTRA_REQUEST_DELAY_MIN_MS,
+                                                    Constants::EXTRA_REQUEST_DELAY_MAX_MS);
     }
     
-    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    pacingDelayMs = delayMs;
+}
+
+
+void WebScraper::ApplyRequestHeaders() {
+    const auto& headerVariants = context->GetHeaderVariants();
+    if (headerVariants.empty()) {
+        return;
+    }
+    
+    size_t variant = humanBehavior->PickIndex(headerVariants.size());
+    curl_easy_setopt(curlHandle.Get(), CURLOPT_HTTPHEADER, headerVariants[variant]);
+}
+
+
+void WebScraper::SetTargetStreamer(StreamerId streamerId) {
+    requestUrl = streamerNames->Get(streamerId).pageUrl;
+    lastTransfer = TransferStats();
+    lastFailure = FailureClass::NONE;
+}
+
+
+void WebScraper::PrepareRequest() {
+    pageMatcher.Reset();
+    callbackData = {&pageMatcher, maxHtmlSize, abortOnVerdict, 0, false};
+    hedgeWon = false;
+    
+    CURL* handle = curlHandle.Get();
+    
+    ApplyRequestHeaders();
+    currentUrl = requestUrl;
+    curl_easy_setopt(handle, CURLOPT_URL, currentUrl);
     curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteCallback);
     curl_easy_setopt(handle, CURLOPT_WRITEDATA, &callbackData);
     
-    logger->Debug("Downloading page (human-like, max " + 
-                 std::to_string(maxHtmlSize / 1024) + " KB)", "WebScraper");
+    if (logger->IsEnabled(LogLevel::DEBUG)) {
+        logger->Debug("Downloading page (human-like, max " + 
+                     std::to_string(maxHtmlSize / 1024) + " KB)", "WebScraper");
+    }
+}
+
+
+bool WebScraper::FinishRequest(CURLcode res) {
+    CURL* handle = hedgeWon ? hedgeHandle.Get() : curlHandle.Get();
+    RecordConnectionUse(handle);
     
-    CURLcode res = curl_easy_perform(handle);
+    lastTransfer.bytesReceived += callbackData.bytesReceived;
+    lastTransfer.bytesNeeded = pageMatcher.GetVerdictOffset();
+    lastTransfer.abortedEarly = callbackData.aborted;
     
-    curl_slist_free_all(headers);
+    // Обрыв из WriteCallback по готовому вердикту - это успех
+    if (res == CURLE_WRITE_ERROR && callbackData.aborted) {
+        res = CURLE_OK;
+    }
     
     if (res != CURLE_OK) {
-        logger->Error("cURL failed: " + std::string(curl_easy_strerror(res)), "WebScraper");
-        return "";
+        // Таймаут - замер не меньше текущего предела: p99 растет, adaptive_timeout
+        // сразу отпускает таймаут обратно к timeout, если сайт стал медленнее
+        if (res == CURLE_OPERATION_TIMEDOUT) {
+            pageLatency.Add(transferTimeoutMs);
+        }
+        lastFailure = FailurePolicy::ClassifyTransfer(res);
+        logger->Error("cURL failed: " + std::string(curl_easy_strerror(res)) +
+                     " (" + FailurePolicy::ClassName(lastFailure) + ")", "WebScraper");
+        return false;
     }
     
     long httpCode = 0;
     curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &httpCode);
     
-    logger->Debug("HTTP " + std::to_string(httpCode) + 
-                 ", Downloaded " + std::to_string(readBuffer.length() / 1024) + " KB" +
-                 (foundMarker ? " (live marker found!)" : ""), "WebScraper");
+    if (logger->IsEnabled(LogLevel::DEBUG)) {
+        logger->Debug("HTTP " + std::to_string(httpCode) + 
+                     ", Received " + std::to_string(lastTransfer.bytesReceived) + " bytes" +
+                     ", needed " + std::to_string(lastTransfer.bytesNeeded) +
+                     (lastTransfer.abortedEarly ? " (aborted early)" : "") +
+                     (pageMatcher.IsLive() ? " (live marker found!)" : ""), "WebScraper");
+    }
     
     if (httpCode != Constants::HTTP_OK) {
-        logger->Warning("Unexpected HTTP: " + std::to_string(httpCode), "WebScraper");
-        return "";
+        lastFailure = FailurePolicy::ClassifyHttp(httpCode);
+        logger->Warning("Unexpected HTTP: " + std::to_string(httpCode) +
+                       " (" + FailurePolicy::ClassName(lastFailure) + ")", "WebScraper");
+        return false;
     }
     
-    humanBehavior->SimulatePageLoad();
+    // Замер для hedge и адаптивного таймаута: удачные загрузки и таймауты
+    curl_off_t totalTimeUs = 0;
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME_T, &totalTimeUs);
+    pageLatency.Add(static_cast<long long>(totalTimeUs / 1000));
     
-    return readBuffer;
+    return true;
 }
 
 
-bool WebScraper::ParseStreamStatus(const std::string& html) {
-    if (html.empty()) {
-        logger->Warning("HTML empty, assuming offline", "WebScraper");
+bool WebScraper::DownloadPageHtml() {
+    if (!curlHandle.IsValid()) {
+        logger->Error("cURL handle not initialized", "WebScraper");
         return false;
     }
     
-    if (html.length() < Constants::MIN_HTML_SIZE) {
-        logger->Warning("HTML too small (" + std::to_string(html.length()) + " bytes)", "WebScraper");
+    PrepareRequest();
+    
+    CURLcode res = PerformBlocking(true);
+    if (checkDeferred) {
         return false;
     }
     
-    if (html.find("cf-browser-verification") != std::string::npos ||
-        html.find("g-recaptcha") != std::string::npos) {
-        logger->Warning("Anti-bot detected! Adjust headers if needed.", "WebScraper");
+    return FinishRequest(res);
+}
+
+
+bool WebScraper::ParseStreamStatus() {
+    size_t pageSize = pageMatcher.GetBytesSeen();
+    
+    if (pageSize == 0) {
+        lastFailure = FailureClass::TRANSIENT;
+        logger->Warning("HTML empty, no verdict", "WebScraper");
+        return false;
     }
     
-    if (html.find(Constants::TwitchMarkers::IS_LIVE_BROADCAST) != std::string::npos) {
-        logger->Info("Stream ONLINE (isLiveBroadcast)", "WebScraper");
-        return true;
+    // Ранний вердикт мог прийти раньше MIN_HTML_SIZE - тогда размер не показатель
+    if (!pageMatcher.IsVerdictDecided() && pageSize < Constants::MIN_HTML_SIZE) {
+        lastFailure = FailureClass::TRANSIENT;
+        logger->Warning("HTML too small (" + std::to_string(pageSize) + " bytes)", "WebScraper");
+        logger->Debug("Page content: " + pageMatcher.GetTail(), "WebScraper");
+        return false;
     }
     
-    size_t streamPos = html.find(Constants::TwitchMarkers::STREAM_SECTION);
-    if (streamPos != std::string::npos) {
-        size_t searchEnd = std::min(streamPos + 500, html.length());
-        std::string streamSection = html.substr(streamPos, searchEnd - streamPos);
-        
-        if (streamSection.find(Constants::TwitchMarkers::TYPE_LIVE) != std::string::npos) {
+    // Страница-заглушка вместо канала: по ней нельзя судить о статусе, хост надо оставить в покое
+    if (pageMatcher.IsAntiBotDetected()) {
+        if (!pageMatcher.IsLive()) {
+            lastFailure = FailureClass::THROTTLED;
+            logger->Warning("Anti-bot page detected, backing off", "WebScraper");
+            return false;
+        }
+        logger->Warning("Anti-bot detected! Adjust headers if needed.", "WebScraper");
+    }
+    
+    switch (pageMatcher.GetLiveReason()) {
+        case LiveReason::IS_LIVE_BROADCAST:
+            logger->Info("Stream ONLINE (isLiveBroadcast)", "WebScraper");
+            return true;
+        case LiveReason::TYPE_LIVE:
             logger->Info("Stream ONLINE (type:live)", "WebScraper");
             return true;
+        case LiveReason::BROADCAST_TYPE:
+            logger->Info("Stream ONLINE (broadcastType)", "WebScraper");
+            return true;
+        default:
+            break;
+    }
+    
+    if (pageMatcher.IsVerdictDecided()) {
+        logger->Info("Stream OFFLINE (offline_end_marker)", "WebScraper");
+        return false;
+    }
+    
+    logger->Info("Stream OFFLINE", "WebScraper");
+    return false;
+}
+
+
+bool WebScraper::EvaluatePage(bool downloaded) {
+    if (!downloaded) {
+        if (lastFailure == FailureClass::NONE) {
+            lastFailure = FailureClass::TRANSIENT;
+        }
+        logger->Warning("Could not download page (" + std::string(FailurePolicy::ClassName(lastFailure)) +
+                       "), no verdict", "WebScraper");
+        return false;
+    }
+    
+    return ParseStreamStatus();
+}
+
+
+bool WebScraper::ShouldProbe() const {
+    if (!useHeadRequest || lastVerdictOnline) {
+        return false;
+    }
+    
+    // Раз в probe_full_every пропусков страницу все равно качаем целиком
+    return !(hasOfflineFingerprint && probeFullEvery > 0 && probeSkipsInRow >= probeFullEvery);
+}
+
+
+void WebScraper::PrepareProbe() {
+    CURL* handle = curlHandle.Get();
+    
+    probeFingerprint.Clear();
+    probeData = {&probeFingerprint, static_cast<size_t>(probeRangeBytes), false};
+    lastTransfer.probed = true;
+    
+    ApplyRequestHeaders();
+    currentUrl = requestUrl;
+    curl_easy_setopt(handle, CURLOPT_URL, currentUrl);
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, HeaderCallback);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, &probeFingerprint);
+    
+    if (probeRangeBytes > 0) {
+        // Хэшируем сырые байты: сжатый кусок страницы не распаковать
+        curl_easy_setopt(handle, CURLOPT_RANGE, probeRange.c_str());
+        curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, nullptr);
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, ProbeWriteCallback);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, &probeData);
+        if (logger->IsEnabled(LogLevel::DEBUG)) {
+            logger->Debug("Probing page (range " + probeRange + ")", "WebScraper");
         }
+    } else {
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+        logger->Debug("Probing page (HEAD)", "WebScraper");
+    }
+}
+
+
+void WebScraper::ResetProbeOptions() {
+    CURL* handle = curlHandle.Get();
+    
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, nullptr);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, nullptr);
+    curl_easy_setopt(handle, CURLOPT_RANGE, nullptr);
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "gzip, deflate, br");
+    curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);  // Сбрасывает и NOBODY
+}
+
+
+bool WebScraper::FinishProbe(CURLcode res) {
+    RecordConnectionUse(curlHandle.Get());
+    ResetProbeOptions();
+    
+    lastTransfer.bytesReceived += probeFingerprint.bodyBytes;
+    
+    if (res == CURLE_WRITE_ERROR && probeData.aborted) {
+        res = CURLE_OK;
     }
     
-    if (html.find(Constants::TwitchMarkers::BROADCAST_TYPE) != std::string::npos) {
-        logger->Info("Stream ONLINE (broadcastType)", "WebScraper");
+    if (res != CURLE_OK) {
+        logger->Warning("Probe failed: " + std::string(curl_easy_strerror(res)) +
+                       ", falling back to full fetch", "WebScraper");
+        probeFingerprint.Clear();
+        return false;
+    }
+    
+    curl_easy_getinfo(curlHandle.Get(), CURLINFO_RESPONSE_CODE, &probeFingerprint.httpCode);
+    
+    // Хост уже отвечает 429 - полная загрузка получит то же самое
+    if (FailurePolicy::ClassifyHttp(probeFingerprint.httpCode) == FailureClass::THROTTLED) {
+        lastFailure = FailureClass::THROTTLED;
+        logger->Warning("Probe throttled: HTTP " + std::to_string(probeFingerprint.httpCode), "WebScraper");
+        return false;
+    }
+    
+    if (!probeFingerprint.IsUsable()) {
+        if (logger->IsEnabled(LogLevel::DEBUG)) {
+            logger->Debug("Probe gave no usable fingerprint (" + probeFingerprint.ToString() + ")",
+                         "WebScraper");
+        }
+        return false;
+    }
+    
+    if (hasOfflineFingerprint && probeFingerprint.Matches(offlineFingerprint)) {
+        probeSkipsInRow++;
+        lastTransfer.fullFetchSkipped = true;
+        logger->Info("Stream OFFLINE (page unchanged, full fetch skipped)", "WebScraper");
         return true;
     }
     
-    logger->Info("Stream OFFLINE", "WebScraper");
+    if (logger->IsEnabled(LogLevel::DEBUG)) {
+        logger->Debug("Probe fingerprint changed: " + probeFingerprint.ToString(), "WebScraper");
+    }
     return false;
 }
 
 
-bool WebScraper::CheckStreamStatus(const std::string& streamerName) {
-    logger->Debug("Checking via web scraping (NO API)", "WebScraper");
+void WebScraper::RememberVerdict(bool downloaded, bool isOnline) {
+    probeSkipsInRow = 0;
+    lastVerdictOnline = isOnline;
+    
+    if (isOnline) {
+        hasOfflineFingerprint = false;
+        return;
+    }
     
-    std::string html = DownloadPageHtml(streamerName);
+    // Отпечаток этой проверки подтвержден полной загрузкой - запоминаем как offline
+    if (downloaded && lastTransfer.probed && probeFingerprint.IsUsable()) {
+        offlineFingerprint = probeFingerprint;
+        hasOfflineFingerprint = true;
+    }
+}
+
+
+bool WebScraper::CheckStreamStatus(StreamerId streamerId) {
+    logger->Debug("Checking via web scraping (NO API)", "WebScraper");
     
-    if (html.empty()) {
-        logger->Warning("Could not download page, assuming offline", "WebScraper");
+    if (cancelRequested.load()) {
         return false;
     }
     
-    return ParseStreamStatus(html);
-}
\ No newline at end of file
+    AcquireHandle();
+    bool isOnline = RunBlockingCheck(streamerId);
+    ReleaseCheckResources();
+    return isOnline;
+}
+
+
+bool WebScraper::RunBlockingCheck(StreamerId streamerId) {
+    checkDeferred = false;
+    requestCounter++;
+    SetTargetStreamer(streamerId);
+    PlanTransferTimeouts();
+    
+    if (extraRequestDue && curlHandle.IsValid()) {
+        PrepareExtraRequest();
+        PerformBlocking();
+        FinishExtraRequest();
+        if (checkDeferred) {
+            return DeferCheck();
+        }
+    }
+    
+    if (ShouldProbe() && curlHandle.IsValid()) {
+        PrepareProbe();
+        CURLcode probeResult = PerformBlocking();
+        if (checkDeferred) {
+            ResetProbeOptions();
+            return DeferCheck();
+        }
+        if (FinishProbe(probeResult)) {
+            PlanPacing();
+            return false;
+        }
+        if (lastFailure != FailureClass::NONE) {
+            PlanPacing();
+            return lastVerdictOnline;
+        }
+    }
+    
+    bool downloaded = DownloadPageHtml();
+    if (checkDeferred) {
+        return DeferCheck();
+    }
+    bool isOnline = EvaluatePage(downloaded);
+    PlanPacing();
+    
+    // Без вердикта статус прежний: решение о повторе за FailurePolicy
+    if (lastFailure != FailureClass::NONE) {
+        return lastVerdictOnline;
+    }
+    RememberVerdict(downloaded, isOnline);
+    
+    return isOnline;
+}
+
+
+void WebScraper::BeginCheck(StreamerId streamerId) {
+    logger->Debug("Submitting async check (curl_multi)", "WebScraper");
+    
+    // Паузы HumanBehavior выдерживает планировщик (GetPacingDelayMs)
+    requestCounter++;
+    SetTargetStreamer(streamerId);
+    
+    if (extraRequestDue) {
+        currentPhase = CheckPhase::EXTRA;
+        currentUrl = mainPageUrl.c_str();
+    } else {
+        currentPhase = ShouldProbe() ? CheckPhase::PROBE : CheckPhase::FULL;
+        currentUrl = requestUrl;
+    }
+}
+
+
+CURL* WebScraper::StartTransfer() {
+    if (!AcquireHandle()) {
+        logger->Error("cURL handle not initialized", "WebScraper");
+        return nullptr;
+    }
+    
+    PlanTransferTimeouts();
+    
+    if (currentPhase == CheckPhase::EXTRA) {
+        PrepareExtraRequest();
+    } else if (currentPhase == CheckPhase::PROBE) {
+        PrepareProbe();
+    } else {
+        PrepareRequest();
+    }
+    
+    return curlHandle.Get();
+}
+
+
+bool WebScraper::DeferCheck() {
+    logger->Warning("Check deferred by rate limiter", "WebScraper");
+    PlanPacing();
+    return lastVerdictOnline;
+}
+
+
+void WebScraper::AbortCheck() {
+    if (currentPhase == CheckPhase::EXTRA) {
+        curl_easy_setopt(curlHandle.Get(), CURLOPT_HTTPGET, 1L);  // Сбрасывает NOBODY
+    } else if (currentPhase == CheckPhase::PROBE) {
+        ResetProbeOptions();
+    }
+    
+    currentPhase = CheckPhase::FULL;
+    DeferCheck();
+    ReleaseCheckResources();
+}
+
+
+void WebScraper::StartPageCheck() {
+    if (ShouldProbe()) {
+        currentPhase = CheckPhase::PROBE;
+        PrepareProbe();
+    } else {
+        currentPhase = CheckPhase::FULL;
+        PrepareRequest();
+    }
+}
+
+
+CURL* WebScraper::ContinueCheck(CURLcode result, bool fromHedge) {
+    if (currentPhase == CheckPhase::EXTRA) {
+        FinishExtraRequest();
+        StartPageCheck();
+        return curlHandle.Get();
+    }
+    
+    if (currentPhase == CheckPhase::PROBE) {
+        if (FinishProbe(result)) {
+            checkVerdict = false;
+            PlanPacing();
+            ReleaseCheckResources();
+            return nullptr;
+        }
+        if (lastFailure != FailureClass::NONE) {
+            checkVerdict = lastVerdictOnline;
+            PlanPacing();
+            ReleaseCheckResources();
+            return nullptr;
+        }
+        
+        // Страница изменилась (или probe не помог) - вторая фаза, полная загрузка
+        currentPhase = CheckPhase::FULL;
+        PrepareRequest();
+        return curlHandle.Get();
+    }
+    
+    if (fromHedge) {
+        AdoptHedgeResult();
+    }
+    
+    bool downloaded = FinishRequest(result);
+    checkVerdict = EvaluatePage(downloaded);
+    if (lastFailure == FailureClass::NONE) {
+        RememberVerdict(downloaded, checkVerdict);
+    } else {
+        checkVerdict = lastVerdictOnline;
+    }
+    PlanPacing();
+    ReleaseCheckResources();
+    
+    return nullptr;
+}
@@ -4,38 +4,46 @@
 #include "Logger.h"
 #include "Constants.h"
 #include "StringUtils.h"
+#include "ShutdownCoordinator.h"
+#include "PollSimulator.h"
+#include "RegistryBenchmark.h"
+#include "MonitorContext.h"
+#include "MemoryReport.h"
+#include "StateTableBenchmark.h"
+#include "StreamerListBenchmark.h"
+#include "EngineBenchmark.h"
+#include "MarkerBenchmark.h"
+#include "MarkerScanBenchmark.h"
+#include "MarkerScanner.h"
+#include "AllocationBenchmark.h"
+#include "AllocationCounter.h"
+#include "SchedulerBenchmark.h"
+#include "ExecutorBenchmark.h"
+#include "StartupBenchmark.h"
+#include "RateLimiterBenchmark.h"
+#include "ReloadBenchmark.h"
+#include "ProbeBenchmark.h"
+#include "ShutdownBenchmark.h"
+#include "H2Benchmark.h"
+#include "HedgeBenchmark.h"
+#include "BenchmarkSupport.h"
 #include <iostream>
+#include <fstream>
 #include <string>
-#include <csignal>
-#include <atomic>
 #include <memory>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <vector>
 
 
-// Глобальные переменные для signal handler
-std::atomic<bool> g_shutdownRequested(false);
 std::unique_ptr<StreamMonitor> g_singleMonitor;
 std::unique_ptr<MultiStreamMonitor> g_multiMonitor;
 
 
-// Signal handler для graceful shutdown
-void SignalHandler(int signal) {
-    if (signal == SIGINT || signal == SIGTERM) {
-        std::cout << "\n\n[SIGNAL] Shutdown signal received. Stopping gracefully..." << std::endl;
-        g_shutdownRequested = true;
-        
-        if (g_singleMonitor) {
-            g_singleMonitor->Stop();
-        }
-        if (g_multiMonitor) {
-            g_multiMonitor->StopAll();
-        }
-    }
-}
-
-
+// Сигналы -> ShutdownCoordinator: в handler ни блокировок, ни join
 void SetupSignalHandlers() {
-    std::signal(SIGINT, SignalHandler);
-    std::signal(SIGTERM, SignalHandler);
+    ShutdownCoordinator::Instance().InstallSignalHandlers();
 }
 
 
@@ -60,6 +68,27 @@ void PrintUsageInstructions() {
     std::cout << "  Show statistics:" << std::endl;
     std::cout << "    stream_monitor --stats <streamer_name>" << std::endl;
     std::cout << std::endl;
+    std::cout << "  Replay recorded sessions (fixed vs predictive polling):" << std::endl;
+    std::cout << "    stream_monitor --simulate-polling [streamers_file] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-registry [readers] [seconds] [channels]" << std::endl;
+    std::cout << "    stream_monitor --bench-monitors [count] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-startup [max_channels] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-reload [channels] [changed] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-shutdown [channels] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --memory-report [channels] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-state-table [channels] [rounds]" << std::endl;
+    std::cout << "    stream_monitor --bench-streamer-list [lines] [threads]" << std::endl;
+    std::cout << "    stream_monitor --bench-engines [channels] [seconds] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-h2 [channels] [seconds] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-markers [page_kb] [rounds]" << std::endl;
+    std::cout << "    stream_monitor --bench-marker-scan [page_kb] [rounds]" << std::endl;
+    std::cout << "    stream_monitor --bench-allocs [checks] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-probe [channels] [rounds] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-hedge [channels] [checks] [config_file]" << std::endl;
+    std::cout << "    stream_monitor --bench-scheduler [channels] [simulated_seconds]" << std::endl;
+    std::cout << "    stream_monitor --bench-executor [workers] [tasks]" << std::endl;
+    std::cout << "    stream_monitor --bench-rate-limiter [seconds] [config_file]" << std::endl;
+    std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "    stream_monitor lydiaviolet" << std::endl;
     std::cout << "    stream_monitor shroud my_config.ini" << std::endl;
@@ -78,7 +107,7 @@ void ShowStatistics(const std::string& streamerName) {
     try {
         std::cout << "\nLoading statistics for: " << streamerName << "\n" << std::endl;
         
-        Statistics stats(streamerName, "stats/stats_" + streamerName + ".json");
+        Statistics stats(streamerName, StreamerNameTable::StatsPathFor(streamerName));
         stats.PrintSummary();
         
     } catch (const std::exception& e) {
@@ -87,6 +116,371 @@ void ShowStatistics(const std::string& streamerName) {
 }
 
 
+// Прогон сессий из stats/ через fixed и predictive опрос: запросы vs задержка обнаружения
+int SimulatePolling(const std::string& streamersFile, const std::string& configPath) {
+    std::ifstream file(streamersFile);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open " << streamersFile << std::endl;
+        return 1;
+    }
+    
+    Config config(configPath);
+    config.Load();
+    
+    PollSimulator simulator(config);
+    size_t sessionCount = 0;
+    
+    std::string line;
+    while (std::getline(file, line)) {
+        line = StringUtils::Trim(line);
+        if (line.empty() || line[0] == '#' || !StringUtils::IsValidStreamerName(line)) {
+            continue;
+        }
+        
+        Statistics stats(line, StreamerNameTable::StatsPathFor(line));
+        std::vector<StreamSession> sessions = stats.GetSessions();
+        sessionCount += sessions.size();
+        simulator.AddChannel(line, std::move(sessions));
+    }
+    
+    std::cout << "\nReplaying " << sessionCount << " session(s) of " << simulator.GetChannelCount()
+              << " channel(s); metrics over the second half of the history\n" << std::endl;
+    std::cout << simulator.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// Читатели реестра мониторов под churn добавлений/удалений: snapshot vs mutex
+int BenchmarkRegistry(int readers, int seconds, size_t channels) {
+    RegistryBenchmark benchmark(readers, seconds, channels);
+    
+    std::cout << "\nRegistry contention: " << std::max(1, readers) << " reader(s), 1 writer, "
+              << std::max<size_t>(1, channels) << " channel(s), " << std::max(1, seconds) << " s per registry\n" << std::endl;
+    std::cout << benchmark.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// Создание мониторов с общим MonitorContext, как в --multi: время и память на канал
+int BenchmarkMonitors(int count, const std::string& configPath) {
+    count = std::max(1, count);
+    
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    auto logger = std::make_shared<Logger>("logs/bench_monitors.log");
+    auto context = std::make_shared<MonitorContext>(config, logger);
+    
+    std::vector<std::shared_ptr<StreamMonitor>> monitors;
+    monitors.reserve(static_cast<size_t>(count));
+    
+    // Первый монитор инициализирует libcurl и общие автоматы маркеров - не в счет
+    monitors.push_back(std::make_shared<StreamMonitor>("bench_warmup", context));
+    
+    long rssBefore = MemoryUsage::Current().rssKb;
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int i = 0; i < count; i++) {
+        monitors.push_back(std::make_shared<StreamMonitor>("bench_" + std::to_string(i), context));
+    }
+    
+    double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    long rssAfter = MemoryUsage::Current().rssKb;
+    
+    std::cout << "\nCreated " << count << " monitor(s) with a shared context" << std::endl;
+    std::cout << "    construction: " << elapsedUs / count << " us per monitor" << std::endl;
+    if (rssBefore >= 0) {
+        std::cout << "    RSS: " << static_cast<double>(rssAfter - rssBefore) / count << " KB per monitor ("
+                  << rssAfter / 1024 << " MB total)" << std::endl;
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+
+// Время до первой проверки последнего стримера: окно прогрева против прежних 500 мс на стримера
+int BenchmarkStartup(size_t maxChannels, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    if (BenchmarkSupport::RequireLocalUrl(*config) != 0) {
+        return 1;
+    }
+    StartupBenchmark benchmark(config, maxChannels);
+    
+    std::cout << "\nStartup: up to " << std::max<size_t>(1, maxChannels) << " channel(s), warm-up "
+              << config->GetInt("startup_warmup_ms", Constants::STARTUP_WARMUP_MS) << " ms, "
+              << config->GetString("twitch_base_url", Constants::TWITCH_BASE_URL) << "\n" << std::endl;
+    
+    std::cout << benchmark.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// Diff большого списка через ApplyStreamerList: время и опоздание проверок нетронутых мониторов
+int BenchmarkReload(size_t channels, size_t changed, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    if (BenchmarkSupport::RequireLocalUrl(*config) != 0) {
+        return 1;
+    }
+    ReloadBenchmark benchmark(config, channels, changed);
+    
+    std::cout << "\nReload: " << config->GetString("twitch_base_url", Constants::TWITCH_BASE_URL) << "\n" << std::endl;
+    
+    bool listsMatch = false;
+    std::cout << benchmark.RunComparison(listsMatch) << std::endl;
+    if (!listsMatch) {
+        std::cerr << "Registry does not match the new list after ApplyStreamerList" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// Остановка с зависшими передачами: до прерывания проверок, до конца записи статистики, до возврата StopAll
+int BenchmarkShutdown(size_t channels, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    ShutdownBenchmark benchmark(config, channels);
+    
+    std::cout << "\nShutdown: up to " << std::max<size_t>(1, channels)
+              << " channel(s) against an in-process stalling stand-in\n" << std::endl;
+    
+    bool stoppedInTime = false;
+    std::cout << benchmark.RunComparison(stoppedInTime) << std::endl;
+    if (!stoppedInTime) {
+        std::cerr << "Statistics flush missed shutdown_timeout_ms or the stand-in did not start" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// Память канала по подсистемам и RSS/куча N каналов в реестре (memory_budget - из конфига)
+int ReportMemory(size_t channels, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    auto logger = std::make_shared<Logger>("logs/memory_report.log");
+    auto context = std::make_shared<MonitorContext>(config, logger);
+    
+    MemoryReport report(context, channels);
+    
+    std::cout << "\nMemory per channel (" << configPath << ")\n" << std::endl;
+    std::cout << report.Run() << std::endl;
+    return 0;
+}
+
+
+// Проход по горячему состоянию каналов: объекты по указателям, AoS и SoA
+int BenchmarkStateTable(size_t entries, int rounds) {
+    StateTableBenchmark benchmark(entries, rounds);
+    
+    std::cout << "\nHot state sweep: " << std::max<size_t>(1, entries) << " channel(s), "
+              << std::max(1, rounds) << " round(s) per layout\n" << std::endl;
+    std::cout << benchmark.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// Загрузка большого списка стримеров: прежний построчный путь против mmap + параллельного разбора
+int BenchmarkStreamerList(size_t lines, unsigned threads) {
+    StreamerListBenchmark benchmark(lines, threads);
+    
+    std::cout << "\nStreamers list ingestion: " << std::max<size_t>(1, lines) << " line(s)\n" << std::endl;
+    std::cout << benchmark.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// Event loop, пул и поток на стримера против локальной подставки: потоки, RSS, проверок в секунду
+int BenchmarkEngines(size_t channels, int seconds, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    if (BenchmarkSupport::RequireLocalUrl(*config) != 0) {
+        return 1;
+    }
+    EngineBenchmark benchmark(config, channels, seconds);
+    
+    std::cout << "\nCheck engines: " << std::max<size_t>(1, channels) << " channel(s), "
+              << std::max(1, seconds) << " s per engine, " << config->GetString("twitch_base_url", Constants::TWITCH_BASE_URL)
+              << "\n" << std::endl;
+    
+    std::cout << benchmark.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// HTTP/2 multiplexing в event loop: соединения, streams на соединение, задержка передачи
+int BenchmarkH2(size_t channels, int seconds, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    if (BenchmarkSupport::RequireLocalUrl(*config) != 0) {
+        return 1;
+    }
+    H2Benchmark benchmark(config, channels, seconds);
+    
+    std::cout << "\nHTTP/2 multiplexing: " << std::max<size_t>(1, channels) << " channel(s), "
+              << std::max(1, seconds) << " s per mode, " << config->GetString("twitch_base_url", Constants::TWITCH_BASE_URL)
+              << "\n" << std::endl;
+    
+    std::cout << benchmark.RunComparison() << std::endl;
+    return 0;
+}
+
+
+// Поиск маркеров на странице: прежние find() по буферу против потокового Aho-Corasick
+int BenchmarkMarkers(size_t pageKb, int rounds) {
+    MarkerBenchmark benchmark(pageKb * 1024, rounds);
+    
+    std::cout << "\nMarker search: " << pageKb << " KB page, 16 KB chunks, "
+              << std::max(1, rounds) << " round(s) per method\n" << std::endl;
+    
+    bool verdictsAgree = false;
+    std::cout << benchmark.RunComparison(verdictsAgree) << std::endl;
+    if (!verdictsAgree) {
+        std::cerr << "Verdicts differ between methods" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// Ядра префильтра маркеров: одинаковые кандидаты и вердикты при любом разрезе на чанки, GB/s
+int BenchmarkMarkerScan(size_t pageKb, int rounds) {
+    MarkerScanBenchmark benchmark(pageKb * 1024, rounds);
+    
+    std::cout << "\nMarker scan kernels: " << pageKb << " KB pages, active kernel "
+              << MarkerScanner::KernelName(MarkerScanner::GetActiveKernel()) << "\n" << std::endl;
+    
+    bool kernelsAgree = false;
+    std::cout << benchmark.RunComparison(kernelsAgree) << std::endl;
+    if (!kernelsAgree) {
+        std::cerr << "Scan kernels disagree with the scalar reference" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// operator new на установившейся проверке: после прогрева должно быть 0, иначе код возврата 1
+int BenchmarkAllocations(int checks, const std::string& configPath) {
+    const int warmupChecks = 5;
+    
+    // До любого CurlShare: иначе malloc libcurl не видны
+    AllocationCounter::HookCurl();
+    
+    int exitCode = 0;
+    {
+        auto config = std::make_shared<Config>(configPath);
+        config->Load();
+        exitCode = BenchmarkSupport::RequireLocalUrl(*config);
+        if (exitCode == 0) {
+            AllocationBenchmark benchmark(config, warmupChecks, checks);
+            
+            std::cout << "\nSteady-state allocations: " << warmupChecks << " warm-up check(s), then "
+                      << std::max(1, checks) << " counted, " << config->GetString("twitch_base_url", Constants::TWITCH_BASE_URL)
+                      << "\n" << std::endl;
+            
+            bool steadyStateClean = false;
+            std::cout << benchmark.RunComparison(steadyStateClean) << std::endl;
+            if (!steadyStateClean) {
+                std::cerr << "Heap allocations after warm-up: the check path must not call operator new" << std::endl;
+                exitCode = 1;
+            }
+        }
+    }
+    
+    AllocationCounter::UnhookCurl();
+    return exitCode;
+}
+
+
+// Двухфазная проверка против подставки в процессе: запросы и байты против полной загрузки, те же вердикты
+int BenchmarkProbe(size_t channels, int rounds, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    ProbeBenchmark benchmark(config, channels, rounds);
+    
+    std::cout << "\nProbe before full fetch: HEAD and Range probes against an in-process stand-in\n" << std::endl;
+    
+    bool verdictsMatch = false;
+    std::cout << benchmark.RunComparison(verdictsMatch) << std::endl;
+    if (!verdictsMatch) {
+        std::cerr << "Probe verdicts differ from the full fetch or checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// Хвост задержки проверки при зависающих ответах: hedge_requests и adaptive_timeout вкл/выкл
+int BenchmarkHedge(size_t channels, int checks, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    HedgeBenchmark benchmark(config, channels, checks);
+    
+    std::cout << "\nHedged requests and adaptive timeout against an in-process stalling stand-in\n" << std::endl;
+    
+    bool standInStarted = false;
+    std::cout << benchmark.RunComparison(standInStarted) << std::endl;
+    return standInStarted ? 0 : 1;
+}
+
+
+// Перепланирование каналов: колесо таймеров против кучи на модельном времени
+int BenchmarkScheduler(size_t channels, int seconds) {
+    SchedulerBenchmark benchmark(channels, seconds);
+    
+    std::cout << "\nDeadline queues: " << std::max<size_t>(1, channels) << " channel(s), "
+              << std::max(1, seconds) << " simulated s, " << Constants::DEFAULT_CHECK_INTERVAL
+              << " s interval\n" << std::endl;
+    
+    bool backendsAgree = false;
+    std::cout << benchmark.RunComparison(backendsAgree) << std::endl;
+    if (!backendsAgree) {
+        std::cerr << "Deadline queues fired in a different order or late" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// TaskExecutor под смесью быстрых и медленных страниц: ожидание в очереди и простой без прокрутки
+int BenchmarkExecutor(size_t workers, size_t tasks) {
+    ExecutorBenchmark benchmark(workers, tasks);
+    
+    std::cout << "\nExecutor stress: " << tasks << " task(s) of mixed page sizes\n" << std::endl;
+    
+    bool executorHealthy = false;
+    std::cout << benchmark.RunComparison(executorHealthy) << std::endl;
+    if (!executorHealthy) {
+        std::cerr << "Executor lost tasks or kept spinning while idle" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// Частота и запросы на хост под RateLimiter против подставки с теми же пределами
+int BenchmarkRateLimiter(int seconds, const std::string& configPath) {
+    auto config = std::make_shared<Config>(configPath);
+    config->Load();
+    RateLimiterBenchmark benchmark(config->GetInt("rate_limit_rps", Constants::RATE_LIMIT_RPS),
+                                   config->GetInt("rate_limit_burst", Constants::RATE_LIMIT_BURST),
+                                   config->GetInt("max_inflight_per_host", Constants::MAX_INFLIGHT_PER_HOST),
+                                   seconds);
+    
+    std::cout << "\nRate limiter against a throttling stand-in (" << configPath << ")\n" << std::endl;
+    
+    bool limitsHeld = false;
+    std::cout << benchmark.RunComparison(limitsHeld) << std::endl;
+    if (!limitsHeld) {
+        std::cerr << "Rate limiter let the stand-in throttle or missed the configured rate" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
 // ТЕСТОВАЯ ФУНКЦИЯ - добавить ДО main()
 void TestBrowserOpening() {
     std::cout << "\n=== BROWSER OPENING TEST ===" << std::endl;
@@ -129,15 +523,13 @@ int RunSingleMonitor(const std::string& streamerName, const std::string& configP
         g_singleMonitor = std::make_unique<StreamMonitor>(streamerName, configPath);
         std::cout << "[RunSingleMonitor] StreamMonitor created successfully!" << std::endl;
         
+        // Stop() будит паузы цикла и прерывает текущую передачу
+        StreamMonitor* monitor = g_singleMonitor.get();
+        ShutdownCoordinator::Instance().AddShutdownHandler([monitor]() { monitor->Stop(); });
+        
         std::cout << "[RunSingleMonitor] Starting monitoring loop..." << std::endl;
         g_singleMonitor->StartMonitoring();
         
-        std::cout << "[RunSingleMonitor] Monitoring loop exited (should not happen)" << std::endl;
-        
-        while (!g_shutdownRequested.load()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        
         std::cout << "\n[SHUTDOWN] Monitor stopped." << std::endl;
         return 0;
         
@@ -176,11 +568,11 @@ int RunMultiMonitor(const std::string& streamersFile) {
         g_multiMonitor->PrintStatus();
         g_multiMonitor->StartAll();
         
-        while (!g_shutdownRequested.load() && g_multiMonitor->IsRunning()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        
-        if (!g_shutdownRequested.load()) {
+        if (g_multiMonitor->IsRunning()) {
+            // Остановка - здесь, в основном потоке, а не в signal handler
+            ShutdownCoordinator::Instance().WaitForShutdown();
+            g_multiMonitor->StopAll();
+        } else {
             std::cout << "\nPress Enter to exit..." << std::endl;
             std::cin.get();
         }
@@ -237,6 +629,145 @@ int main(int argc, char* argv[]) {
         return RunMultiMonitor(streamersFile);
     }
     
+    // Команда --simulate-polling
+    if (argc > 1 && std::string(argv[1]) == "--simulate-polling") {
+        std::string streamersFile = (argc > 2) ? argv[2] : Constants::STREAMERS_LIST_FILE;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return SimulatePolling(streamersFile, configPath);
+    }
+    
+    // Команда --bench-registry
+    if (argc > 1 && std::string(argv[1]) == "--bench-registry") {
+        int readers = (argc > 2) ? std::atoi(argv[2]) : 4;
+        int seconds = (argc > 3) ? std::atoi(argv[3]) : 5;
+        size_t channels = (argc > 4) ? static_cast<size_t>(std::atol(argv[4])) : 10000;
+        return BenchmarkRegistry(readers, seconds, channels);
+    }
+    
+    // Команда --bench-monitors
+    if (argc > 1 && std::string(argv[1]) == "--bench-monitors") {
+        int count = (argc > 2) ? std::atoi(argv[2]) : 10000;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkMonitors(count, configPath);
+    }
+    
+    // Команда --bench-startup
+    if (argc > 1 && std::string(argv[1]) == "--bench-startup") {
+        size_t maxChannels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 1000;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkStartup(maxChannels, configPath);
+    }
+    
+    // Команда --bench-reload
+    if (argc > 1 && std::string(argv[1]) == "--bench-reload") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 50000;
+        size_t changed = (argc > 3) ? static_cast<size_t>(std::atol(argv[3])) : 1000;
+        std::string configPath = (argc > 4) ? argv[4] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkReload(channels, changed, configPath);
+    }
+    
+    // Команда --bench-shutdown
+    if (argc > 1 && std::string(argv[1]) == "--bench-shutdown") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 1000;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkShutdown(channels, configPath);
+    }
+    
+    // Команда --memory-report
+    if (argc > 1 && std::string(argv[1]) == "--memory-report") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 10000;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return ReportMemory(channels, configPath);
+    }
+    
+    // Команда --bench-state-table
+    if (argc > 1 && std::string(argv[1]) == "--bench-state-table") {
+        size_t entries = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 1000000;
+        int rounds = (argc > 3) ? std::atoi(argv[3]) : 10;
+        return BenchmarkStateTable(entries, rounds);
+    }
+    
+    // Команда --bench-streamer-list
+    if (argc > 1 && std::string(argv[1]) == "--bench-streamer-list") {
+        size_t lines = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 1000000;
+        unsigned threads = (argc > 3) ? static_cast<unsigned>(std::max(0, std::atoi(argv[3]))) : 0;
+        return BenchmarkStreamerList(lines, threads);
+    }
+    
+    // Команда --bench-engines
+    if (argc > 1 && std::string(argv[1]) == "--bench-engines") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 1000;
+        int seconds = (argc > 3) ? std::atoi(argv[3]) : 20;
+        std::string configPath = (argc > 4) ? argv[4] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkEngines(channels, seconds, configPath);
+    }
+    
+    // Команда --bench-h2
+    if (argc > 1 && std::string(argv[1]) == "--bench-h2") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 500;
+        int seconds = (argc > 3) ? std::atoi(argv[3]) : 10;
+        std::string configPath = (argc > 4) ? argv[4] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkH2(channels, seconds, configPath);
+    }
+    
+    // Команда --bench-markers
+    if (argc > 1 && std::string(argv[1]) == "--bench-markers") {
+        size_t pageKb = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 96;
+        int rounds = (argc > 3) ? std::atoi(argv[3]) : 5;
+        return BenchmarkMarkers(pageKb, rounds);
+    }
+    
+    // Команда --bench-marker-scan
+    if (argc > 1 && std::string(argv[1]) == "--bench-marker-scan") {
+        size_t pageKb = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 96;
+        int rounds = (argc > 3) ? std::atoi(argv[3]) : 5;
+        return BenchmarkMarkerScan(pageKb, rounds);
+    }
+    
+    // Команда --bench-allocs
+    if (argc > 1 && std::string(argv[1]) == "--bench-allocs") {
+        int checks = (argc > 2) ? std::atoi(argv[2]) : 20;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkAllocations(checks, configPath);
+    }
+    
+    // Команда --bench-probe
+    if (argc > 1 && std::string(argv[1]) == "--bench-probe") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 50;
+        int rounds = (argc > 3) ? std::atoi(argv[3]) : 32;
+        std::string configPath = (argc > 4) ? argv[4] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkProbe(channels, rounds, configPath);
+    }
+    
+    // Команда --bench-hedge
+    if (argc > 1 && std::string(argv[1]) == "--bench-hedge") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 20;
+        int checks = (argc > 3) ? std::atoi(argv[3]) : 60;
+        std::string configPath = (argc > 4) ? argv[4] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkHedge(channels, checks, configPath);
+    }
+    
+    // Команда --bench-scheduler
+    if (argc > 1 && std::string(argv[1]) == "--bench-scheduler") {
+        size_t channels = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 100000;
+        int seconds = (argc > 3) ? std::atoi(argv[3]) : 600;
+        return BenchmarkScheduler(channels, seconds);
+    }
+    
+    // Команда --bench-executor
+    if (argc > 1 && std::string(argv[1]) == "--bench-executor") {
+        size_t workers = (argc > 2) ? static_cast<size_t>(std::max(0, std::atoi(argv[2]))) : 0;
+        size_t tasks = (argc > 3) ? static_cast<size_t>(std::atol(argv[3])) : 20000;
+        return BenchmarkExecutor(workers, tasks);
+    }
+    
+    // Команда --bench-rate-limiter
+    if (argc > 1 && std::string(argv[1]) == "--bench-rate-limiter") {
+        int seconds = (argc > 2) ? std::atoi(argv[2]) : 5;
+        std::string configPath = (argc > 3) ? argv[3] : Constants::DEFAULT_CONFIG_FILE;
+        return BenchmarkRateLimiter(seconds, configPath);
+    }
+    
     // Команда --help
     if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
         PrintUsageInstructions();